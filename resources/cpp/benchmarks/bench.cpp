@@ -0,0 +1,42 @@
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include "../specs/allocations.h"
+#include "bench.h"
+
+namespace bench {
+  namespace {
+    volatile double sink = 0;
+  }
+
+  // Runs the block once to warm up, and then measures the given amount of iterations
+  void run(const std::string& description, unsigned iterations, unsigned operations,
+      std::function<void()> block) {
+    block();
+
+    unsigned long allocationsCount = spec::allocations::count();
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned i = 0; i < iterations; i++) block();
+
+    auto end = std::chrono::steady_clock::now();
+    allocationsCount = spec::allocations::count() - allocationsCount;
+
+    double totalOperations = (double) iterations * operations;
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::printf(
+      "%-52s %12.1f ns/op %10.2f allocs/op\n",
+      description.c_str(), ns / totalOperations, allocationsCount / totalOperations
+    );
+  }
+
+  void consume(double value) {
+    sink = sink + value;
+  }
+
+  double consumed() {
+    return sink;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+// A minimal benchmark runner for the native code. Each benchmark runs the given
+// block for a fixed amount of iterations, where each iteration performs the given
+// number of operations, and reports the time and heap allocations per operation
+namespace bench {
+  void run(const std::string& description, unsigned iterations, unsigned operations,
+    std::function<void()> block);
+
+  // Prevents the compiler from optimizing away the results of a benchmarked block
+  void consume(double value);
+
+  double consumed();
+}
\ No newline at end of file
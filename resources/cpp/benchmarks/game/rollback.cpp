@@ -0,0 +1,45 @@
+#include "../../src/game/match.h"
+#include "../../src/game/rollback.h"
+#include "../bench.h"
+
+// A snake in each quarter of the default match, played for a few seconds so all of
+// them are still in the game with trails of some length
+static void playQuarterSnakes(game::Rollback& rollback) {
+  game::Match& match = rollback._match;
+  match._world.addSnake(320, 180, 50, M_PI / 4, 100);
+  match._world.addSnake(960, 180, 50, (M_PI / 4) * 3, 100);
+  match._world.addSnake(960, 540, 50, (-M_PI / 4) * 3, 100);
+  match._world.addSnake(320, 540, 50, -M_PI / 4, 100);
+
+  game::RandomInput input(1, 4, 30, 90);
+  while (match._tick < 360) rollback.step(input(match._tick));
+}
+
+// The cost of a misprediction which is found out a whole window late: the match is
+// restored 8 ticks back and those ticks are simulated again, saving each of them
+void benchRollback() {
+  using namespace game;
+
+  const unsigned iterations = 2000;
+
+  Rollback rollback;
+  playQuarterSnakes(rollback);
+  MatchSnapshot snapshot;
+
+  bench::run("match save (4 snakes)", iterations, 1, [&] {
+    rollback._match.save(snapshot);
+  });
+
+  bench::run("match restore (4 snakes)", iterations, 1, [&] {
+    rollback._match.restore(snapshot);
+  });
+
+  unsigned corrections = 0;
+
+  bench::run("rollback of 8 ticks (4 snakes)", iterations, 1, [&] {
+    unsigned tick = rollback._match._tick - Rollback::WINDOW;
+    bench::consume(rollback.correct(tick, corrections++ % 2 ? 4 : 8, 12));
+  });
+
+  bench::consume(rollback._match._world._alive);
+}
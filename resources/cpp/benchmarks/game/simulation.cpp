@@ -0,0 +1,34 @@
+#include "../../src/game/match.h"
+#include "../../src/game/simulation.h"
+#include "../bench.h"
+
+// The default match for 10 seconds of fixed ticks, either stepped directly or ticked by
+// a simulation which logs the trails and publishes a state after each tick
+void benchSimulation() {
+  using namespace game;
+
+  const unsigned iterations = 20;
+  const unsigned ticksCount = 600;
+
+  bench::run("match step", iterations, ticksCount, [&] {
+    Match match;
+    match.addDefaultSnakes();
+    RandomInput input(1, 2, 30, 90);
+
+    for (unsigned tick = 0; tick < ticksCount; tick++) {
+      bench::consume(match.step(input(tick)).alive);
+    }
+  });
+
+  bench::run("simulation tick (published)", iterations, ticksCount, [&] {
+    Simulation simulation;
+    simulation.addDefaultSnakes();
+    RandomInput input(1, 2, 30, 90);
+
+    for (unsigned tick = 0; tick < ticksCount; tick++) {
+      simulation.pushInput(input(tick));
+      bench::consume(simulation.tick().alive);
+      bench::consume(simulation.acquireState()[0]);
+    }
+  });
+}
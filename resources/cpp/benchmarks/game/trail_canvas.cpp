@@ -0,0 +1,36 @@
+#include "../../src/graphics/framebuffer.h"
+#include "../../src/game/world.h"
+#include "../../src/game/match.h"
+#include "../../src/game/trail_canvas.h"
+#include "../bench.h"
+
+// The default match for 10 seconds of fixed ticks, where the trails are drawn after each
+// tick, either by painting what they've gained or by redrawing them as a whole the way
+// the canvas used to be drawn
+void benchTrailCanvas() {
+  using namespace game;
+
+  const unsigned iterations = 5;
+  const unsigned ticksCount = 600;
+
+  auto play = [&](bool redraw) {
+    Match match;
+    match.addDefaultSnakes();
+    TrailCanvas canvas(Match::WIDTH, Match::HEIGHT, { 0, 0, 0, 255 });
+    RandomInput input(1, 2, 30, 90);
+
+    for (unsigned tick = 0; tick < ticksCount; tick++) {
+      match.step(input(tick));
+      if (redraw) canvas.clear();
+      bench::consume(canvas.draw(match._world));
+    }
+  };
+
+  bench::run("trail canvas draw (whole trails)", iterations, ticksCount, [&] {
+    play(true);
+  });
+
+  bench::run("trail canvas draw (gained parts)", iterations, ticksCount, [&] {
+    play(false);
+  });
+}
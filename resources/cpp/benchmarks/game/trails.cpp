@@ -0,0 +1,156 @@
+#include <random>
+#include <vector>
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/trail_index.h"
+#include "../../src/geometry/arena.h"
+#include "../../src/game/snake.h"
+#include "../bench.h"
+
+// Records the trails of a scripted match, where snakes hold left, right or nothing for
+// random stretches of time the way players do, and are never disqualified. The last
+// bit of every step is recorded as well, so it can be scanned against the trails
+static void recordMatch(std::vector<game::Snake>& snakes, std::vector<geometry::Line>& lastLines,
+    std::vector<geometry::Circle>& lastCircles) {
+  const geometry::Arena arena(800, 600);
+  const unsigned stepsCount = 3000;
+  const double span = 16;
+
+  std::mt19937 random(1);
+  std::uniform_int_distribution<unsigned> stretch(5, 60);
+  std::uniform_int_distribution<unsigned> direction(0, 2);
+
+  snakes.push_back(game::Snake(200, 150, 30, 0, 100));
+  snakes.push_back(game::Snake(600, 150, 30, 0.5 * M_PI, 100));
+  snakes.push_back(game::Snake(200, 450, 30, M_PI, 100));
+  snakes.push_back(game::Snake(600, 450, 30, 1.5 * M_PI, 100));
+
+  std::vector<game::Direction> directions(snakes.size(), game::Direction::NONE);
+  std::vector<unsigned> stretches(snakes.size(), 0);
+
+  for (unsigned step = 0; step < stepsCount; step++) {
+    for (unsigned i = 0; i < snakes.size(); i++) {
+      if (!stretches[i]--) {
+        directions[i] = (game::Direction) direction(random);
+        stretches[i] = stretch(random);
+      }
+
+      game::Snake& snake = snakes[i];
+      snake.update(span, directions[i], arena);
+
+      if (snake._lastBitIsCircle)
+        lastCircles.push_back(snake._lastCircle);
+      else
+        lastLines.push_back(snake._lastLine);
+    }
+  }
+}
+
+void benchTrails() {
+  using namespace geometry;
+
+  std::vector<game::Snake> snakes;
+  std::vector<Line> lastLines;
+  std::vector<Circle> lastCircles;
+  recordMatch(snakes, lastLines, lastCircles);
+
+  const unsigned iterations = 3;
+  unsigned queriesCount = (lastLines.size() + lastCircles.size()) * snakes.size();
+
+  // Scans every shape of the trail one by one
+  auto scan = [](const TrailIndex& trail, const auto& shape) {
+    for (unsigned i = 0; i < trail.size(); i++) {
+      Intersection intersection = trail.isCircle(i) ?
+        shape.getIntersection(trail.getCircle(i)) :
+        shape.getIntersection(trail.getLine(i));
+
+      if (intersection.hasValue()) return true;
+    }
+
+    return false;
+  };
+
+  bench::run("Recorded trail scan (one by one)", iterations, queriesCount, [&] {
+    for (const game::Snake& snake : snakes) {
+      for (const Line& line : lastLines) bench::consume(scan(snake._trail, line));
+      for (const Circle& circle : lastCircles) bench::consume(scan(snake._trail, circle));
+    }
+  });
+
+  bench::run("Recorded trail scan (trail index)", iterations, queriesCount, [&] {
+    for (game::Snake& snake : snakes) {
+      for (const Line& line : lastLines) {
+        bench::consume(snake._trail.getIntersection(line).hasValue());
+      }
+      for (const Circle& circle : lastCircles) {
+        bench::consume(snake._trail.getIntersection(circle).hasValue());
+      }
+    }
+  });
+}
+
+// Bots looking around on top of the recorded trails, where each tick 64 bots cast 32
+// rays all around them. A tick is 16.7ms long, so keeping up at 60 Hz on a single core
+// takes less than 8000ns per ray
+void benchRays() {
+  using namespace geometry;
+
+  std::vector<game::Snake> snakes;
+  std::vector<Line> lastLines;
+  std::vector<Circle> lastCircles;
+  recordMatch(snakes, lastLines, lastCircles);
+
+  const unsigned iterations = 60;
+  const unsigned botsCount = 64;
+  const unsigned raysCount = 32;
+  const double maxDistance = 300;
+
+  std::mt19937 random(2);
+  std::uniform_real_distribution<double> x(0, 800);
+  std::uniform_real_distribution<double> y(0, 600);
+  std::vector<Point> origins;
+  for (unsigned i = 0; i < botsCount; i++) origins.push_back({ x(random), y(random) });
+
+  std::vector<Point> directions;
+  for (unsigned i = 0; i < raysCount; i++) {
+    double rad = (2 * M_PI * i) / raysCount;
+    directions.push_back({ std::cos(rad), std::sin(rad) });
+  }
+
+  std::vector<RayHit> hits(raysCount);
+
+  // Casts every ray against every shape one by one
+  bench::run("Bot rays (one by one)", iterations, botsCount * raysCount, [&] {
+    for (const Point& origin : origins) {
+      for (const Point& direction : directions) {
+        double nearest = maxDistance;
+
+        for (const game::Snake& snake : snakes) {
+          const TrailIndex& trail = snake._trail;
+
+          for (unsigned i = 0; i < trail.size(); i++) {
+            Nullable<double> distance = trail.isCircle(i) ?
+              trail.getCircle(i).getRayDistance(origin, direction) :
+              trail.getLine(i).getRayDistance(origin, direction);
+
+            if (distance.hasValue()) nearest = std::min(nearest, distance.getValue());
+          }
+        }
+
+        bench::consume(nearest);
+      }
+    }
+  });
+
+  bench::run("Bot rays (batched)", iterations, botsCount * raysCount, [&] {
+    for (const Point& origin : origins) {
+      for (RayHit& hit : hits) hit = { maxDistance, -1, -1 };
+
+      for (unsigned i = 0; i < snakes.size(); i++) {
+        snakes[i]._trail.castRays(origin, directions.data(), raysCount, hits.data(), i);
+      }
+
+      for (const RayHit& hit : hits) bench::consume(hit.distance);
+    }
+  });
+}
@@ -0,0 +1,102 @@
+#include <cmath>
+#include <functional>
+#include "../../src/game/snake.h"
+#include "../../src/game/world.h"
+#include "../../src/game/match.h"
+#include "../bench.h"
+
+// Places 16 snakes on a grid across a large arena, all heading the same way, so they
+// would last for a while before running into one another
+static void addSnakes(game::World& world) {
+  for (unsigned i = 0; i < 16; i++) {
+    world.addSnake(200 + (i % 4) * 400, 150 + (i / 4) * 300, 50, (i % 3) * 0.5 * M_PI, 100);
+  }
+}
+
+// The way the world used to be stepped, where each snake is tested against its own
+// trail and then against the whole trail of every opponent
+static game::StepStatus stepNested(game::World& world, double span, unsigned inputBits) {
+  using namespace game;
+
+  unsigned long long playing = world._alive;
+  unsigned long long eliminated = 0;
+
+  for (unsigned i = 0; i < world._snakes.size(); i++) {
+    if (!(playing & (1ull << i))) continue;
+
+    Snake& snake = world._snakes.at(i);
+    unsigned input = (inputBits >> (i * 2)) & 3;
+    Direction direction =
+      input & 1 ? Direction::LEFT :
+      input & 2 ? Direction::RIGHT :
+      Direction::NONE;
+
+    snake.update(span, direction, world._arena);
+
+    if (snake.hasSelfIntersection()) {
+      eliminated |= 1ull << i;
+      continue;
+    }
+
+    for (unsigned j = 0; j < world._snakes.size(); j++) {
+      if (j == i || !(playing & (1ull << j))) continue;
+
+      if (snake.hasSnakeIntersection(world._snakes.at(j))) {
+        eliminated |= 1ull << i;
+        break;
+      }
+    }
+  }
+
+  world._alive &= ~eliminated;
+
+  return { world._alive, eliminated, 0 };
+}
+
+// 16 snakes turning at random on a 1600x1200 arena, for 20 seconds of fixed ticks
+void benchWorld() {
+  using namespace game;
+
+  const unsigned iterations = 5;
+  const unsigned ticksCount = 1200;
+
+  auto play = [&](std::function<StepStatus(World&, unsigned)> step) {
+    World world(1600, 1200);
+    addSnakes(world);
+    RandomInput input(1, 16, 30, 90);
+
+    for (unsigned tick = 0; tick < ticksCount; tick++) {
+      bench::consume(step(world, input(tick)).alive);
+    }
+  };
+
+  bench::run("16 snakes world step (nested trail queries)", iterations, ticksCount, [&] {
+    play([](World& world, unsigned bits) { return stepNested(world, World::TICK, bits); });
+  });
+
+  bench::run("16 snakes world step (sweep and prune)", iterations, ticksCount, [&] {
+    play([](World& world, unsigned bits) { return world.step(World::TICK, bits); });
+  });
+
+  // A frame of 10 ticks at a time, as a page which is throttled in the background would
+  const unsigned framesCount = ticksCount / World::MAX_CATCH_UP;
+
+  auto advance = [&](unsigned ticksPerStep) {
+    World world(1600, 1200);
+    addSnakes(world);
+    world.setTicksPerStep(ticksPerStep);
+    RandomInput input(1, 16, 30, 90);
+
+    for (unsigned frame = 0; frame < framesCount; frame++) {
+      bench::consume(world.advance(World::TICK * World::MAX_CATCH_UP, input(frame)).alive);
+    }
+  };
+
+  bench::run("16 snakes world advance (fine ticks)", iterations, ticksCount, [&] {
+    advance(1);
+  });
+
+  bench::run("16 snakes world advance (long steps)", iterations, ticksCount, [&] {
+    advance(World::MAX_CATCH_UP);
+  });
+}
\ No newline at end of file
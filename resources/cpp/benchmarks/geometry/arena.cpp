@@ -0,0 +1,59 @@
+#include <random>
+#include <vector>
+#include "../../src/geometry/point.h"
+#include "../../src/geometry/intersection.h"
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/arena.h"
+#include "../bench.h"
+
+// Tests short bits of movement spread across the canvas against its bounds, the way
+// each snake does on every step. Building the bounds on every call is how it used to
+// be done, before the bounds were kept in an arena
+void benchArena() {
+  using namespace geometry;
+
+  const double width = 1280;
+  const double height = 720;
+
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> x(-1, width + 1);
+  std::uniform_real_distribution<double> y(-1, height + 1);
+  std::uniform_real_distribution<double> offset(-2, 2);
+  std::vector<Line> bits;
+
+  for (unsigned i = 0; i < 4096; i++) {
+    double x1 = x(random);
+    double y1 = y(random);
+    bits.push_back(Line(x1, y1, x1 + offset(random), y1 + offset(random)));
+  }
+
+  const unsigned iterations = 100;
+
+  bench::run("bounds per call", iterations, bits.size(), [&] {
+    for (const Line& bit : bits) {
+      Line bounds[] = {
+        Line(0, 0, width, 0),
+        Line(width, 0, width, height),
+        Line(width, height, 0, height),
+        Line(0, height, 0, 0)
+      };
+
+      for (const Line& bound : bounds) {
+        Intersection intersection = bit.getIntersection(bound);
+
+        if (intersection.hasValue()) {
+          bench::consume(intersection.at(0).x);
+          break;
+        }
+      }
+    }
+  });
+
+  Arena arena(width, height);
+
+  bench::run("Arena::getCrossing(Line)", iterations, bits.size(), [&] {
+    for (const Line& bit : bits) {
+      bench::consume(arena.getCrossing(bit, { bit._x2, bit._y2 }).edges);
+    }
+  });
+}
\ No newline at end of file
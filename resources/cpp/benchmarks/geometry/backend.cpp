@@ -0,0 +1,66 @@
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../src/geometry/backend.h"
+#include "../../src/geometry/shape_list.h"
+#include "../bench.h"
+
+// Constructs and intersects the same random trail-like shapes with the given backend,
+// so both backends run the exact same workload
+template <typename Backend>
+static void benchBackend(const std::string& name) {
+  typedef typename Backend::LineType LineType;
+  typedef typename Backend::CircleType CircleType;
+
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> position(0, 800);
+  std::uniform_real_distribution<double> offset(-20, 20);
+  std::uniform_real_distribution<double> rad(-2 * M_PI, 2 * M_PI);
+  std::uniform_real_distribution<double> sweep(-1, 1);
+  std::vector<double> values;
+
+  for (unsigned i = 0; i < 256; i++) {
+    double x = position(random);
+    double y = position(random);
+    double rad1 = rad(random);
+    values.insert(values.end(), { x, y, x + offset(random), y + offset(random), rad1, rad1 + sweep(random) });
+  }
+
+  std::vector<LineType> lines;
+  std::vector<CircleType> circles;
+  const unsigned iterations = 20;
+
+  bench::run(name + " construction", iterations, 256 * 2, [&] {
+    lines.clear();
+    circles.clear();
+
+    for (unsigned i = 0; i < values.size(); i += 6) {
+      lines.push_back(LineType(values[i], values[i + 1], values[i + 2], values[i + 3]));
+      circles.push_back(CircleType(values[i], values[i + 1], 20, values[i + 4], values[i + 5]));
+    }
+  });
+
+  bench::run(name + " line - line intersection", iterations, 256 * 256, [&] {
+    for (const LineType& a : lines) for (const LineType& b : lines) {
+      bench::consume(a.getIntersection(b).size());
+    }
+  });
+
+  bench::run(name + " circle - line intersection", iterations, 256 * 256, [&] {
+    for (const CircleType& a : circles) for (const LineType& b : lines) {
+      bench::consume(a.getIntersection(b).size());
+    }
+  });
+
+  bench::run(name + " circle - circle intersection", iterations, 256 * 256, [&] {
+    for (const CircleType& a : circles) for (const CircleType& b : circles) {
+      bench::consume(a.getIntersection(b).size());
+    }
+  });
+}
+
+void benchBackends() {
+  benchBackend<geometry::DoubleBackend>("Double backend");
+  benchBackend<geometry::FixedBackend>("Fixed backend");
+}
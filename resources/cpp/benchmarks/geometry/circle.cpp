@@ -0,0 +1,93 @@
+#include <cmath>
+#include <string>
+#include "../../src/nullable.h"
+#include "../../src/utils.h"
+#include "../../src/geometry/circle.h"
+#include "../bench.h"
+
+// The heap allocating chain which preceded the value based one, kept here so the
+// two can be compared
+namespace legacy {
+  template<typename T>
+  class Chain {
+  public:
+    T _accumulator;
+
+    Chain(T accumulator): _accumulator(accumulator) {
+    }
+
+    Chain<double>* trim(int decimals, const std::string mode = "round") {
+      double result = utils::trim(_accumulator, decimals, mode);
+      Chain<double>* chain = new Chain<double>(result);
+      delete this;
+      return chain;
+    }
+
+    Chain<bool>* isBetween(double num1, double num2, const std::string precision = "exact") {
+      bool result = utils::isBetween(_accumulator, num1, num2, precision);
+      Chain<bool>* chain = new Chain<bool>(result);
+      delete this;
+      return chain;
+    }
+
+    T result() {
+      T accumulator = _accumulator;
+      delete this;
+      return accumulator;
+    }
+  };
+
+  template<typename T>
+  Chain<T>* chain(T accumulator) {
+    return new Chain<T>(accumulator);
+  }
+
+  // Circle::getMatchingRad as it was implemented on top of the heap allocating chain
+  Nullable<double> getMatchingRad(const geometry::Circle& circle, double x, double y) {
+    double rad = std::atan2(y - circle._y, x - circle._x);
+
+    if (!std::isnan(rad) && utils::isBetween(rad, circle._rad1, circle._rad2, "exact")) {
+      return Nullable<double>(rad);
+    }
+
+    double greatestRad = std::abs(circle._rad1) > std::abs(circle._rad2) ?
+      circle._rad1 : circle._rad2;
+
+    if (chain(rad + (2 * M_PI * std::floor(greatestRad / (2 * M_PI))))
+        ->trim(9)->isBetween(circle._rad1, circle._rad2)->result() ||
+        chain(rad + (2 * M_PI * std::ceil(greatestRad / (2 * M_PI))))
+        ->trim(9)->isBetween(circle._rad1, circle._rad2)->result()) {
+      return Nullable<double>(rad);
+    }
+
+    return Nullable<double>();
+  }
+}
+
+void benchCircle() {
+  // An arc which wraps around 2 PIEs, so most points would go through the chained
+  // part of the legacy method
+  geometry::Circle circle(0, 0, 10, 1.5 * M_PI, 3 * M_PI);
+  const unsigned pointsCount = 1024;
+  const unsigned iterations = 2000;
+  double xs[pointsCount];
+  double ys[pointsCount];
+
+  for (unsigned i = 0; i < pointsCount; i++) {
+    double rad = (2 * M_PI * i) / pointsCount;
+    xs[i] = 10 * std::cos(rad);
+    ys[i] = 10 * std::sin(rad);
+  }
+
+  bench::run("Circle::getMatchingRad (heap chain)", iterations, pointsCount, [&] {
+    for (unsigned i = 0; i < pointsCount; i++) {
+      bench::consume(legacy::getMatchingRad(circle, xs[i], ys[i]).hasValue());
+    }
+  });
+
+  bench::run("Circle::getMatchingRad", iterations, pointsCount, [&] {
+    for (unsigned i = 0; i < pointsCount; i++) {
+      bench::consume(circle.getMatchingRad(xs[i], ys[i]).hasValue());
+    }
+  });
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../bench.h"
+
+// Intersects random pairs of short trail-like shapes spread across a canvas, so most
+// pairs never touch, much like the shapes of a snake's trail
+void benchIntersection() {
+  using namespace geometry;
+
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> position(0, 800);
+  std::uniform_real_distribution<double> offset(-20, 20);
+  std::uniform_real_distribution<double> rad(-2 * M_PI, 2 * M_PI);
+  std::uniform_real_distribution<double> sweep(-1, 1);
+  std::vector<Line> lines;
+  std::vector<Circle> circles;
+
+  for (unsigned i = 0; i < 256; i++) {
+    double x = position(random);
+    double y = position(random);
+    double rad1 = rad(random);
+    lines.push_back(Line(x, y, x + offset(random), y + offset(random)));
+    circles.push_back(Circle(x, y, 20, rad1, rad1 + sweep(random)));
+  }
+
+  const unsigned iterations = 20;
+  const unsigned pairsCount = 256 * 256;
+
+  bench::run("Line::getIntersection(Line)", iterations, pairsCount, [&] {
+    for (const Line& a : lines) for (const Line& b : lines) {
+      bench::consume(a.getIntersection(b).size());
+    }
+  });
+
+  bench::run("Circle::getIntersection(Line)", iterations, pairsCount, [&] {
+    for (const Circle& a : circles) for (const Line& b : lines) {
+      bench::consume(a.getIntersection(b).size());
+    }
+  });
+
+  bench::run("Circle::getIntersection(Circle)", iterations, pairsCount, [&] {
+    for (const Circle& a : circles) for (const Circle& b : circles) {
+      bench::consume(a.getIntersection(b).size());
+    }
+  });
+
+  // A turning snake leaves overlapping arcs of the same radius behind, so most of
+  // these pairs actually intersect and go through the arcs' containment tests
+  std::vector<Circle> arcs;
+
+  for (unsigned i = 0; i < 256; i++) {
+    double rad1 = (i * 0.7) - 40;
+    arcs.push_back(Circle(400 + (i % 16), 300 + (i / 16), 30, rad1, rad1 + 1.5));
+  }
+
+  bench::run("Circle::getIntersection(Circle), overlapping arcs", iterations, pairsCount, [&] {
+    for (const Circle& a : arcs) for (const Circle& b : arcs) {
+      bench::consume(a.getIntersection(b).size());
+    }
+  });
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include <random>
+#include <vector>
+#include "../../src/geometry/intersection.h"
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/polygon.h"
+#include "../bench.h"
+
+// Tests short bits of movement spread across the canvas against a map of obstacle edges,
+// the way each snake would on every step, by testing every edge and by descending the
+// polygon's hierarchy. The bare canvas bounds are tested for comparison
+void benchPolygon() {
+  using namespace geometry;
+
+  const double width = 1280;
+  const double height = 720;
+
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> x(0, width);
+  std::uniform_real_distribution<double> y(0, height);
+  std::uniform_real_distribution<double> offset(-40, 40);
+  std::uniform_real_distribution<double> step(-2, 2);
+  std::vector<Line> edges;
+  std::vector<Line> bits;
+
+  for (unsigned i = 0; i < 400; i++) {
+    double x1 = x(random);
+    double y1 = y(random);
+    edges.push_back(Line(x1, y1, x1 + offset(random), y1 + offset(random)));
+  }
+
+  for (unsigned i = 0; i < 4096; i++) {
+    double x1 = x(random);
+    double y1 = y(random);
+    bits.push_back(Line(x1, y1, x1 + step(random), y1 + step(random)));
+  }
+
+  const unsigned iterations = 20;
+
+  Polygon canvas({
+    Line(0, 0, width, 0),
+    Line(width, 0, width, height),
+    Line(width, height, 0, height),
+    Line(0, height, 0, 0)
+  });
+
+  bench::run("4 edges canvas", iterations, bits.size(), [&] {
+    for (const Line& bit : bits) bench::consume(canvas.intersects(bit));
+  });
+
+  bench::run("400 obstacle edges (every edge)", iterations, bits.size(), [&] {
+    for (const Line& bit : bits) {
+      for (const Line& edge : edges) {
+        if (bit.getIntersection(edge).hasValue()) {
+          bench::consume(1);
+          break;
+        }
+      }
+    }
+  });
+
+  Polygon obstacles(edges);
+
+  bench::run("400 obstacle edges (hierarchy)", iterations, bits.size(), [&] {
+    for (const Line& bit : bits) bench::consume(obstacles.intersects(bit));
+  });
+}
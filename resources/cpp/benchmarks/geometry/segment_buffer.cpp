@@ -0,0 +1,71 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/segment_buffer.h"
+#include "../bench.h"
+
+// Tests short last bits against a long trail of segments, once one segment at a time
+// and once using the vector kernels of the segment buffer
+void benchSegmentBuffer() {
+  using namespace geometry;
+
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> position(0, 800);
+  std::uniform_real_distribution<double> offset(-3, 3);
+  std::uniform_real_distribution<double> rad(-2 * M_PI, 2 * M_PI);
+  SegmentBuffer buffer;
+  std::vector<Line> lastLines;
+  std::vector<Circle> lastArcs;
+
+  for (unsigned i = 0; i < 1024; i++) {
+    double x = position(random);
+    double y = position(random);
+    buffer.append(Line(x, y, x + (10 * offset(random)), y + (10 * offset(random))));
+  }
+
+  for (unsigned i = 0; i < 64; i++) {
+    double x = position(random);
+    double y = position(random);
+    double rad1 = rad(random);
+    lastLines.push_back(Line(x, y, x + offset(random), y + offset(random)));
+    lastArcs.push_back(Circle(x, y, 20, rad1, rad1 + 0.1));
+  }
+
+  const unsigned iterations = 200;
+
+  bench::run("Line vs 1024 lines (one by one)", iterations, lastLines.size(), [&] {
+    for (const Line& line : lastLines) {
+      for (unsigned i = 0; i < buffer.size(); i++) {
+        if (line.getIntersection(buffer.getLine(i)).hasValue()) {
+          bench::consume(i);
+          break;
+        }
+      }
+    }
+  });
+
+  bench::run("Line vs 1024 lines (segment buffer)", iterations, lastLines.size(), [&] {
+    for (const Line& line : lastLines) {
+      bench::consume(buffer.getIntersection(line).hasValue());
+    }
+  });
+
+  bench::run("Arc vs 1024 lines (one by one)", iterations, lastArcs.size(), [&] {
+    for (const Circle& arc : lastArcs) {
+      for (unsigned i = 0; i < buffer.size(); i++) {
+        if (arc.getIntersection(buffer.getLine(i)).hasValue()) {
+          bench::consume(i);
+          break;
+        }
+      }
+    }
+  });
+
+  bench::run("Arc vs 1024 lines (segment buffer)", iterations, lastArcs.size(), [&] {
+    for (const Circle& arc : lastArcs) {
+      bench::consume(buffer.getIntersection(arc).hasValue());
+    }
+  });
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "../specs/allocations.cpp"
+#include "bench.cpp"
+#include "geometry/circle.cpp"
+#include "geometry/intersection.cpp"
+#include "geometry/backend.cpp"
+#include "geometry/segment_buffer.cpp"
+#include "geometry/arena.cpp"
+#include "geometry/polygon.cpp"
+#include "game/trails.cpp"
+#include "game/world.cpp"
+#include "game/trail_canvas.cpp"
+#include "game/rollback.cpp"
+#include "game/simulation.cpp"
+
+int main() {
+  benchCircle();
+  benchIntersection();
+  benchBackends();
+  benchSegmentBuffer();
+  benchArena();
+  benchPolygon();
+  benchTrails();
+  benchRays();
+  benchWorld();
+  benchTrailCanvas();
+  benchRollback();
+  benchSimulation();
+
+  return 0;
+}
\ No newline at end of file
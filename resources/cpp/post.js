@@ -6,9 +6,28 @@ return {
     compare: Module.utils_compare
   },
 
+  Stats: {
+    isEnabled: Module.stats_isEnabled,
+    snapshot: Module.stats_snapshot,
+    reset: Module.stats_reset,
+    startTrace: Module.stats_startTrace,
+    stopTrace: Module.stats_stopTrace,
+    getTrace: Module.stats_getTrace
+  },
+
   Geometry: {
     Line: Module.geometry_line,
-    Circle: Module.geometry_circle
+    Circle: Module.geometry_circle,
+    TrailIndex: Module.geometry_trail_index,
+    ShapeBatch: Module.geometry_shape_batch,
+    Polygon: Module.geometry_polygon
+  },
+
+  Game: {
+    World: Module.game_world,
+    RayBatch: Module.game_ray_batch,
+    TrailCanvas: Module.game_trail_canvas,
+    Simulation: Module.game_simulation
   }
 };
 
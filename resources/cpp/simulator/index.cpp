@@ -0,0 +1,206 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/stats.h"
+#include "../src/geometry/shape_pool.h"
+#include "../src/game/match.h"
+#include "work_stealing_pool.cpp"
+
+// Runs many independent headless matches across all cores and reports the result of
+// each match along with the overall throughput. Matches are played with random input
+// by default, where match i is seeded with seed + i, so any single match can be
+// reproduced later on by its seed
+namespace {
+  struct Options {
+    unsigned matches = 1000;
+    unsigned threads = std::thread::hardware_concurrency();
+    unsigned seed = 1;
+    unsigned ticks = 60 * 60 * 5;
+    bool quiet = false;
+    std::vector<unsigned> script;
+    const char* trace = nullptr;
+  };
+
+  void printUsage(const char* name) {
+    std::fprintf(stderr,
+      "usage: %s [--matches N] [--threads N] [--seed N] [--ticks N] [--script BITS,...]\n"
+      "          [--trace FILE] [--quiet]\n"
+      "  --matches  The number of matches to simulate (1000)\n"
+      "  --threads  The number of worker threads (all cores)\n"
+      "  --seed     The seed of the first match, each match increments it (1)\n"
+      "  --ticks    The maximal length of a match, in 60 fps ticks (18000)\n"
+      "  --script   Input bits for each tick instead of random input, the last are held\n"
+      "  --trace    Plays the first match once more and writes a Chrome trace of it,\n"
+      "             along with its counters, which requires a build with CORE_STATS\n"
+      "  --quiet    Print the summary alone, without a line for each match\n",
+      name
+    );
+  }
+
+  bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+      const char* arg = argv[i];
+
+      if (!std::strcmp(arg, "--quiet")) {
+        options.quiet = true;
+        continue;
+      }
+
+      if (i + 1 >= argc) return false;
+      const char* value = argv[++i];
+
+      if (!std::strcmp(arg, "--matches"))
+        options.matches = std::strtoul(value, nullptr, 10);
+      else if (!std::strcmp(arg, "--threads"))
+        options.threads = std::strtoul(value, nullptr, 10);
+      else if (!std::strcmp(arg, "--seed"))
+        options.seed = std::strtoul(value, nullptr, 10);
+      else if (!std::strcmp(arg, "--ticks"))
+        options.ticks = std::strtoul(value, nullptr, 10);
+      else if (!std::strcmp(arg, "--trace"))
+        options.trace = value;
+      else if (!std::strcmp(arg, "--script")) {
+        char* end = const_cast<char*>(value);
+
+        while (*end) {
+          options.script.push_back(std::strtoul(end, &end, 10));
+          if (*end == ',') end++;
+          else if (*end) return false;
+        }
+      }
+      else
+        return false;
+    }
+
+    if (!options.threads) options.threads = 1;
+
+    return true;
+  }
+
+  // Plays the first match on the calling thread while tracing, and writes the trace
+  // into the given file. Each tick makes a few events, so the trace is sized to fit
+  bool writeTrace(const Options& options) {
+    game::Match match;
+    match.addDefaultSnakes();
+
+    stats::reset();
+    stats::startTrace(options.ticks * 4);
+
+    if (options.script.empty())
+      match.run(game::RandomInput(options.seed, 2), options.ticks);
+    else
+      match.run(game::ScriptedInput(options.script), options.ticks);
+
+    stats::stopTrace();
+
+    std::FILE* file = std::fopen(options.trace, "w");
+    if (!file) return false;
+
+    std::string json = stats::getTraceJson();
+    std::fwrite(json.data(), 1, json.size(), file);
+    std::fclose(file);
+
+    stats::Snapshot snapshot = stats::getSnapshot();
+    std::printf("trace of match 0 written to %s\n", options.trace);
+
+    for (unsigned i = 0; i < stats::COUNTERS_COUNT; i++) {
+      std::printf("%s\t%llu\n", stats::getCounterName((stats::Counter) i), snapshot.counters[i]);
+    }
+
+    for (unsigned i = 0; i < stats::TIMERS_COUNT; i++) {
+      std::printf("%s\t%llu calls\t%.0f us\n", stats::getTimerName((stats::Timer) i),
+        snapshot.timerCalls[i], snapshot.timerTotals[i]);
+    }
+
+    return true;
+  }
+}
+
+int main(int argc, char** argv) {
+  Options options;
+
+  if (!parseOptions(argc, argv, options)) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  std::vector<game::MatchResult> results(options.matches);
+  simulator::WorkStealingPool pool(options.threads);
+
+  auto start = std::chrono::steady_clock::now();
+
+  // Each worker recycles a single match, so memory stops being allocated once the
+  // trails of the longest match so far fit in
+  std::vector<game::Match> matches(pool.size());
+
+  pool.run(options.matches, [&](unsigned index, unsigned worker) {
+    game::Match& match = matches[worker];
+    match.reset();
+    match.addDefaultSnakes();
+
+    if (options.script.empty())
+      results[index] = match.run(game::RandomInput(options.seed + index, 2), options.ticks);
+    else
+      results[index] = match.run(game::ScriptedInput(options.script), options.ticks);
+  });
+
+  auto end = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(end - start).count();
+
+  geometry::ShapePoolStats shapes = { 0, 0, 0, 0, 0 };
+
+  for (const game::Match& match : matches) {
+    geometry::ShapePoolStats matchShapes = match._world.getShapeStats();
+    shapes.allocations += matchShapes.allocations;
+    shapes.capacity += matchShapes.capacity;
+    shapes.growths += matchShapes.growths;
+  }
+
+  unsigned long ticks = 0;
+  unsigned wins[2] = { 0, 0 };
+  unsigned ties = 0;
+  unsigned unfinished = 0;
+
+  if (!options.quiet) std::printf("match\tseed\twinner\tticks\n");
+
+  for (unsigned i = 0; i < results.size(); i++) {
+    const game::MatchResult& result = results[i];
+    ticks += result.ticks;
+
+    if (!result.finished) unfinished++;
+    else if (result.winner < 0) ties++;
+    else wins[result.winner]++;
+
+    if (options.quiet) continue;
+
+    std::printf("%u\t%u\t%s\t%u\n", i, options.seed + i,
+      !result.finished ? "none" : result.winner < 0 ? "tie" : result.winner ? "blue" : "red",
+      result.ticks);
+  }
+
+  std::printf(
+    "%u matches on %u threads in %.3f s (%lu steals)\n"
+    "red %u, blue %u, ties %u, unfinished %u\n"
+    "%.1f matches/s, %.0f ticks/s\n"
+    "%lu shapes allocated, %u shape slots, %u storage growths\n",
+    options.matches, pool.size(), seconds, pool.getStealsCount(),
+    wins[0], wins[1], ties, unfinished,
+    options.matches / seconds, ticks / seconds,
+    shapes.allocations, shapes.capacity, shapes.growths
+  );
+
+  if (options.trace) {
+    if (!stats::isEnabled()) std::fprintf(stderr, "warning: built without CORE_STATS, the trace is empty\n");
+
+    if (!writeTrace(options)) {
+      std::fprintf(stderr, "could not write %s\n", options.trace);
+      return 1;
+    }
+  }
+
+  return 0;
+}
\ No newline at end of file
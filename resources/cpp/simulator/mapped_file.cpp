@@ -0,0 +1,48 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include "mapped_file.h"
+
+namespace simulator {
+  MappedFile::MappedFile(const std::string& path): _data(nullptr), _size(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("MappedFile: can't open " + path);
+
+    struct stat info;
+
+    if (fstat(fd, &info) < 0) {
+      close(fd);
+      throw std::runtime_error("MappedFile: can't stat " + path);
+    }
+
+    _size = info.st_size;
+
+    // Empty files can't be mapped, and there's nothing to read in them anyways
+    if (_size) {
+      _data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if (_data == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("MappedFile: can't map " + path);
+      }
+    }
+
+    close(fd);
+  }
+
+  MappedFile::~MappedFile() {
+    if (_data) munmap(_data, _size);
+  }
+
+  const unsigned char* MappedFile::data() const {
+    return static_cast<const unsigned char*>(_data);
+  }
+
+  std::size_t MappedFile::size() const {
+    return _size;
+  }
+}
\ No newline at end of file
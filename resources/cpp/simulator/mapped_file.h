@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace simulator {
+  // A read-only memory mapping of a whole file, so replays can be read in place without
+  // being loaded first. Failures throw a runtime_error
+  class MappedFile {
+  public:
+    MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const;
+
+    std::size_t size() const;
+
+  private:
+    void* _data;
+    std::size_t _size;
+  };
+}
\ No newline at end of file
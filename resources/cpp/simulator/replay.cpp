@@ -0,0 +1,178 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../src/game/match.h"
+#include "../src/game/replay.h"
+#include "mapped_file.cpp"
+
+// Records headless matches into replay files and plays them back, straight out of a
+// memory mapping and as fast as the CPU allows
+namespace {
+  struct Options {
+    std::string command;
+    std::string path;
+    unsigned seed = 1;
+    unsigned ticks = 60 * 60 * 5;
+    unsigned interval = game::ReplayWriter::KEYFRAME_INTERVAL;
+    unsigned seek = 0;
+    bool verify = false;
+    std::vector<unsigned> script;
+  };
+
+  void printUsage(const char* name) {
+    std::fprintf(stderr,
+      "usage: %s record FILE [--seed N] [--ticks N] [--interval N] [--script BITS,...]\n"
+      "       %s play FILE [--seek N] [--verify]\n"
+      "  --seed      The seed of the recorded match's random input (1)\n"
+      "  --ticks     The maximal length of the recorded match, in 60 fps ticks (18000)\n"
+      "  --interval  The number of ticks between keyframes (600)\n"
+      "  --script    Input bits for each tick instead of random input, the last are held\n"
+      "  --seek      The tick to start playing from\n"
+      "  --verify    Check that seeking to each keyframe matches playing up to it\n",
+      name, name
+    );
+  }
+
+  bool parseOptions(int argc, char** argv, Options& options) {
+    if (argc < 3) return false;
+
+    options.command = argv[1];
+    options.path = argv[2];
+
+    if (options.command != "record" && options.command != "play") return false;
+
+    for (int i = 3; i < argc; i++) {
+      const char* arg = argv[i];
+
+      if (!std::strcmp(arg, "--verify")) {
+        options.verify = true;
+        continue;
+      }
+
+      if (i + 1 >= argc) return false;
+      const char* value = argv[++i];
+
+      if (!std::strcmp(arg, "--seed"))
+        options.seed = std::strtoul(value, nullptr, 10);
+      else if (!std::strcmp(arg, "--ticks"))
+        options.ticks = std::strtoul(value, nullptr, 10);
+      else if (!std::strcmp(arg, "--interval"))
+        options.interval = std::strtoul(value, nullptr, 10);
+      else if (!std::strcmp(arg, "--seek"))
+        options.seek = std::strtoul(value, nullptr, 10);
+      else if (!std::strcmp(arg, "--script")) {
+        char* end = const_cast<char*>(value);
+
+        while (*end) {
+          options.script.push_back(std::strtoul(end, &end, 10));
+          if (*end == ',') end++;
+          else if (*end) return false;
+        }
+      }
+      else
+        return false;
+    }
+
+    return true;
+  }
+
+  const char* getWinnerName(const game::MatchResult& result) {
+    if (!result.finished) return "none";
+    if (result.winner < 0) return "tie";
+    return result.winner ? "blue" : "red";
+  }
+
+  int record(const Options& options) {
+    game::Match match;
+    match.addDefaultSnakes();
+
+    game::ReplayWriter writer(match, options.interval);
+    game::MatchInput input = options.script.empty() ?
+      game::MatchInput(game::RandomInput(options.seed, 2)) :
+      game::MatchInput(game::ScriptedInput(options.script));
+
+    // Recorded once each tick is made, so keyframes hold its outcome
+    while (!match.isFinished() && match._tick < options.ticks) {
+      unsigned inputBits = input(match._tick);
+      match.step(inputBits);
+      writer.record(match, inputBits);
+    }
+
+    game::MatchResult result = match.getResult();
+    std::vector<unsigned char> bytes = writer.finish();
+    std::ofstream file(options.path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+
+    if (!file) {
+      std::fprintf(stderr, "can't write %s\n", options.path.c_str());
+      return 1;
+    }
+
+    std::printf("winner %s after %u ticks, %zu bytes\n", getWinnerName(result), result.ticks,
+      bytes.size());
+
+    return 0;
+  }
+
+  int play(const Options& options) {
+    simulator::MappedFile file(options.path);
+    game::ReplayReader reader(file.data(), file.size());
+
+    if (options.verify) {
+      game::Match match = reader.start();
+
+      for (unsigned i = 0; i < reader.getKeyframesCount(); i++) {
+        unsigned tick = reader.getKeyframeTick(i);
+        while (match._tick < tick) match.step(reader.nextInput());
+
+        game::ReplayReader seeker(file.data(), file.size());
+
+        if (game::getStateBytes(seeker.seek(tick)) != game::getStateBytes(match)) {
+          std::printf("keyframe %u at tick %u doesn't match\n", i, tick);
+          return 1;
+        }
+      }
+
+      std::printf("%u keyframes verified\n", reader.getKeyframesCount());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    game::Match match = reader.seek(options.seek);
+    unsigned from = match._tick;
+    game::MatchResult result = reader.play(match);
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::printf(
+      "winner %s after %u ticks, played %u ticks from tick %u in %.3f s, %.0f ticks/s\n",
+      getWinnerName(result), result.ticks, result.ticks - from, from, seconds,
+      (result.ticks - from) / seconds
+    );
+
+    return 0;
+  }
+}
+
+int main(int argc, char** argv) {
+  Options options;
+
+  if (!parseOptions(argc, argv, options)) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  try {
+    return options.command == "record" ? record(options) : play(options);
+  }
+  catch (const std::exception& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+}
\ No newline at end of file
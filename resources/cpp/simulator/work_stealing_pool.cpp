@@ -0,0 +1,139 @@
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "work_stealing_pool.h"
+
+namespace simulator {
+  // threadsCount - The number of workers, at least 1
+  WorkStealingPool::WorkStealingPool(unsigned threadsCount):
+    _task(nullptr),
+    _generation(0),
+    _stopping(false),
+    _remaining(0),
+    _steals(0) {
+    if (threadsCount < 1) threadsCount = 1;
+
+    for (unsigned i = 0; i < threadsCount; i++) {
+      _queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+
+    for (unsigned i = 0; i < threadsCount; i++) {
+      _threads.push_back(std::thread(&WorkStealingPool::work, this, i));
+    }
+  }
+
+  WorkStealingPool::~WorkStealingPool() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stopping = true;
+    }
+
+    _started.notify_all();
+
+    for (std::thread& thread : _threads) thread.join();
+  }
+
+  unsigned WorkStealingPool::size() const {
+    return _threads.size();
+  }
+
+  // The number of tasks which were taken from another worker's queue, since the pool
+  // was created
+  unsigned long WorkStealingPool::getStealsCount() const {
+    return _steals;
+  }
+
+  // Runs the task for every index from 0 up to the given count, and blocks until all
+  // of them are done. Runs can't be made concurrently
+  void WorkStealingPool::run(unsigned tasksCount, const PoolTask& task) {
+    if (!tasksCount) return;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _task = &task;
+    _remaining = tasksCount;
+
+    unsigned queuesCount = _queues.size();
+
+    for (unsigned i = 0; i < queuesCount; i++) {
+      Queue& queue = *_queues.at(i);
+      std::lock_guard<std::mutex> queueLock(queue.mutex);
+
+      // Contiguous blocks, so neighbouring tasks are likely to run on the same worker
+      unsigned from = (unsigned long) tasksCount * i / queuesCount;
+      unsigned to = (unsigned long) tasksCount * (i + 1) / queuesCount;
+
+      // Workers take from the back, so the block is reversed to keep it in order
+      for (unsigned index = to; index > from; index--) {
+        queue.tasks.push_back(index - 1);
+      }
+    }
+
+    _generation++;
+    _started.notify_all();
+    _finished.wait(lock, [this] { return _remaining == 0; });
+    _task = nullptr;
+  }
+
+  void WorkStealingPool::work(unsigned worker) {
+    unsigned generation = 0;
+
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _started.wait(lock, [&] { return _stopping || _generation != generation; });
+
+        if (_stopping) return;
+        generation = _generation;
+      }
+
+      unsigned index;
+
+      while (take(worker, index)) {
+        (*_task)(index, worker);
+
+        // The last task to finish wakes up the thread which has started the run
+        if (--_remaining == 0) {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _finished.notify_all();
+        }
+      }
+    }
+  }
+
+  // Takes the next task out of the worker's own queue, or steals one from the other
+  // queues, starting with the worker's neighbour. Returns false once all are empty
+  bool WorkStealingPool::take(unsigned worker, unsigned& index) {
+    {
+      Queue& queue = *_queues.at(worker);
+      std::lock_guard<std::mutex> lock(queue.mutex);
+
+      if (!queue.tasks.empty()) {
+        index = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+      }
+    }
+
+    unsigned queuesCount = _queues.size();
+
+    for (unsigned i = 1; i < queuesCount; i++) {
+      Queue& queue = *_queues.at((worker + i) % queuesCount);
+      std::lock_guard<std::mutex> lock(queue.mutex);
+
+      if (!queue.tasks.empty()) {
+        index = queue.tasks.front();
+        queue.tasks.pop_front();
+        _steals++;
+        return true;
+      }
+    }
+
+    return false;
+  }
+}
\ No newline at end of file
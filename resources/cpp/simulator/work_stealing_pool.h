@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace simulator {
+  // Runs the task for the given index, on the worker with the given index
+  typedef std::function<void(unsigned index, unsigned worker)> PoolTask;
+
+  // A fixed set of worker threads, each with a queue of its own. Tasks are dealt
+  // to the queues in contiguous blocks up front; a worker takes tasks from the back
+  // of its own queue, and once it's empty it steals from the front of the others', so
+  // tasks of uneven length (e.g. matches) keep all the workers busy until the end
+  class WorkStealingPool {
+  public:
+    WorkStealingPool(unsigned threadsCount);
+
+    ~WorkStealingPool();
+
+    unsigned size() const;
+
+    unsigned long getStealsCount() const;
+
+    void run(unsigned tasksCount, const PoolTask& task);
+
+  private:
+    struct Queue {
+      std::mutex mutex;
+      std::deque<unsigned> tasks;
+    };
+
+    std::vector<std::thread> _threads;
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::mutex _mutex;
+    std::condition_variable _started;
+    std::condition_variable _finished;
+    const PoolTask* _task;
+    unsigned _generation;
+    bool _stopping;
+    std::atomic<unsigned> _remaining;
+    std::atomic<unsigned long> _steals;
+
+    void work(unsigned worker);
+
+    bool take(unsigned worker, unsigned& index);
+  };
+}
\ No newline at end of file
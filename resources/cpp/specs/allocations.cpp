@@ -0,0 +1,33 @@
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include "../src/stats.h"
+#include "allocations.h"
+
+namespace spec {
+  namespace allocations {
+    unsigned long allocationsCount = 0;
+
+    unsigned long count() {
+      return allocationsCount;
+    }
+  }
+}
+
+void* operator new(std::size_t size) {
+  spec::allocations::allocationsCount++;
+  STATS_COUNT(ALLOCATIONS);
+  void* pointer = std::malloc(size ? size : 1);
+  if (!pointer) throw std::bad_alloc();
+  return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+// Sized deallocations are routed to the replaced delete, so memory is always released
+// the same way it was allocated
+void operator delete(void* pointer, std::size_t) noexcept {
+  operator delete(pointer);
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+// Counts the heap allocations made through the global allocation operators, so
+// specs can tell whether a code path allocates or not
+namespace spec {
+  namespace allocations {
+    unsigned long count();
+  }
+}
\ No newline at end of file
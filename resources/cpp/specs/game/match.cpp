@@ -0,0 +1,83 @@
+#include <stdexcept>
+#include <vector>
+#include "../../src/game/match.h"
+#include "../spec.h"
+
+void describeMatch() {
+  using namespace game;
+
+  spec::describe("game::Match", [] {
+    spec::it("ends once a single snake is left standing", [] {
+      Match match;
+      match.addDefaultSnakes();
+      MatchResult result = match.run(RandomInput(1, 2), 60 * 60);
+
+      spec::expect(result.finished, "expected match to be finished");
+      spec::expect(result.winner >= 0, "expected match to have a winner");
+      spec::expect(result.alive == 1u << result.winner, "expected winner alone to be alive");
+      spec::expect(result.ticks == match._tick, "expected ticks to match");
+    });
+
+    spec::it("is determined by its input", [] {
+      Match matchA;
+      Match matchB;
+      matchA.addDefaultSnakes();
+      matchB.addDefaultSnakes();
+      MatchResult resultA = matchA.run(RandomInput(7, 2), 60 * 60);
+      MatchResult resultB = matchB.run(RandomInput(7, 2), 60 * 60);
+
+      spec::expect(resultA.winner == resultB.winner, "expected winners to match");
+      spec::expect(resultA.ticks == resultB.ticks, "expected ticks to match");
+    });
+
+    spec::it("stops once it runs out of ticks", [] {
+      Match match;
+      match.addDefaultSnakes();
+      MatchResult result = match.run(ScriptedInput({ 0 }), 10);
+
+      spec::expect(!result.finished, "expected match not to be finished");
+      spec::expect(result.winner == -1, "expected no winner");
+      spec::expect(result.alive == 3, "expected both snakes to be alive");
+      spec::expect(result.ticks == 10, "expected 10 ticks");
+    });
+  });
+
+  spec::describe("game::RandomInput", [] {
+    spec::it("draws the same input for a tick no matter which ticks were skipped", [] {
+      RandomInput every(5, 2, 1, 3);
+      RandomInput skipping(5, 2, 1, 3);
+      std::vector<unsigned> inputs;
+
+      for (unsigned tick = 0; tick <= 40; tick++) inputs.push_back(every(tick));
+
+      spec::expect(skipping(10) == inputs[10], "expected the input of the tick");
+      spec::expect(skipping(10) == inputs[10], "expected the last tick to be drawn again");
+      spec::expect(skipping(40) == inputs[40], "expected the input of a later tick");
+    });
+
+    spec::it("refuses ticks which were already passed", [] {
+      RandomInput input(5, 2);
+      bool thrown = false;
+      input(10);
+
+      try {
+        input(5);
+      }
+      catch (const std::invalid_argument&) {
+        thrown = true;
+      }
+
+      spec::expect(thrown, "expected an invalid_argument");
+    });
+  });
+
+  spec::describe("game::ScriptedInput", [] {
+    spec::it("holds the last input bits once the script is exhausted", [] {
+      ScriptedInput input({ 1, 2, 9 });
+
+      spec::expect(input(0) == 1, "expected first input bits");
+      spec::expect(input(2) == 9, "expected last input bits");
+      spec::expect(input(100) == 9, "expected last input bits to be held");
+    });
+  });
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include <stdexcept>
+#include <vector>
+#include "../../src/game/match.h"
+#include "../../src/game/replay.h"
+#include "../spec.h"
+
+// Records a match with random input, with a keyframe every 50 ticks. Matches of 4
+// snakes start with a snake in each quarter, heading towards the middle
+static std::vector<unsigned char> recordMatch(unsigned seed, game::MatchResult& result,
+    unsigned snakesCount = 2) {
+  game::Match match;
+
+  if (snakesCount == 4) {
+    match._world.addSnake(320, 180, 50, M_PI / 4, 100);
+    match._world.addSnake(960, 180, 50, (M_PI / 4) * 3, 100);
+    match._world.addSnake(960, 540, 50, (-M_PI / 4) * 3, 100);
+    match._world.addSnake(320, 540, 50, -M_PI / 4, 100);
+  }
+  else {
+    match.addDefaultSnakes();
+  }
+
+  game::ReplayWriter writer(match, 50);
+  game::RandomInput input(seed, snakesCount);
+
+  while (!match.isFinished() && match._tick < 60 * 60) {
+    unsigned inputBits = input(match._tick);
+    match.step(inputBits);
+    writer.record(match, inputBits);
+  }
+
+  result = match.getResult();
+  return writer.finish();
+}
+
+void describeReplay() {
+  using namespace game;
+
+  spec::describe("game::ReplayReader", [] {
+    spec::it("plays back the recorded match", [] {
+      MatchResult recorded;
+      std::vector<unsigned char> bytes = recordMatch(3, recorded);
+      ReplayReader reader(bytes.data(), bytes.size());
+
+      Match match = reader.start();
+      MatchResult result = reader.play(match);
+
+      spec::expect(reader.getTicks() == recorded.ticks, "expected ticks to match");
+      spec::expect(result.ticks == recorded.ticks, "expected played ticks to match");
+      spec::expect(result.winner == recorded.winner, "expected winners to match");
+    });
+
+    spec::it("seeks into the exact state of playing up to the same tick", [] {
+      MatchResult recorded;
+      std::vector<unsigned char> bytes = recordMatch(3, recorded);
+      ReplayReader reader(bytes.data(), bytes.size());
+      ReplayReader seeker(bytes.data(), bytes.size());
+
+      spec::expect(reader.getKeyframesCount() > 1, "expected multiple keyframes");
+
+      Match match = reader.start();
+      bool same = true;
+
+      for (unsigned tick = 1; tick < reader.getTicks(); tick += 37) {
+        while (match._tick < tick) match.step(reader.nextInput());
+        same = same && getStateBytes(seeker.seek(tick)) == getStateBytes(match);
+      }
+
+      spec::expect(same, "expected states to match");
+    });
+
+    spec::it("seeks past disqualified snakes into the same state as playing", [] {
+      unsigned checked = 0;
+      bool same = true;
+
+      for (unsigned seed = 1; seed <= 10; seed++) {
+        MatchResult recorded;
+        std::vector<unsigned char> bytes = recordMatch(seed, recorded, 4);
+        ReplayReader seeker(bytes.data(), bytes.size());
+
+        for (unsigned tick = 50; tick < seeker.getTicks(); tick += 50) {
+          ReplayReader reader(bytes.data(), bytes.size());
+          Match played = reader.start();
+
+          while (played._tick < tick) played.step(reader.nextInput());
+          if (played._world._alive == 15) continue;
+
+          // Seeking lands right on a keyframe, then both matches are played to the end
+          Match sought = seeker.seek(tick);
+          same = same &&
+            sought._world._broadPhase.getShapesCount() == played._world._broadPhase.getShapesCount();
+
+          while (!played.isFinished()) {
+            unsigned inputBits = reader.nextInput();
+            same = same && sought.step(inputBits).alive == played.step(inputBits).alive;
+          }
+
+          same = same && getStateBytes(sought) == getStateBytes(played);
+          checked++;
+        }
+      }
+
+      spec::expect(checked > 0, "expected seeks past disqualified snakes");
+      spec::expect(same, "expected states to match");
+    });
+
+    spec::it("rejects data which isn't a replay", [] {
+      MatchResult recorded;
+      std::vector<unsigned char> bytes = recordMatch(3, recorded);
+      bool thrown = false;
+
+      try {
+        ReplayReader reader(bytes.data(), bytes.size() / 2);
+      }
+      catch (const std::invalid_argument&) {
+        thrown = true;
+      }
+
+      spec::expect(thrown, "expected truncated replay to be rejected");
+    });
+  });
+
+  spec::describe("game::ReplayWriter", [] {
+    spec::it("rejects matches of more snakes than the input bits cover", [] {
+      Match match;
+      bool thrown = false;
+
+      for (unsigned i = 0; i <= World::MAX_PACKED_SNAKES; i++) {
+        match._world.addSnake(40 + (i % 8) * 150, 40 + (i / 8) * 200, 20, 0, 100);
+      }
+
+      try {
+        ReplayWriter writer(match, 50);
+      }
+      catch (const std::invalid_argument&) {
+        thrown = true;
+      }
+
+      spec::expect(thrown, "expected the match to be refused");
+    });
+  });
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include <stdexcept>
+#include <vector>
+#include "../../src/game/match.h"
+#include "../../src/game/replay.h"
+#include "../../src/game/rollback.h"
+#include "../spec.h"
+
+// Adds a snake in each quarter of the match, heading towards the middle
+static void addQuarterSnakes(game::Match& match) {
+  match._world.addSnake(320, 180, 50, M_PI / 4, 100);
+  match._world.addSnake(960, 180, 50, (M_PI / 4) * 3, 100);
+  match._world.addSnake(960, 540, 50, (-M_PI / 4) * 3, 100);
+  match._world.addSnake(320, 540, 50, -M_PI / 4, 100);
+}
+
+void describeRollback() {
+  using namespace game;
+
+  spec::describe("game::Match", [] {
+    spec::it("is restored to the exact state it was saved in", [] {
+      Match match;
+      addQuarterSnakes(match);
+      RandomInput input(2, 4, 5, 20);
+      MatchSnapshot snapshot;
+
+      while (match._tick < 300) match.step(input(match._tick));
+
+      match.save(snapshot);
+      std::vector<unsigned char> saved = getStateBytes(match);
+
+      while (match._tick < 320) match.step(input(match._tick));
+
+      match.restore(snapshot);
+
+      spec::expect(getStateBytes(match) == saved, "expected the saved state");
+    });
+  });
+
+  spec::describe("game::Rollback", [] {
+    spec::it("ends up where the actual input leads once all of it has arrived", [] {
+      const unsigned ticksCount = 1200;
+      const unsigned delay = 5;
+      const unsigned remoteMask = ~3u;
+      std::vector<unsigned> inputs;
+      RandomInput input(4, 4, 5, 30);
+      Match actual;
+      Rollback rollback;
+      addQuarterSnakes(actual);
+      addQuarterSnakes(rollback._match);
+
+      for (unsigned tick = 0; tick < ticksCount + delay; tick++) inputs.push_back(input(tick));
+
+      unsigned resimulated = 0;
+
+      // The first snake is played locally, and the input of the others arrives a few
+      // ticks late. Until it does, their last known input is predicted to be held
+      for (unsigned tick = 0; tick < ticksCount + delay; tick++) {
+        if (tick < ticksCount) {
+          unsigned known = tick >= delay ? inputs[tick - delay] : 0;
+          rollback.step((inputs[tick] & ~remoteMask) | (known & remoteMask));
+          actual.step(inputs[tick]);
+        }
+
+        if (tick >= delay) resimulated += rollback.correct(tick - delay, inputs[tick - delay], remoteMask);
+      }
+
+      spec::expect(resimulated > 0, "expected some input to be mispredicted");
+      spec::expect(actual.getResult().alive != 15, "expected some snakes to be disqualified");
+      spec::expect(getStateBytes(rollback._match) == getStateBytes(actual), "expected the actual state");
+    });
+
+    spec::it("leaves the match as is when the prediction was right", [] {
+      Rollback rollback;
+      addQuarterSnakes(rollback._match);
+
+      for (unsigned tick = 0; tick < 20; tick++) rollback.step(tick < 15 ? 4 : 8);
+
+      spec::expect(rollback.correct(17, 8, 12) == 0, "expected no ticks to be simulated again");
+      spec::expect(rollback.correct(15, 8, 12) == 0, "expected no ticks to be simulated again");
+      spec::expect(rollback.correct(14, 8, 12) == 6, "expected the ticks since the correction");
+    });
+
+    spec::it("only corrects ticks within its window", [] {
+      Rollback rollback(8);
+      addQuarterSnakes(rollback._match);
+
+      for (unsigned tick = 0; tick < 20; tick++) rollback.step(0);
+
+      bool thrown = false;
+
+      try {
+        rollback.correct(11, 4, 12);
+      }
+      catch (const std::out_of_range&) {
+        thrown = true;
+      }
+
+      spec::expect(rollback.getOldestTick() == 12, "expected the oldest tick in the window");
+      spec::expect(thrown, "expected too old a tick to be refused");
+      spec::expect(rollback._match._tick == 20, "expected the match to be left as is");
+      spec::expect(rollback.correct(20, 4, 12) == 0, "expected a future tick to be left as is");
+      spec::expect(rollback.correct(12, 4, 12) == 8, "expected the whole window to be simulated again");
+      spec::expect(rollback._match._tick == 20, "expected the match to be back at its tick");
+    });
+
+    spec::it("rejects matches of more snakes than the input bits cover", [] {
+      Rollback rollback;
+      bool thrown = false;
+
+      for (unsigned i = 0; i <= World::MAX_PACKED_SNAKES; i++) {
+        rollback._match._world.addSnake(40 + (i % 8) * 150, 40 + (i / 8) * 200, 20, 0, 100);
+      }
+
+      try {
+        rollback.step(0);
+      }
+      catch (const std::invalid_argument&) {
+        thrown = true;
+      }
+
+      spec::expect(thrown, "expected the match to be refused");
+      spec::expect(rollback._match._tick == 0, "expected the match not to be stepped");
+    });
+  });
+}
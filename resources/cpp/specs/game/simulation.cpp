@@ -0,0 +1,287 @@
+#include <thread>
+#include <vector>
+#include "../../src/geometry/trail_index.h"
+#include "../../src/geometry/shape_batch.h"
+#include "../../src/game/match.h"
+#include "../../src/game/input_queue.h"
+#include "../../src/game/state_buffer.h"
+#include "../../src/game/trail_log.h"
+#include "../../src/game/simulation.h"
+#include "../spec.h"
+
+// Browser builds without pthreads can't start threads, so the specs which need a second
+// thread are only made where they can run, e.g. natively or under Node with pthreads
+static bool hasThreads() {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+  return false;
+#else
+  return true;
+#endif
+}
+
+// Whether the given trail is made out of the logged segments of a published state,
+// followed by its tail segments
+static bool isPublished(game::Simulation& simulation, const double* state, unsigned index,
+    const geometry::TrailIndex& trail) {
+  const unsigned stride = geometry::ShapeBatch::SHAPE_STRIDE;
+  const double* record = state + game::Simulation::HEADER_SIZE + index * game::Simulation::SNAKE_STRIDE;
+  unsigned logged = record[4];
+
+  if (record[5] != trail.size()) return false;
+
+  for (unsigned id = 0; id < trail.size(); id++) {
+    double descriptor[stride];
+    game::TrailLog::writeSegment(trail, id, descriptor);
+
+    const double* published = id < logged ?
+      simulation.getSegment(index, id) :
+      record + 6 + (id - logged) * stride;
+
+    for (unsigned i = 0; i < stride; i++) {
+      if (published[i] != descriptor[i]) return false;
+    }
+  }
+
+  return true;
+}
+
+void describeSimulation() {
+  using namespace game;
+
+  spec::describe("game::InputQueue", [] {
+    spec::it("pops input bits in the order they were pushed", [] {
+      InputQueue queue(4);
+      unsigned inputBits = 0;
+      queue.push(1);
+      queue.push(2);
+
+      spec::expect(queue.pop(inputBits) && inputBits == 1, "expected first input bits");
+      spec::expect(queue.pop(inputBits) && inputBits == 2, "expected second input bits");
+      spec::expect(!queue.pop(inputBits), "expected queue to be empty");
+    });
+
+    spec::it("refuses input bits once full", [] {
+      InputQueue queue(3);
+      unsigned inputBits = 0;
+
+      spec::expect(queue.getCapacity() == 4, "expected capacity to be a power of 2");
+
+      for (unsigned i = 0; i < 4; i++) queue.push(i);
+
+      spec::expect(!queue.push(4), "expected input bits to be refused");
+      spec::expect(queue.pop(inputBits) && inputBits == 0, "expected oldest input bits");
+      spec::expect(queue.push(4), "expected room for input bits");
+    });
+
+    spec::it("hands over input bits from one thread to another", [] {
+      if (!hasThreads()) return;
+
+      const unsigned count = 100000;
+      InputQueue queue(8);
+      unsigned expected = 0;
+      bool ordered = true;
+
+      std::thread producer([&] {
+        for (unsigned i = 0; i < count; i++) {
+          while (!queue.push(i)) std::this_thread::yield();
+        }
+      });
+
+      while (expected < count) {
+        unsigned inputBits;
+        if (!queue.pop(inputBits)) {
+          std::this_thread::yield();
+          continue;
+        }
+
+        ordered = ordered && inputBits == expected;
+        expected++;
+      }
+
+      producer.join();
+
+      spec::expect(ordered, "expected input bits in the order they were pushed");
+    });
+  });
+
+  spec::describe("game::StateBuffer", [] {
+    spec::it("acquires the most recently published state", [] {
+      StateBuffer states(2);
+
+      spec::expect(states.acquire()[0] == 0, "expected an empty state");
+
+      for (double i = 1; i <= 3; i++) {
+        states.getBack()[0] = i;
+        states.publish();
+      }
+
+      spec::expect(states.acquire()[0] == 3, "expected the last state");
+      spec::expect(states.acquire()[0] == 3, "expected the same state again");
+    });
+
+    spec::it("keeps an acquired state as is until the next acquire", [] {
+      StateBuffer states(2);
+      states.getBack()[0] = 1;
+      states.publish();
+      const double* state = states.acquire();
+
+      for (double i = 2; i <= 5; i++) {
+        states.getBack()[0] = i;
+        states.publish();
+      }
+
+      spec::expect(state[0] == 1, "expected the acquired state to remain");
+      spec::expect(states.acquire()[0] == 5, "expected the last state");
+    });
+
+    spec::it("never hands out a state which is being written", [] {
+      if (!hasThreads()) return;
+
+      const unsigned size = 64;
+      const double count = 100000;
+      StateBuffer states(size);
+      bool consistent = true;
+      bool ordered = true;
+      double last = 0;
+
+      std::thread writer([&] {
+        for (double i = 1; i <= count; i++) {
+          double* state = states.getBack();
+          for (unsigned j = 0; j < size; j++) state[j] = i;
+          states.publish();
+        }
+      });
+
+      while (last < count) {
+        const double* state = states.acquire();
+
+        for (unsigned j = 1; j < size; j++) {
+          consistent = consistent && state[j] == state[0];
+        }
+
+        ordered = ordered && state[0] >= last;
+        last = state[0];
+        std::this_thread::yield();
+      }
+
+      writer.join();
+
+      spec::expect(consistent, "expected whole states");
+      spec::expect(ordered, "expected states in the order they were published");
+    });
+  });
+
+  spec::describe("game::Simulation", [] {
+    spec::it("plays the same match as stepping it directly", [] {
+      Simulation simulation;
+      Match match;
+      RandomInput input(3, 2);
+      simulation.addDefaultSnakes();
+      match.addDefaultSnakes();
+
+      for (unsigned tick = 0; tick < 600; tick++) {
+        unsigned inputBits = input(tick);
+        simulation.pushInput(inputBits);
+        simulation.tick();
+        match.step(inputBits);
+      }
+
+      const double* state = simulation.acquireState();
+      const Snake& snake = match._world._snakes[1];
+      const double* record = state + Simulation::HEADER_SIZE + Simulation::SNAKE_STRIDE;
+      unsigned long long alive = match._world._alive;
+
+      spec::expect(state[0] == 600, "expected the tick to match");
+      spec::expect(state[1] == (alive & 1) + ((alive >> 1) & 1), "expected the alive count to match");
+      spec::expect(state[2] == 2, "expected both snakes");
+      spec::expect(record[0] == snake._x && record[1] == snake._y, "expected the head to match");
+      spec::expect(record[3] == ((alive >> 1) & 1), "expected the alive flag to match");
+      spec::expect(isPublished(simulation, state, 1, snake._trail), "expected the trail to match");
+    });
+
+    spec::it("publishes trails as logged segments followed by their tails", [] {
+      Simulation simulation;
+      simulation.addDefaultSnakes();
+      RandomInput input(5, 2, 5, 20);
+      bool published = true;
+
+      for (unsigned tick = 0; tick < 1200; tick++) {
+        simulation.pushInput(input(tick));
+        simulation.tick();
+
+        const double* state = simulation.acquireState();
+        const World& world = simulation._match._world;
+
+        for (unsigned i = 0; i < world._snakes.size(); i++) {
+          published = published && isPublished(simulation, state, i, world._snakes[i]._trail);
+        }
+      }
+
+      spec::expect(published, "expected every state to match its trails");
+    });
+
+    spec::it("starts over once reset", [] {
+      Simulation simulation;
+      simulation.addDefaultSnakes();
+
+      for (unsigned tick = 0; tick < 300; tick++) simulation.tick();
+
+      simulation.reset();
+      simulation.addSnake(100, 100, 20, 0, 100);
+      simulation.tick();
+
+      const double* state = simulation.acquireState();
+      const World& world = simulation._match._world;
+
+      spec::expect(state[0] == 1, "expected the first tick");
+      spec::expect(state[2] == 1, "expected a single snake");
+      spec::expect(isPublished(simulation, state, 0, world._snakes[0]._trail), "expected the new trail");
+    });
+
+    spec::it("ticks on its own thread while states are read on another", [] {
+      if (!hasThreads()) return;
+
+      Simulation simulation(Match::WIDTH, Match::HEIGHT, 0);
+      simulation.addDefaultSnakes();
+      RandomInput input(9, 2);
+      double last = 0;
+      bool ordered = true;
+      bool readable = true;
+
+      spec::expect(simulation.start(), "expected the thread to start");
+
+      while (last < 600) {
+        const double* state = simulation.acquireState();
+        unsigned tick = state[0];
+
+        ordered = ordered && state[0] >= last;
+        last = state[0];
+        simulation.pushInput(input(tick));
+
+        // Every logged segment which the state counts can be read as it's being ticked
+        for (unsigned i = 0; i < state[2]; i++) {
+          const double* record = state + Simulation::HEADER_SIZE + i * Simulation::SNAKE_STRIDE;
+          unsigned logged = record[4];
+
+          for (unsigned id = 0; id < logged; id++) {
+            double kind = simulation.getSegment(i, id)[0];
+            readable = readable && (kind == geometry::ShapeBatch::LINE || kind == geometry::ShapeBatch::CIRCLE);
+          }
+        }
+
+        std::this_thread::yield();
+      }
+
+      simulation.stop();
+
+      const double* state = simulation.acquireState();
+      const World& world = simulation._match._world;
+
+      spec::expect(!simulation.isRunning(), "expected the thread to stop");
+      spec::expect(ordered, "expected states in the order they were published");
+      spec::expect(readable, "expected logged segments to be readable");
+      spec::expect(state[0] == simulation._match._tick, "expected the last state once stopped");
+      spec::expect(isPublished(simulation, state, 0, world._snakes[0]._trail), "expected the trail to match");
+    });
+  });
+}
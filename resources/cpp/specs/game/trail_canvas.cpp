@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <string>
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/graphics/framebuffer.h"
+#include "../../src/game/world.h"
+#include "../../src/game/trail_canvas.h"
+#include "../spec.h"
+
+// Renders the alpha channel of a framebuffer as text, so golden images can be kept
+// right next to the specs: "." is empty, "-" is less than half covered, "+" is partially
+// covered and "#" is fully covered
+static std::string getAlphaImage(const graphics::Framebuffer& framebuffer) {
+  std::string image;
+
+  for (unsigned y = 0; y < framebuffer._height; y++) {
+    for (unsigned x = 0; x < framebuffer._width; x++) {
+      unsigned alpha = framebuffer.getPixel(x, y).a;
+      image += alpha == 0 ? '.' : alpha < 128 ? '-' : alpha < 255 ? '+' : '#';
+    }
+
+    image += '\n';
+  }
+
+  return image;
+}
+
+// A single snake which makes a right turn every once in a while, long enough to cross
+// the edges of the given world
+static void stepTurningSnake(game::World& world, unsigned tick) {
+  world.step(game::World::TICK, tick % 90 < 15 ? 2 : 0);
+}
+
+void describeTrailCanvas() {
+  using namespace game;
+  using namespace graphics;
+
+  const Color white = { 255, 255, 255, 255 };
+  const Color black = { 0, 0, 0, 255 };
+
+  spec::describe("graphics::Framebuffer", [=] {
+    spec::it("strokes lines with butt caps", [=] {
+      Framebuffer framebuffer(16, 8);
+      framebuffer.strokeLine(geometry::Line(2, 3.5, 13, 3.5), white, 3);
+
+      spec::expect(getAlphaImage(framebuffer) ==
+        "................\n"
+        "................\n"
+        "..###########...\n"
+        "..###########...\n"
+        "..###########...\n"
+        "................\n"
+        "................\n"
+        "................\n", "expected the golden image");
+    });
+
+    spec::it("anti-aliases the edges of diagonal lines", [=] {
+      Framebuffer framebuffer(16, 8);
+      framebuffer.strokeLine(geometry::Line(2, 1, 14, 7), white, 3);
+
+      spec::expect(getAlphaImage(framebuffer) ==
+        "..#+-...........\n"
+        "..###+-.........\n"
+        ".-+####+-.......\n"
+        "...-+####+-.....\n"
+        ".....-+####+-...\n"
+        ".......-+####+-.\n"
+        ".........-+###..\n"
+        "...........-+#..\n", "expected the golden image");
+    });
+
+    spec::it("strokes arcs clockwise from their first radian", [=] {
+      Framebuffer framebuffer(16, 10);
+      framebuffer.strokeArc(geometry::Circle(8, 2, 6, 0, M_PI), white, 3);
+
+      spec::expect(getAlphaImage(framebuffer) ==
+        "................\n"
+        "................\n"
+        "-##+........+##-\n"
+        "-##+........+##-\n"
+        "-###-......-###-\n"
+        ".+##+-....-+##+.\n"
+        ".-+###++++###+-.\n"
+        "..-+########+-..\n"
+        "...-+######+-...\n"
+        ".....------.....\n", "expected the golden image");
+    });
+
+    spec::it("wraps strokes around the edges", [=] {
+      Framebuffer framebuffer(16, 6);
+      framebuffer.strokeLine(geometry::Line(10, 0.5, 20, 0.5), white, 3);
+
+      spec::expect(getAlphaImage(framebuffer) ==
+        "####......######\n"
+        "####......######\n"
+        "................\n"
+        "................\n"
+        "................\n"
+        "####......######\n", "expected the golden image");
+    });
+
+    spec::it("blends partially covered pixels over the background", [=] {
+      Framebuffer framebuffer(16, 8);
+      framebuffer.clear(black);
+      framebuffer.strokeLine(geometry::Line(2, 1, 14, 7), { 255, 0, 0, 255 }, 3);
+
+      Color edge = framebuffer.getPixel(3, 0);
+      Color inner = framebuffer.getPixel(2, 0);
+      spec::expect(edge.a == 255 && edge.r > 0 && edge.r < 255, "expected a dimmed edge");
+      spec::expect(inner.r == 255 && inner.g == 0 && inner.b == 0, "expected a solid stroke");
+    });
+  });
+
+  spec::describe("game::TrailCanvas", [=] {
+    spec::it("draws a growing trail piece by piece the same as all at once", [=] {
+      World world(320, 180);
+      world.addSnake(40, 40, 20, 0.3, 100);
+      TrailCanvas pieces(320, 180, black);
+      TrailCanvas whole(320, 180, black);
+
+      for (unsigned tick = 0; tick < 300; tick++) {
+        stepTurningSnake(world, tick);
+        pieces.draw(world);
+      }
+
+      whole.draw(world);
+
+      spec::expect(pieces._framebuffer._pixels == whole._framebuffer._pixels, "expected the same pixels");
+    });
+
+    spec::it("only paints what the trails have gained since the last draw", [=] {
+      World world(320, 180);
+      world.addSnake(40, 40, 20, 0.3, 100);
+      TrailCanvas canvas(320, 180, black);
+      unsigned maxPainted = 0;
+
+      for (unsigned tick = 0; tick < 300; tick++) {
+        stepTurningSnake(world, tick);
+        maxPainted = std::max(maxPainted, canvas.draw(world));
+      }
+
+      // A step of 100 px/s is less than 2 pixels long, and the stroke is 3 pixels wide
+      spec::expect(maxPainted <= 24, "expected a few pixels per draw");
+      spec::expect(canvas.draw(world) == 0, "expected nothing to be painted twice");
+    });
+
+    spec::it("starts over once cleared", [=] {
+      World world(320, 180);
+      world.addSnake(40, 40, 20, 0.3, 100);
+      TrailCanvas canvas(320, 180, black);
+      TrailCanvas whole(320, 180, black);
+
+      for (unsigned tick = 0; tick < 100; tick++) {
+        stepTurningSnake(world, tick);
+        canvas.draw(world);
+      }
+
+      world.reset();
+      world.addSnake(200, 100, 20, 2, 100);
+      canvas.clear();
+
+      for (unsigned tick = 0; tick < 100; tick++) {
+        stepTurningSnake(world, tick);
+        canvas.draw(world);
+      }
+
+      whole.draw(world);
+
+      spec::expect(canvas._framebuffer._pixels == whole._framebuffer._pixels, "expected no trace of the last match");
+    });
+  });
+}
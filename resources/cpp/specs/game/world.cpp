@@ -0,0 +1,332 @@
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include "../../src/game/world.h"
+#include "../../src/game/match.h"
+#include "../../src/game/replay.h"
+#include "../../src/game/ray_batch.h"
+#include "../spec.h"
+
+// The snakes which a step should have disqualified, found by testing the last bit of
+// each snake which was in the game against every segment of every trail exactly
+static unsigned long long getEliminated(const game::World& world, unsigned long long alive) {
+  using namespace game;
+
+  unsigned long long eliminated = 0;
+
+  for (unsigned i = 0; i < world._snakes.size(); i++) {
+    if (!(alive & (1ull << i))) continue;
+
+    const Snake& snake = world._snakes[i];
+    if (snake.hasFullTurn()) eliminated |= 1ull << i;
+
+    for (unsigned j = 0; j < world._snakes.size(); j++) {
+      if (!(alive & (1ull << j))) continue;
+
+      const geometry::TrailIndex& trail = world._snakes[j]._trail;
+      unsigned skip = j == i ? Snake::CONNECTED_SHAPES : 0;
+
+      for (unsigned id = 0; id + skip < trail.size(); id++) {
+        if (snake.hitsSegment(trail, id)) eliminated |= 1ull << i;
+      }
+    }
+  }
+
+  return eliminated;
+}
+
+void describeWorld() {
+  using namespace game;
+
+  spec::describe("game::World fixed ticks", [] {
+    spec::it("carries the time which didn't add up to a tick over", [] {
+      World world(1280, 720);
+      world.addSnake(100, 100, 50, 0, 100);
+
+      world.advance(World::TICK * 0.5, 0);
+      double x = world._snakes.at(0)._currentLine._x2;
+      world.advance(World::TICK * 0.6, 0);
+
+      spec::expect(x == 100, "expected no tick to be made");
+      spec::expect(world._snakes.at(0)._currentLine._x2 > 100, "expected a single tick to be made");
+    });
+
+    spec::it("doesn't depend on the frame rate", [] {
+      Match matchA;
+      Match matchB;
+      matchA.addDefaultSnakes();
+      matchB.addDefaultSnakes();
+
+      // 30 fps against 60 fps, with the same input
+      for (unsigned frame = 0; frame < 120; frame++) {
+        matchA._world.advance(1000.0 / 30, frame < 60 ? 1 : 8);
+      }
+
+      for (unsigned tick = 0; tick < 240; tick++) {
+        matchB._world.advance(World::TICK, tick < 120 ? 1 : 8);
+      }
+
+      spec::expect(getStateBytes(matchA) == getStateBytes(matchB), "expected states to match");
+    });
+  });
+
+  spec::describe("game::World disqualifications", [] {
+    spec::it("disqualifies snakes which run into each other during the same step together", [] {
+      // The snakes cross paths at right angles, and reach the crossing point together
+      for (bool swapped : { false, true }) {
+        World world(1280, 720);
+        double rads[] = { 0, 0.5 * M_PI };
+
+        for (unsigned i = 0; i < 2; i++) {
+          unsigned snake = swapped ? 1 - i : i;
+          world.addSnake(snake ? 200 : 99.5, snake ? 99.5 : 200, 50, rads[snake], 100);
+        }
+
+        StepStatus status = { 3, 0, 2 };
+        unsigned ticks = 0;
+
+        while (!status.eliminated && ticks++ < 600) status = world.step(World::TICK, 0);
+
+        spec::expect(status.eliminated == 3, "expected both snakes to be disqualified");
+        spec::expect(ticks == 62, "expected the snakes to be disqualified once they cross");
+      }
+    });
+
+    spec::it("disqualifies the same snakes as testing every segment exactly", [] {
+      bool same = true;
+
+      for (unsigned seed = 1; seed <= 8; seed++) {
+        World world(640, 360);
+        RandomInput input(seed, 6, 10, 60);
+
+        for (unsigned i = 0; i < 6; i++) {
+          world.addSnake(80 + (i % 3) * 200, 90 + (i / 3) * 180, 30, i * 1.1, 100);
+        }
+
+        for (unsigned tick = 0; tick < 3000 && world._alive; tick++) {
+          unsigned long long alive = world._alive;
+          StepStatus status = world.step(World::TICK, input(tick));
+          unsigned long long expected = getEliminated(world, alive);
+
+          same = same && status.eliminated == expected;
+        }
+      }
+
+      spec::expect(same, "expected the same disqualifications");
+    });
+  });
+
+  spec::describe("game::World capacity", [] {
+    spec::it("steps more snakes than the input bits cover", [] {
+      World world(1600, 1200);
+      std::mt19937 random(3);
+      bool same = true;
+      bool turned = false;
+      unsigned long long eliminated = 0;
+
+      for (unsigned i = 0; i < 40; i++) {
+        world.addSnake(100 + (i % 8) * 200, 100 + (i / 8) * 240, 30, i * 0.7, 100);
+      }
+
+      // Each snake holds left, right or nothing for a third of a second at a time
+      for (unsigned tick = 0; tick < 1200 && world._alive; tick++) {
+        if (tick % 20 == 0) {
+          for (unsigned i = 0; i < 40; i++) world.setInput(i, random() % 3);
+        }
+
+        unsigned long long alive = world._alive;
+        StepStatus status = world.step(World::TICK);
+
+        same = same && status.eliminated == getEliminated(world, alive);
+        turned = turned || world._snakes[39]._currentIsCircle;
+        eliminated |= status.eliminated;
+      }
+
+      spec::expect(same, "expected the same disqualifications as testing every segment exactly");
+      spec::expect(turned, "expected the last snake to turn");
+      spec::expect(eliminated >> 32, "expected snakes past the first 32 to be disqualified");
+    });
+
+    spec::it("keeps the input of the snakes which the input bits don't cover", [] {
+      World world(1280, 720);
+
+      for (unsigned i = 0; i < 20; i++) world.addSnake(100 + i * 50, 360, 20, 0, 100);
+
+      world.setInput(18, 1);
+      world.step(World::TICK, 0);
+
+      spec::expect(!world._snakes[0]._currentIsCircle, "expected the first snake to go straight");
+      spec::expect(world._snakes[18]._currentIsCircle, "expected its own input to be held");
+    });
+
+    spec::it("holds up to MAX_SNAKES snakes", [] {
+      World world(1280, 720);
+      bool thrown = false;
+
+      for (unsigned i = 0; i < World::MAX_SNAKES; i++) {
+        world.addSnake(20 + (i % 8) * 150, 20 + (i / 8) * 85, 20, 0, 100);
+      }
+
+      try {
+        world.addSnake(640, 360, 20, 0, 100);
+      }
+      catch (const std::length_error&) {
+        thrown = true;
+      }
+
+      spec::expect(thrown, "expected the snake past the limit to be refused");
+      spec::expect(world._alive == ~0ull, "expected every snake to be alive");
+      spec::expect(world.step(World::TICK).aliveCount == World::MAX_SNAKES, "expected every snake to be stepped");
+    });
+  });
+
+  spec::describe("game::World ray casts", [] {
+    spec::it("reports the nearest snake each ray hits", [] {
+      World world(1280, 720);
+      world.addSnake(100, 100, 50, 0, 100);
+      world.addSnake(300, 50, 50, 0.5 * M_PI, 100);
+
+      for (unsigned tick = 0; tick < 60; tick++) world.step(World::TICK, 0);
+
+      double angles[] = { 0, M_PI };
+      geometry::RayHit hits[2];
+      world.castRays(50, 100, angles, 2, 1000, hits);
+
+      spec::expect(hits[0].owner == 0 && hits[0].distance == 50, "expected the first snake to be hit");
+      spec::expect(hits[1].owner == -1 && hits[1].distance == 1000, "expected nothing to be hit");
+    });
+
+    spec::it("doesn't see the shapes connected to the given snake's head", [] {
+      World world(1280, 720);
+      world.addSnake(100, 100, 50, 0, 100);
+      world.addSnake(300, 50, 50, 0.5 * M_PI, 100);
+
+      for (unsigned tick = 0; tick < 60; tick++) world.step(World::TICK, 0);
+
+      const Snake& snake = world._snakes.at(0);
+      double angles[] = { M_PI };
+      geometry::RayHit hits[1];
+      world.castRays(snake._x, snake._y, angles, 1, 1000, hits, 0);
+
+      spec::expect(hits[0].owner == -1, "expected own trail not to be hit");
+    });
+
+    spec::it("writes a record for each ray of a batch", [] {
+      World world(1280, 720);
+      world.addSnake(100, 100, 50, 0, 100);
+      world.addSnake(300, 50, 50, 0.5 * M_PI, 100);
+
+      for (unsigned tick = 0; tick < 60; tick++) world.step(World::TICK, 0);
+
+      RayBatch batch(2);
+      batch._rays[0] = 0;
+      batch._rays[RayBatch::RAY_STRIDE] = M_PI;
+
+      spec::expect(batch.cast(world, 200, 100, 2, 1000, -1) == 2, "expected 2 hits");
+      spec::expect(std::abs(batch._rays[1] - 100) < 1e-9 && batch._rays[2] == 1, "expected the second snake to be hit ahead");
+      spec::expect(batch._rays[5] > 0 && batch._rays[6] == 0, "expected the first snake to be hit behind");
+    });
+  });
+
+  spec::describe("game::World impacts", [] {
+    spec::it("times the first trail a long step would run into", [] {
+      World world(1280, 720);
+      world.addSnake(50, 200, 50, 0, 100);
+
+      for (unsigned tick = 0; tick < 60; tick++) world.step(World::TICK, 0);
+
+      // Heads up towards the trail of the first snake, which is 100 units away
+      unsigned index = world.addSnake(100, 300, 50, -0.5 * M_PI, 100);
+      geometry::Impact impact = world.getImpact(index, 4000, 0);
+
+      spec::expect(impact.owner == 0 && impact.edges == 0, "expected the first snake to be hit");
+      spec::expect(std::abs(impact.time - 0.25) < 1e-9, "expected the trail to be hit a quarter through");
+    });
+
+    spec::it("times the edge a long step would wrap around at", [] {
+      World world(1280, 720);
+      unsigned index = world.addSnake(100, 50, 50, -0.5 * M_PI, 100);
+      geometry::Impact impact = world.getImpact(index, 1000, 0);
+
+      spec::expect(impact.edges == geometry::Arena::TOP, "expected the top edge to be hit");
+      spec::expect(std::abs(impact.time - 0.5) < 1e-9, "expected the edge to be hit halfway through");
+    });
+  });
+
+  spec::describe("game::World long steps", [] {
+    spec::it("ends up in the exact same state as fine ticks", [] {
+      Match fine;
+      Match coarse;
+
+      // The first snake wraps around, the second turns for a whole circle, and the
+      // third runs into the trail of the first
+      for (Match* match : { &fine, &coarse }) {
+        match->_world.addSnake(100, 100, 50, 0, 100);
+        match->_world.addSnake(600, 400, 50, 0, 100);
+        match->_world.addSnake(300, 500, 50, -0.5 * M_PI, 100);
+      }
+
+      coarse._world.setTicksPerStep(World::MAX_CATCH_UP);
+      bool same = true;
+
+      for (unsigned frame = 0; frame < 90; frame++) {
+        StepStatus fineStatus = fine._world.advance(World::TICK * 10, 1 << 2);
+        StepStatus coarseStatus = coarse._world.advance(World::TICK * 10, 1 << 2);
+
+        same = same &&
+          fineStatus.alive == coarseStatus.alive &&
+          fineStatus.eliminated == coarseStatus.eliminated &&
+          getStateBytes(fine) == getStateBytes(coarse);
+      }
+
+      spec::expect(same, "expected the same state after every frame");
+      spec::expect(fine._world._alive == 1, "expected the second and third snakes to be disqualified");
+    });
+
+    spec::it("ends up in the exact same state as fine ticks with random input", [] {
+      bool same = true;
+
+      for (unsigned seed = 1; seed <= 20; seed++) {
+        Match fine;
+        Match coarse;
+        RandomInput input(seed, 2, 10, 60);
+
+        fine.addDefaultSnakes();
+        coarse.addDefaultSnakes();
+        coarse._world.setTicksPerStep(World::MAX_CATCH_UP);
+
+        // Frames of 1 to 10 ticks, so runs of all lengths are made
+        for (unsigned frame = 0; frame < 300 && fine._world._alive; frame++) {
+          unsigned inputBits = input(frame);
+          double elapsed = World::TICK * (1 + frame % World::MAX_CATCH_UP);
+          fine._world.advance(elapsed, inputBits);
+          coarse._world.advance(elapsed, inputBits);
+
+          same = same &&
+            getStateBytes(fine) == getStateBytes(coarse) &&
+            fine._world._lag == coarse._world._lag;
+        }
+      }
+
+      spec::expect(same, "expected the same state after every frame");
+    });
+
+    spec::it("only allows up to MAX_CATCH_UP ticks per step", [] {
+      World world(1280, 720);
+      unsigned thrown = 0;
+
+      for (unsigned ticks : { 0u, World::MAX_CATCH_UP + 1 }) {
+        try {
+          world.setTicksPerStep(ticks);
+        }
+        catch (const std::out_of_range&) {
+          thrown++;
+        }
+      }
+
+      world.setTicksPerStep(World::MAX_CATCH_UP);
+
+      spec::expect(thrown == 2, "expected both tick counts to be rejected");
+    });
+  });
+}
\ No newline at end of file
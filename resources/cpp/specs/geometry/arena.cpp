@@ -0,0 +1,54 @@
+#include <cmath>
+#include "../../src/geometry/point.h"
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/arena.h"
+#include "../spec.h"
+
+void describeArena() {
+  using namespace geometry;
+
+  spec::describe("geometry::Arena", [] {
+    spec::it("ignores bits which are within the bounds", [] {
+      Arena arena(100, 50);
+      Crossing crossing = arena.getCrossing(Line(10, 10, 20, 20), { 20, 20 });
+
+      spec::expect(!crossing.hasValue(), "expected no crossing");
+      spec::expect(crossing.head.x == 20 && crossing.head.y == 20, "expected head to remain");
+    });
+
+    spec::it("wraps a bit which crosses a single edge", [] {
+      Arena arena(100, 50);
+      Crossing crossing = arena.getCrossing(Line(98, 10, 102, 10), { 102, 10 });
+
+      spec::expect(crossing.edges == Arena::RIGHT, "expected right edge to be crossed");
+      spec::expect(crossing.pointsCount == 1, "expected a single split point");
+      spec::expect(crossing.points[0].x == 100 && crossing.points[0].y == 10,
+        "expected split point to be on the edge");
+      spec::expect(crossing.head.x == 2 && crossing.head.y == 10, "expected head to be wrapped");
+    });
+
+    spec::it("wraps a bit which passes by a corner along both axes", [] {
+      Arena arena(100, 50);
+      // Leaves through the top edge, next to the top right corner
+      Crossing crossing = arena.getCrossing(Line(98, 1, 102, -3), { 102, -3 });
+
+      spec::expect(crossing.edges == (Arena::TOP | Arena::RIGHT), "expected 2 edges to be crossed");
+      spec::expect(crossing.pointsCount == 1, "expected a single split point");
+      spec::expect(crossing.head.x == 2 && crossing.head.y == 47, "expected head to be wrapped");
+    });
+
+    spec::it("wraps an arc which crosses 2 edges in a single step", [] {
+      Arena arena(100, 50);
+      // Leaves through the bottom edge and curves beyond the left one
+      Circle arc(2, 46, 5, 0.5, 2.5);
+      Point head = { 2 + 5 * std::cos(2.5), 46 + 5 * std::sin(2.5) };
+      Crossing crossing = arena.getCrossing(arc, head);
+
+      spec::expect(crossing.edges == (Arena::BOTTOM | Arena::LEFT), "expected 2 edges to be crossed");
+      spec::expect(crossing.pointsCount == 1, "expected a single split point");
+      spec::expect(crossing.head.x > 97 && crossing.head.x < 98, "expected x to be wrapped");
+      spec::expect(crossing.head.y == head.y, "expected y to remain");
+    });
+  });
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include <cmath>
+#include "../../src/geometry/box.h"
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../spec.h"
+
+static bool isBoxClose(const geometry::Box& box, double minX, double minY, double maxX, double maxY) {
+  return std::abs(box.minX - minX) < 1e-9 && std::abs(box.minY - minY) < 1e-9 &&
+         std::abs(box.maxX - maxX) < 1e-9 && std::abs(box.maxY - maxY) < 1e-9;
+}
+
+void describeBox() {
+  using namespace geometry;
+
+  spec::describe("geometry::Line bounding box", [] {
+    spec::it("covers the line's end points", [] {
+      Line line(4, 3, 1, 2);
+      spec::expect(isBoxClose(line.getBox(), 1, 2, 4, 3), "expected box to match");
+    });
+
+    spec::it("is updated once the end points change", [] {
+      Line line(1, 1, 2, 2);
+      line.setX2(5);
+      line.setY1(-1);
+      spec::expect(isBoxClose(line.getBox(), 1, -1, 5, 2), "expected box to match");
+    });
+  });
+
+  spec::describe("geometry::Circle bounding box", [] {
+    spec::it("covers the whole circle when it's complete", [] {
+      Circle circle(0, 0, 2, -1, -1 + (2 * M_PI));
+      spec::expect(isBoxClose(circle.getBox(), -2, -2, 2, 2), "expected box to match");
+    });
+
+    spec::it("covers an arc's actual sweep", [] {
+      Circle circle(0, 0, 1, 0, 0.5 * M_PI);
+      spec::expect(isBoxClose(circle.getBox(), 0, 0, 1, 1), "expected box to match");
+    });
+
+    spec::it("covers an arc's sweep regardless of the order of its radians", [] {
+      Circle circle(0, 0, 1, 2.5 * M_PI, 1.5 * M_PI);
+      spec::expect(isBoxClose(circle.getBox(), 0, -1, 1, 1), "expected box to match");
+    });
+
+    spec::it("is updated once the radians change", [] {
+      Circle circle(0, 0, 1, 0, 0.5 * M_PI);
+      circle.setRad2(M_PI);
+      spec::expect(isBoxClose(circle.getBox(), -1, 0, 1, 1), "expected box to match");
+    });
+  });
+
+  spec::describe("geometry intersection methods", [] {
+    spec::it("reject shapes whose boxes are far apart", [] {
+      Circle arc(0, 0, 10, 0, 0.5 * M_PI);
+      Line line(-20, -5, 20, -5);
+      spec::expect(arc.getIntersection(line).isNull(), "expected no intersection");
+      spec::expect(line.getIntersection(arc).isNull(), "expected no intersection");
+    });
+  });
+}
\ No newline at end of file
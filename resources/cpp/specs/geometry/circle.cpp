@@ -0,0 +1,61 @@
+#include <cmath>
+#include "../../src/geometry/circle.h"
+#include "../spec.h"
+
+void describeCircle() {
+  using namespace geometry;
+
+  spec::describe("geometry::Circle::hasPoint", [] {
+    spec::it("tells whether a point's direction is within the arc", [] {
+      Circle arc(0, 0, 1, 0, 0.5 * M_PI);
+      spec::expect(arc.hasPoint(1, 1), "expected the middle of the arc to be contained");
+      spec::expect(arc.hasPoint(1, 0), "expected the arc's start to be contained");
+      spec::expect(arc.hasPoint(0, 1), "expected the arc's end to be contained");
+      spec::expect(!arc.hasPoint(-1, -1), "expected the opposite direction not to be contained");
+      spec::expect(!arc.hasPoint(1, -0.01), "expected a direction past the start not to be contained");
+    });
+
+    spec::it("handles arcs greater than a half circle", [] {
+      Circle arc(0, 0, 1, -0.25 * M_PI, 1.25 * M_PI);
+      spec::expect(arc.hasPoint(0, 1), "expected the middle of the arc to be contained");
+      spec::expect(arc.hasPoint(-1, 0), "expected a side of the arc to be contained");
+      spec::expect(!arc.hasPoint(0, -1), "expected the gap not to be contained");
+    });
+
+    spec::it("handles arcs whose radians are several turns away", [] {
+      Circle arc(0, 0, 1, -13.966, -8.025);
+      spec::expect(arc.hasPoint(std::cos(-2.513), std::sin(-2.513)), "expected point to be contained");
+      spec::expect(!arc.hasPoint(std::cos(4.7), std::sin(4.7)), "expected point not to be contained");
+    });
+
+    spec::it("handles arcs which have wound full turns as whole circles", [] {
+      Circle arc(0, 0, 1, 1, 1 + (5 * M_PI));
+      spec::expect(arc.hasPoint(1, 0), "expected point to be contained");
+      spec::expect(arc.hasPoint(-1, -1), "expected point to be contained");
+    });
+
+    spec::it("is updated once the radians change", [] {
+      Circle arc(0, 0, 1, 0, 0.5 * M_PI);
+      arc.setRad2(1.5 * M_PI);
+      spec::expect(arc.hasPoint(-1, 0), "expected point to be contained");
+    });
+  });
+  spec::describe("geometry::Circle::getRayDistance", [] {
+    spec::it("hits the nearest point of the arc in front of the origin", [] {
+      Circle circle(0, 0, 10, 0, 2 * M_PI);
+      Nullable<double> distance = circle.getRayDistance({ -20, 0 }, { 1, 0 });
+      spec::expect(distance.hasValue() && distance.getValue() == 10, "expected a hit at 10");
+    });
+
+    spec::it("hits the far side once the near side is out of the arc's sweep", [] {
+      Circle arc(0, 0, 10, -0.5 * M_PI, 0.5 * M_PI);
+      Nullable<double> distance = arc.getRayDistance({ -20, 0 }, { 1, 0 });
+      spec::expect(distance.hasValue() && distance.getValue() == 30, "expected a hit at 30");
+    });
+
+    spec::it("misses circles behind the origin", [] {
+      Circle circle(0, 0, 10, 0, 2 * M_PI);
+      spec::expect(!circle.getRayDistance({ -20, 0 }, { -1, 0 }).hasValue(), "expected no hit");
+    });
+  });
+}
\ No newline at end of file
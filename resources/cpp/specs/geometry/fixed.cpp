@@ -0,0 +1,141 @@
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/fixed_line.h"
+#include "../../src/geometry/fixed_circle.h"
+#include "../../src/geometry/backend.h"
+#include "../../src/geometry/shape_list.h"
+#include "../../src/geometry/arena.h"
+#include "../../src/game/snake.h"
+#include "../spec.h"
+
+// Whether both intersections have the same points, up to a single nano unit
+static bool isSameIntersection(const geometry::Intersection& a, const geometry::Intersection& b) {
+  if (a.size() != b.size()) return false;
+
+  for (unsigned i = 0; i < a.size(); i++) {
+    if (std::abs(a.at(i).x - b.at(i).x) > 1.5e-9 || std::abs(a.at(i).y - b.at(i).y) > 1.5e-9) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Copies the given trail into a shape list of the given backend
+template <typename Backend>
+static void copyTrail(const geometry::TrailIndex& trail, geometry::ShapeList<Backend>& list) {
+  for (unsigned id = 0; id < trail.size(); id++) {
+    if (trail.isCircle(id)) {
+      const geometry::Circle& circle = trail.getCircle(id);
+      list.appendCircle(circle._x, circle._y, circle._r, circle._rad1, circle._rad2);
+    }
+    else {
+      const geometry::Line& line = trail.getLine(id);
+      list.appendLine(line._x1, line._y1, line._x2, line._y2);
+    }
+  }
+}
+
+void describeFixed() {
+  using namespace geometry;
+
+  spec::describe("geometry fixed-point backend", [] {
+    spec::it("meets lines which touch at their ends", [] {
+      Intersection intersection = FixedLine(0, 0, 10, 10).getIntersection(FixedLine(10, 10, 20, 0));
+
+      spec::expect(intersection.size() == 1, "expected a single point");
+      spec::expect(intersection.at(0).x == 10 && intersection.at(0).y == 10, "expected the shared end");
+    });
+
+    spec::it("tells apart lines which miss by a single nano unit", [] {
+      FixedLine line(0, 0, 10, 0);
+
+      spec::expect(line.getIntersection(FixedLine(5, 1, 5, 0.000000001)).isNull(), "expected no intersection");
+      spec::expect(line.getIntersection(FixedLine(5, 1, 5, 0)).hasValue(), "expected an intersection");
+      spec::expect(line.getIntersection(FixedLine(0, 0, 10, 0)).isNull(), "expected parallel lines not to meet");
+    });
+
+    spec::it("meets arcs the same way the double backend does", [] {
+      Circle circle(1, 1, 5, 0, 1.5 * M_PI);
+      FixedCircle fixedCircle(1, 1, 5, 0, 1.5 * M_PI);
+
+      spec::expect(isSameIntersection(
+        circle.getIntersection(Line(-10, 1, 10, 1)),
+        fixedCircle.getIntersection(FixedLine(-10, 1, 10, 1))
+      ), "expected the same points with a line");
+      spec::expect(isSameIntersection(
+        circle.getIntersection(Circle(-5, 1, 5, 0, 2 * M_PI)),
+        fixedCircle.getIntersection(FixedCircle(-5, 1, 5, 0, 2 * M_PI))
+      ), "expected the same points with a circle");
+      spec::expect(fixedCircle.getIntersection(FixedCircle(1, 1, 2, 0, 2 * M_PI)).isNull(),
+        "expected a circle within another one not to meet it");
+    });
+
+    spec::it("gives the same results as the double backend on recorded trails", [] {
+      const Arena arena(800, 600);
+      std::mt19937 random(7);
+      std::vector<game::Snake> snakes = {
+        game::Snake(200, 150, 30, 0, 100),
+        game::Snake(600, 150, 30, 0.5 * M_PI, 100),
+        game::Snake(200, 450, 30, M_PI, 100),
+        game::Snake(600, 450, 30, 1.5 * M_PI, 100)
+      };
+      std::vector<game::Direction> directions(snakes.size(), game::Direction::NONE);
+      // The last bits of all the snakes, along with the index of the snake they belong to
+      std::vector<std::pair<unsigned, game::Snake>> lastBits;
+
+      for (unsigned step = 0; step < 3000; step++) {
+        for (unsigned i = 0; i < snakes.size(); i++) {
+          if (random() % 30 == 0) directions[i] = (game::Direction) (random() % 3);
+
+          snakes[i].update(16, directions[i], arena);
+          lastBits.push_back({ i, snakes[i] });
+        }
+      }
+
+      unsigned hits = 0;
+      unsigned mismatches = 0;
+
+      // Bits are only tested against the trails of the opponents, since a bit runs right
+      // along its own trail, where the double backend finds points between lines which
+      // are only parallel up to their trimming
+      for (unsigned i = 0; i < snakes.size(); i++) {
+        ShapeList<DoubleBackend> doubleList;
+        ShapeList<FixedBackend> fixedList;
+        copyTrail(snakes[i]._trail, doubleList);
+        copyTrail(snakes[i]._trail, fixedList);
+
+        for (const auto& lastBit : lastBits) {
+          if (lastBit.first == i) continue;
+
+          const game::Snake& bit = lastBit.second;
+          Intersection expected;
+          Intersection actual;
+
+          if (bit._lastBitIsCircle) {
+            const Circle& circle = bit._lastCircle;
+            expected = doubleList.getIntersection(circle);
+            actual = fixedList.getIntersection(
+              FixedCircle(circle._x, circle._y, circle._r, circle._rad1, circle._rad2)
+            );
+          }
+          else {
+            const Line& line = bit._lastLine;
+            expected = doubleList.getIntersection(line);
+            actual = fixedList.getIntersection(FixedLine(line._x1, line._y1, line._x2, line._y2));
+          }
+
+          if (expected.hasValue()) hits++;
+          if (!isSameIntersection(expected, actual)) mismatches++;
+        }
+      }
+
+      spec::expect(hits > 100, "expected the trails to be hit");
+      spec::expect(mismatches == 0, "expected both backends to match");
+    });
+  });
+}
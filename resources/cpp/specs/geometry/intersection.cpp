@@ -0,0 +1,76 @@
+#include <cmath>
+#include "../../src/geometry/point.h"
+#include "../../src/geometry/intersection.h"
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/trail_index.h"
+#include "../allocations.h"
+#include "../spec.h"
+
+void describeIntersection() {
+  using namespace geometry;
+
+  spec::describe("geometry::Intersection", [] {
+    spec::it("ignores consecutive duplicated points", [] {
+      Intersection intersection;
+      intersection.push({ 1, 1 });
+      intersection.push({ 1, 1 });
+      spec::expect(intersection.size() == 1, "expected a single point");
+    });
+
+    spec::it("holds up to 2 points", [] {
+      Intersection intersection;
+      intersection.push({ 1, 1 });
+      intersection.push({ 2, 2 });
+      intersection.push({ 3, 3 });
+      spec::expect(intersection.size() == 2, "expected 2 points");
+      spec::expect(intersection.at(1).x == 2, "expected the second point to be kept");
+    });
+  });
+
+  spec::describe("geometry intersection methods", [] {
+    Circle circle(1, 1, 5, 0, 1.5 * M_PI);
+    Circle fullCircle(-5, 1, 5, 0, 2 * M_PI);
+    Circle outerCircle(10, 10, 2, 0, 2 * M_PI);
+    Line line(-10, 1, 10, 1);
+    Line crossingLine(1, -5, 1, 5);
+    Line outerLine(-10, 10, 10, 10);
+
+    spec::it("make no heap allocations", [&] {
+      unsigned long allocationsCount = spec::allocations::count();
+      unsigned pointsCount = 0;
+
+      pointsCount += circle.getIntersection(fullCircle).size();
+      pointsCount += circle.getIntersection(outerCircle).size();
+      pointsCount += circle.getIntersection(line).size();
+      pointsCount += circle.getIntersection(outerLine).size();
+      pointsCount += line.getIntersection(circle).size();
+      pointsCount += line.getIntersection(crossingLine).size();
+      pointsCount += line.getIntersection(outerLine).size();
+
+      allocationsCount = spec::allocations::count() - allocationsCount;
+
+      spec::expect(allocationsCount == 0, "expected no allocations");
+      spec::expect(pointsCount == 7, "expected intersection points to be found");
+    });
+
+    spec::it("make no heap allocations when querying a trail index", [&] {
+      TrailIndex trailIndex;
+      trailIndex.append(circle);
+      trailIndex.append(crossingLine);
+      trailIndex.append(outerLine);
+
+      unsigned long allocationsCount = spec::allocations::count();
+      unsigned pointsCount = 0;
+
+      pointsCount += trailIndex.getIntersection(line).size();
+      pointsCount += trailIndex.getIntersection(fullCircle).size();
+      pointsCount += trailIndex.getIntersection(line, 3).size();
+
+      allocationsCount = spec::allocations::count() - allocationsCount;
+
+      spec::expect(allocationsCount == 0, "expected no allocations");
+      spec::expect(pointsCount == 4, "expected intersection points to be found");
+    });
+  });
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <cmath>
+#include "../../src/geometry/box.h"
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/occupancy_grid.h"
+#include "../spec.h"
+
+void describeOccupancyGrid() {
+  using namespace geometry;
+
+  spec::describe("geometry::OccupancyGrid", [] {
+    spec::it("stamps every cell a line passes through, but not its whole box", [] {
+      OccupancyGrid grid(320, 320);
+      grid.stamp(Line(10, 10, 300, 300), 2);
+      bool covered = true;
+
+      for (double t = 0; t <= 1; t += 0.01) {
+        double x = 10 + 290 * t;
+        double y = 10 + 290 * t;
+        covered = covered && grid.getOwners(Box { x, y, x, y }) == 4u;
+      }
+
+      spec::expect(covered, "expected the whole line to be stamped");
+      spec::expect(grid.getOwners(Box { 250, 40, 260, 50 }) == 0, "expected a corner of its box to be empty");
+    });
+
+    spec::it("stamps every cell an arc passes through", [] {
+      OccupancyGrid grid(320, 320);
+      Circle circle(160, 160, 100, -2, 1);
+      grid.stamp(circle, 0);
+      bool covered = true;
+
+      for (double rad = -2; rad <= 1; rad += 0.01) {
+        double x = 160 + 100 * std::cos(rad);
+        double y = 160 + 100 * std::sin(rad);
+        covered = covered && grid.getOwners(Box { x, y, x, y }) == 1u;
+      }
+
+      spec::expect(covered, "expected the whole arc to be stamped");
+      spec::expect(grid.getOwners(Box { 155, 155, 165, 165 }) == 0, "expected the center to be empty");
+      spec::expect(grid.getOwners(Box { 60, 230, 70, 240 }) == 0, "expected the rest of the circle to be empty");
+    });
+
+    spec::it("clamps shapes beyond the edges into the cells along them", [] {
+      OccupancyGrid grid(320, 180);
+      grid.stamp(Line(300, 100, 330, 100), 1);
+      grid.stamp(Line(100, -20, 100, -5), 3);
+
+      spec::expect(grid.getOwners(Box { 325, 99, 326, 101 }) == 2u, "expected a query beyond the edge to meet it");
+      spec::expect(grid.getOwners(Box { 99, -12, 101, -11 }) == 8u, "expected a query above the arena to meet it");
+      spec::expect(grid.getOwners(Box { 99, 170, 101, 200 }) == 0, "expected the opposite edge to be empty");
+    });
+
+    spec::it("forgets all the stamps once cleared", [] {
+      OccupancyGrid grid(320, 180);
+      grid.stamp(Line(0, 0, 320, 180), 5);
+      grid.clear();
+
+      spec::expect(grid.getOwners(Box { 0, 0, 320, 180 }) == 0, "expected an empty grid");
+    });
+  });
+}
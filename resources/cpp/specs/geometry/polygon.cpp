@@ -0,0 +1,130 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../src/geometry/point.h"
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/polygon.h"
+#include "../spec.h"
+
+// Scattered short edges over a 1280x720 arena, like the obstacles of a custom map
+static std::vector<geometry::Line> makeObstacles(unsigned seed, unsigned count) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<double> x(0, 1280);
+  std::uniform_real_distribution<double> y(0, 720);
+  std::uniform_real_distribution<double> offset(-40, 40);
+  std::vector<geometry::Line> edges;
+
+  for (unsigned i = 0; i < count; i++) {
+    double x1 = x(random);
+    double y1 = y(random);
+    edges.push_back(geometry::Line(x1, y1, x1 + offset(random), y1 + offset(random)));
+  }
+
+  return edges;
+}
+
+static bool isSame(const std::vector<geometry::Point>& a, const std::vector<geometry::Point>& b) {
+  if (a.size() != b.size()) return false;
+
+  for (unsigned i = 0; i < a.size(); i++) {
+    if (a[i].x != b[i].x || a[i].y != b[i].y) return false;
+  }
+
+  return true;
+}
+
+void describePolygon() {
+  using namespace geometry;
+
+  spec::describe("geometry::Polygon", [] {
+    std::vector<Line> square = {
+      Line(0, 0, 5, 0),
+      Line(5, 0, 5, 5),
+      Line(5, 5, 0, 5),
+      Line(0, 5, 0, 0)
+    };
+
+    spec::it("returns the intersection points of all edges in their order", [=] {
+      Polygon polygon(square);
+      std::vector<Point> line = polygon.getIntersection(Line(0, 1, 5, 4));
+      std::vector<Point> circle = polygon.getIntersection(Circle(0, 0, 2, 0, 2 * M_PI));
+
+      spec::expect(isSame(line, { { 5, 4 }, { 0, 1 } }), "expected the points of the line");
+      spec::expect(isSame(circle, { { 2, 0 }, { 0, 2 } }), "expected the points of the circle");
+      spec::expect(polygon.getIntersection(Circle(2.5, 2.5, 2, 0, 2 * M_PI)).empty(), "expected no points for an inner circle");
+    });
+
+    spec::it("tells if a point lies on any of the edges", [=] {
+      Polygon polygon(square);
+
+      spec::expect(polygon.hasPoint(5, 3), "expected a point on an edge");
+      spec::expect(!polygon.hasPoint(10, 10), "expected no point out of the edges");
+    });
+
+    spec::it("finds the same intersections as testing every edge", [] {
+      std::vector<Line> edges = makeObstacles(5, 400);
+      std::vector<Line> queries = makeObstacles(6, 300);
+      Polygon polygon(edges);
+      bool same = true;
+
+      for (unsigned i = 0; i < queries.size(); i++) {
+        const Line& line = queries[i];
+        Circle circle(line._x1, line._y1, 25, i * 0.1, i * 0.1 + 2);
+        std::vector<Point> linePoints;
+        std::vector<Point> circlePoints;
+
+        for (const Line& edge : edges) {
+          Intersection lineIntersection = line.getIntersection(edge);
+          Intersection circleIntersection = circle.getIntersection(edge);
+          linePoints.insert(linePoints.end(), lineIntersection.begin(), lineIntersection.end());
+          circlePoints.insert(circlePoints.end(), circleIntersection.begin(), circleIntersection.end());
+        }
+
+        same = same &&
+          isSame(polygon.getIntersection(line), linePoints) &&
+          isSame(polygon.getIntersection(circle), circlePoints) &&
+          polygon.intersects(line) == !linePoints.empty() &&
+          polygon.intersects(circle) == !circlePoints.empty();
+      }
+
+      spec::expect(same, "expected the same intersections");
+    });
+
+    spec::it("intersects polygons edge by edge", [] {
+      std::vector<Line> edgesA = makeObstacles(7, 200);
+      Polygon polygonA(edgesA);
+      unsigned hits = 0;
+      bool same = true;
+
+      for (unsigned seed = 8; seed < 28; seed++) {
+        std::vector<Line> edgesB = makeObstacles(seed, 10);
+        Polygon polygonB(edgesB);
+        std::vector<Point> points;
+
+        for (const Line& edgeA : edgesA) {
+          for (const Line& edgeB : edgesB) {
+            Intersection intersection = edgeA.getIntersection(edgeB);
+            points.insert(points.end(), intersection.begin(), intersection.end());
+          }
+        }
+
+        if (!points.empty()) hits++;
+        same = same &&
+          isSame(polygonA.getIntersection(polygonB), points) &&
+          polygonA.intersects(polygonB) == !points.empty() &&
+          polygonB.intersects(polygonA) == !points.empty();
+      }
+
+      spec::expect(same, "expected the same intersections");
+      spec::expect(hits > 0 && hits < 20, "expected some of the polygons to intersect");
+    });
+
+    spec::it("has no intersections once empty", [] {
+      Polygon polygon(std::vector<Line>{});
+
+      spec::expect(!polygon.intersects(Line(0, 0, 10, 10)), "expected no intersection");
+      spec::expect(polygon.getIntersection(Line(0, 0, 10, 10)).empty(), "expected no points");
+    });
+  });
+}
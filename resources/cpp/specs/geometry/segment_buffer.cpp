@@ -0,0 +1,103 @@
+#include <cmath>
+#include <random>
+#include "../../src/nullable.h"
+#include "../../src/geometry/intersection.h"
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/segment_buffer.h"
+#include "../spec.h"
+
+// The reference path, testing the segments one by one
+template <typename T>
+static Nullable<geometry::SegmentHit> getScalarHit(const geometry::SegmentBuffer& buffer, const T& shape) {
+  for (unsigned i = 0; i < buffer.size(); i++) {
+    geometry::Intersection intersection = shape.getIntersection(buffer.getLine(i));
+    if (intersection.hasValue()) return Nullable<geometry::SegmentHit>({ i, intersection });
+  }
+
+  return Nullable<geometry::SegmentHit>();
+}
+
+static bool isSameHit(const Nullable<geometry::SegmentHit>& a, const Nullable<geometry::SegmentHit>& b) {
+  if (a.hasValue() != b.hasValue()) return false;
+  if (a.isNull()) return true;
+
+  geometry::SegmentHit hitA = a.getValue();
+  geometry::SegmentHit hitB = b.getValue();
+  if (hitA.index != hitB.index || hitA.intersection.size() != hitB.intersection.size()) return false;
+
+  for (unsigned i = 0; i < hitA.intersection.size(); i++) {
+    if (hitA.intersection.at(i).x != hitB.intersection.at(i).x) return false;
+    if (hitA.intersection.at(i).y != hitB.intersection.at(i).y) return false;
+  }
+
+  return true;
+}
+
+void describeSegmentBuffer() {
+  using namespace geometry;
+
+  spec::describe("geometry::SegmentBuffer", [] {
+    spec::it("returns the first segment hit", [] {
+      SegmentBuffer buffer;
+      buffer.append(Line(0, 0, 10, 0));
+      buffer.append(Line(5, -5, 5, 5));
+      buffer.append(Line(0, 2, 10, 2));
+
+      Nullable<SegmentHit> hit = buffer.getIntersection(Line(7, -1, 7, 3));
+      spec::expect(hit.hasValue(), "expected a hit");
+      spec::expect(hit.getValue().index == 0, "expected the first segment to be hit");
+      spec::expect(hit.getValue().intersection.at(0).x == 7, "expected the hit point");
+
+      spec::expect(buffer.getIntersection(Line(6, 3, 9, 3)).isNull(), "expected no hit");
+    });
+
+    spec::it("ignores popped segments", [] {
+      SegmentBuffer buffer;
+      buffer.append(Line(0, 0, 10, 0));
+      buffer.append(Line(0, 2, 10, 2));
+      buffer.pop();
+
+      spec::expect(buffer.getIntersection(Line(7, 1, 7, 3)).isNull(), "expected no hit");
+    });
+
+    spec::it("matches the scalar intersection methods", [] {
+      std::mt19937 random(7);
+      std::uniform_real_distribution<double> position(0, 400);
+      std::uniform_real_distribution<double> offset(-30, 30);
+      std::uniform_real_distribution<double> rad(-2 * M_PI, 2 * M_PI);
+      std::uniform_real_distribution<double> sweep(-2, 2);
+      unsigned mismatches = 0;
+      unsigned hits = 0;
+
+      for (unsigned round = 0; round < 200; round++) {
+        SegmentBuffer buffer;
+        unsigned count = round % 37;
+
+        for (unsigned i = 0; i < count; i++) {
+          double x = position(random);
+          double y = position(random);
+          buffer.append(Line(x, y, x + offset(random), y + offset(random)));
+        }
+
+        for (unsigned i = 0; i < 50; i++) {
+          double x = position(random);
+          double y = position(random);
+          double rad1 = rad(random);
+          Line line(x, y, x + offset(random), y + offset(random));
+          Circle arc(x, y, std::abs(offset(random)) + 1, rad1, rad1 + sweep(random));
+
+          Nullable<SegmentHit> lineHit = buffer.getIntersection(line);
+          Nullable<SegmentHit> arcHit = buffer.getIntersection(arc);
+
+          if (!isSameHit(lineHit, getScalarHit(buffer, line))) mismatches++;
+          if (!isSameHit(arcHit, getScalarHit(buffer, arc))) mismatches++;
+          hits += lineHit.hasValue() + arcHit.hasValue();
+        }
+      }
+
+      spec::expect(mismatches == 0, "expected no mismatches");
+      spec::expect(hits > 0, "expected some segments to be hit");
+    });
+  });
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include <stdexcept>
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/shape_pool.h"
+#include "../../src/game/match.h"
+#include "../spec.h"
+
+void describeShapePool() {
+  using namespace geometry;
+
+  spec::describe("geometry::ShapePool", [] {
+    spec::it("addresses shapes by handles", [] {
+      ShapePool pool;
+      ShapeHandle line = pool.allocate(Line(1, 2, 3, 4));
+      ShapeHandle circle = pool.allocate(Circle(1, 2, 3, 0, 1));
+
+      spec::expect(!pool.isCircle(line) && pool.isCircle(circle), "expected kinds to match");
+      spec::expect(pool.getLine(line)._x2 == 3, "expected line to match");
+      spec::expect(pool.getCircle(circle)._r == 3, "expected circle to match");
+      spec::expect(pool.size() == 2, "expected 2 shapes");
+    });
+
+    spec::it("reuses its storage once reset", [] {
+      ShapePool pool;
+      for (unsigned i = 0; i < 100; i++) pool.allocate(Line(0, 0, i, i));
+
+      unsigned growths = pool.getStats().growths;
+      pool.reset();
+      for (unsigned i = 0; i < 100; i++) pool.allocate(Line(0, 0, i, i));
+
+      ShapePoolStats stats = pool.getStats();
+      spec::expect(stats.growths == growths, "expected storage not to grow");
+      spec::expect(stats.allocations == 200, "expected 200 allocations");
+      spec::expect(stats.live == 100, "expected 100 live shapes");
+    });
+
+    spec::it("rejects handles which outlived a reset", [] {
+      ShapePool pool;
+      ShapeHandle handle = pool.allocate(Line(1, 2, 3, 4));
+      pool.reset();
+      pool.allocate(Line(5, 6, 7, 8));
+      bool thrown = false;
+
+      try {
+        pool.getLine(handle);
+      }
+      catch (const std::out_of_range&) {
+        thrown = true;
+      }
+
+      spec::expect(thrown, "expected stale handle to be rejected");
+    });
+  });
+
+  spec::describe("game::World reset", [] {
+    spec::it("recycles the memory of previous matches", [] {
+      game::Match match;
+      match.addDefaultSnakes();
+      match.run(game::RandomInput(1, 2), 60 * 60);
+
+      unsigned growths = match._world.getShapeStats().growths;
+
+      // A shorter match fits in the storage of the previous one
+      match.reset();
+      match.addDefaultSnakes();
+      match.run(game::RandomInput(1, 2), 60);
+
+      spec::expect(match._world.getShapeStats().growths == growths, "expected storage not to grow");
+      spec::expect(match._world._snakes.size() == 2, "expected 2 snakes");
+      spec::expect(match._tick == 60, "expected 60 ticks");
+    });
+  });
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include <cmath>
+#include "../../src/geometry/point.h"
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/arena.h"
+#include "../../src/geometry/sweep.h"
+#include "../../src/geometry/trail_index.h"
+#include "../spec.h"
+
+void describeSweep() {
+  using namespace geometry;
+
+  spec::describe("geometry::Sweep", [] {
+    spec::it("reports the segment which is met first rather than the one made first", [] {
+      TrailIndex trail;
+      trail.append(Line(30, 0, 30, 20));
+      trail.append(Line(20, 0, 20, 20));
+
+      Impact impact = { 1, -1, -1, 0 };
+      trail.sweep(Sweep(0, 10, 0, 100), impact, 3);
+
+      spec::expect(impact.owner == 3 && impact.segment == 1, "expected the nearer segment to be hit");
+      spec::expect(std::abs(impact.time - 0.2) < 1e-9, "expected the hit to be timed along the step");
+    });
+
+    spec::it("times impacts along a turn in both directions", [] {
+      // Both turns make a quarter of a circle before meeting a vertical line
+      TrailIndex right;
+      right.append(Line(10, 0, 10, 20));
+      TrailIndex left;
+      left.append(Line(10, -20, 10, 0));
+
+      Impact rightImpact = { 1, -1, -1, 0 };
+      right.sweep(Sweep(0, 0, 0, 100, 10, Turn::RIGHT), rightImpact, 0);
+      Impact leftImpact = { 1, -1, -1, 0 };
+      left.sweep(Sweep(0, 0, 0, 100, 10, Turn::LEFT), leftImpact, 0);
+
+      double expected = (5 * M_PI) / 100;
+      spec::expect(std::abs(rightImpact.time - expected) < 1e-9, "expected a right turn to hit a quarter through");
+      spec::expect(std::abs(leftImpact.time - expected) < 1e-9, "expected a left turn to hit a quarter through");
+    });
+
+    spec::it("finds points back by their time", [] {
+      Sweep sweep(5, 5, 1, 40, 10, Turn::LEFT);
+      Point point = sweep.getPoint(0.3);
+
+      spec::expect(sweep.getCircle().hasPoint(point.x, point.y), "expected the point to be on the path");
+      spec::expect(std::abs(sweep.getTime(point) - 0.3) < 1e-9, "expected the same time");
+    });
+
+    spec::it("ignores the segments connected to the head", [] {
+      TrailIndex trail;
+      trail.append(Line(50, -10, 50, 10));
+      trail.append(Line(0, 10, 10, 10));
+      trail.append(Line(10, 10, 10, 0));
+
+      Impact impact = { 1, -1, -1, 0 };
+      trail.sweep(Sweep(10, 0, -0.5 * M_PI, 50, 10, Turn::RIGHT), impact, 0, 2);
+      spec::expect(!impact.hasValue(), "expected no impact");
+
+      trail.sweep(Sweep(10, 0, 0, 100), impact, 0, 2);
+      spec::expect(impact.segment == 0 && std::abs(impact.time - 0.4) < 1e-9, "expected the first segment to be hit");
+    });
+
+    spec::it("reports the edges of an arena", [] {
+      Arena arena(100, 50);
+      Impact impact = { 1, -1, -1, 0 };
+      arena.sweep(Sweep(90, 10, 0, 20), impact);
+
+      spec::expect(impact.edges == Arena::RIGHT && impact.segment == -1, "expected the right edge to be hit");
+      spec::expect(std::abs(impact.time - 0.5) < 1e-9, "expected the edge to be hit halfway through");
+
+      Impact wrapped = { 1, -1, -1, 0 };
+      arena.sweep(Sweep(0, 10, 0, 20), wrapped);
+      spec::expect(!wrapped.hasValue(), "expected a head on the edge not to hit it again");
+    });
+
+    spec::it("prefers a segment which is met before an edge", [] {
+      Arena arena(100, 50);
+      TrailIndex trail;
+      trail.append(Line(95, 0, 95, 20));
+
+      Impact impact = { 1, -1, -1, 0 };
+      Sweep sweep(90, 10, 0, 20);
+      trail.sweep(sweep, impact, 1);
+      arena.sweep(sweep, impact);
+
+      spec::expect(impact.owner == 1 && impact.edges == 0, "expected the segment to be hit");
+      spec::expect(std::abs(impact.time - 0.25) < 1e-9, "expected the segment to be hit first");
+    });
+  });
+}
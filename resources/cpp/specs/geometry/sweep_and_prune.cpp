@@ -0,0 +1,91 @@
+#include <random>
+#include <vector>
+#include "../../src/geometry/box.h"
+#include "../../src/geometry/sweep_and_prune.h"
+#include "../spec.h"
+
+void describeSweepAndPrune() {
+  using namespace geometry;
+
+  spec::describe("geometry::SweepAndPrune", [] {
+    spec::it("pairs the same boxes as testing every query against every shape", [] {
+      std::mt19937 random(3);
+      std::uniform_real_distribution<double> position(0, 500);
+      std::uniform_real_distribution<double> size(0, 40);
+      std::uniform_real_distribution<double> offset(-15, 15);
+
+      auto makeBox = [&](double x, double y) {
+        return Box { x, y, x + size(random), y + size(random) };
+      };
+
+      SweepAndPrune broadPhase;
+      std::vector<Box> shapes;
+      std::vector<unsigned> proxies;
+      std::vector<Box> queries;
+      bool same = true;
+
+      for (unsigned i = 0; i < 200; i++) {
+        shapes.push_back(makeBox(position(random), position(random)));
+        proxies.push_back(broadPhase.addShape(shapes.back(), i % 4, i));
+      }
+
+      for (unsigned i = 0; i < 8; i++) {
+        queries.push_back(makeBox(position(random), position(random)));
+        broadPhase.setQuery(i, queries.back());
+      }
+
+      for (unsigned step = 0; step < 100; step++) {
+        // Queries and some of the shapes move a little, the way snakes do
+        for (unsigned i = 0; i < queries.size(); i++) {
+          queries[i] = makeBox(queries[i].minX + offset(random), queries[i].minY + offset(random));
+          broadPhase.setQuery(i, queries[i]);
+        }
+
+        for (unsigned i = step % 10; i < shapes.size(); i += 10) {
+          shapes[i] = makeBox(shapes[i].minX + offset(random), shapes[i].minY + offset(random));
+          broadPhase.updateShape(proxies[i], shapes[i]);
+        }
+
+        std::vector<BroadPhasePair> expected;
+        for (unsigned query = 0; query < queries.size(); query++) {
+          for (unsigned owner = 0; owner < 4; owner++) {
+            for (unsigned i = owner; i < shapes.size(); i += 4) {
+              if (shapes[i].overlaps(queries[query])) expected.push_back({ query, owner, i });
+            }
+          }
+        }
+
+        const std::vector<BroadPhasePair>& pairs = broadPhase.getPairs();
+        same = same && pairs.size() == expected.size();
+
+        for (unsigned i = 0; same && i < pairs.size(); i++) {
+          same = pairs[i].query == expected[i].query && pairs[i].owner == expected[i].owner &&
+            pairs[i].segment == expected[i].segment;
+        }
+      }
+
+      spec::expect(same, "expected pairs to match");
+    });
+
+    spec::it("drops the pairs of removed shapes and queries", [] {
+      SweepAndPrune broadPhase;
+      unsigned first = broadPhase.addShape({ 0, 0, 10, 10 }, 0, 0);
+      broadPhase.addShape({ 5, 5, 15, 15 }, 1, 0);
+      broadPhase.addShape({ 8, 0, 12, 4 }, 1, 1);
+      broadPhase.setQuery(0, { 9, 2, 11, 3 });
+      broadPhase.setQuery(1, { 9, 9, 11, 11 });
+
+      spec::expect(broadPhase.getPairs().size() == 4, "expected 4 pairs");
+
+      broadPhase.removeShape(first);
+      spec::expect(broadPhase.getPairs().size() == 2, "expected 2 pairs");
+
+      broadPhase.removeQuery(0);
+      spec::expect(broadPhase.getPairs().size() == 1, "expected a single pair");
+
+      broadPhase.removeOwner(1);
+      spec::expect(broadPhase.getPairs().empty(), "expected no pairs");
+      spec::expect(broadPhase.getShapesCount() == 0, "expected no shapes");
+    });
+  });
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <cmath>
+#include <random>
+#include "../../src/geometry/line.h"
+#include "../../src/geometry/circle.h"
+#include "../../src/geometry/trail_index.h"
+#include "../spec.h"
+
+// Casts a ray by testing it against every segment of the trail
+static double castRayThroughAll(const geometry::TrailIndex& trail, const geometry::Point& origin,
+    const geometry::Point& direction, double maxDistance) {
+  double nearest = maxDistance;
+
+  for (unsigned id = 0; id < trail.size(); id++) {
+    Nullable<double> distance = trail.isCircle(id) ?
+      trail.getCircle(id).getRayDistance(origin, direction) :
+      trail.getLine(id).getRayDistance(origin, direction);
+
+    if (distance.hasValue()) nearest = std::min(nearest, distance.getValue());
+  }
+
+  return nearest;
+}
+
+// Appends a trail made out of fragments: lines which are split into several pieces,
+// and arcs which are split the same way, both as a turning snake would grow them
+static void appendFragments(geometry::TrailIndex& trail) {
+  using namespace geometry;
+
+  double x = 100;
+  double y = 100;
+
+  for (unsigned i = 0; i < 20; i++) {
+    double x2 = x + 10;
+    double y2 = y + 5;
+    trail.append(Line(x, y, x2, y2));
+    x = x2;
+    y = y2;
+  }
+
+  for (unsigned i = 0; i < 20; i++) {
+    Circle arc(x, y, 50, 0, 0);
+    arc.setRad1(-0.1 * (i + 1));
+    arc.setRad2(-0.1 * i);
+    trail.append(arc);
+  }
+}
+
+void describeTrailIndex() {
+  using namespace geometry;
+
+  spec::describe("geometry::TrailIndex ray casts", [] {
+    spec::it("matches a ray cast against every segment", [] {
+      std::mt19937 random(7);
+      std::uniform_real_distribution<double> position(0, 500);
+      TrailIndex trail;
+      appendFragments(trail);
+
+      for (unsigned i = 0; i < 100; i++) {
+        trail.append(Line(position(random), position(random), position(random), position(random)));
+      }
+
+      Point directions[32];
+      RayHit hits[32];
+      bool same = true;
+
+      for (unsigned i = 0; i < 32; i++) {
+        directions[i] = { std::cos(i * M_PI / 16), std::sin(i * M_PI / 16) };
+      }
+
+      for (unsigned i = 0; i < 200; i++) {
+        Point origin = { position(random), position(random) };
+        for (RayHit& hit : hits) hit = { 150, -1, -1 };
+
+        trail.castRays(origin, directions, 32, hits, 3);
+
+        for (unsigned j = 0; j < 32; j++) {
+          double expected = castRayThroughAll(trail, origin, directions[j], 150);
+          same = same && hits[j].distance == expected &&
+            (hits[j].owner == 3) == (expected < 150);
+        }
+      }
+
+      spec::expect(same, "expected distances to match");
+    });
+
+    spec::it("ignores the skipped segments", [] {
+      TrailIndex trail;
+      trail.append(Line(20, -10, 20, 10));
+      trail.append(Line(10, -10, 10, 10));
+
+      Point direction = { 1, 0 };
+      RayHit hit = { 100, -1, -1 };
+      trail.castRays({ 0, 0 }, &direction, 1, &hit, 0, 1);
+
+      spec::expect(hit.distance == 20 && hit.segment == 0, "expected the first segment to be hit");
+    });
+
+    spec::it("keeps hits which are nearer than the trail", [] {
+      TrailIndex trail;
+      trail.append(Line(20, -10, 20, 10));
+
+      Point direction = { 1, 0 };
+      RayHit hit = { 15, 1, 4 };
+      trail.castRays({ 0, 0 }, &direction, 1, &hit, 0);
+
+      spec::expect(hit.distance == 15 && hit.owner == 1 && hit.segment == 4, "expected the hit to remain");
+    });
+  });
+}
\ No newline at end of file
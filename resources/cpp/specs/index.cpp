@@ -0,0 +1,48 @@
+#include "../src/core.cpp"
+#include "spec.cpp"
+#include "allocations.cpp"
+#include "utils.cpp"
+#include "stats.cpp"
+#include "geometry/box.cpp"
+#include "geometry/circle.cpp"
+#include "geometry/intersection.cpp"
+#include "geometry/fixed.cpp"
+#include "geometry/segment_buffer.cpp"
+#include "geometry/arena.cpp"
+#include "geometry/sweep.cpp"
+#include "geometry/shape_pool.cpp"
+#include "geometry/trail_index.cpp"
+#include "geometry/sweep_and_prune.cpp"
+#include "geometry/occupancy_grid.cpp"
+#include "geometry/polygon.cpp"
+#include "game/world.cpp"
+#include "game/match.cpp"
+#include "game/replay.cpp"
+#include "game/trail_canvas.cpp"
+#include "game/rollback.cpp"
+#include "game/simulation.cpp"
+
+int main() {
+  describeUtils();
+  describeStats();
+  describeBox();
+  describeCircle();
+  describeIntersection();
+  describeFixed();
+  describeSegmentBuffer();
+  describeArena();
+  describeSweep();
+  describeShapePool();
+  describeTrailIndex();
+  describeSweepAndPrune();
+  describeOccupancyGrid();
+  describePolygon();
+  describeWorld();
+  describeMatch();
+  describeReplay();
+  describeTrailCanvas();
+  describeRollback();
+  describeSimulation();
+
+  return spec::report();
+}
\ No newline at end of file
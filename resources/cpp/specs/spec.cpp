@@ -0,0 +1,50 @@
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include "spec.h"
+
+namespace spec {
+  namespace {
+    std::vector<std::string> descriptions;
+    std::vector<std::string> failures;
+    unsigned specsCount = 0;
+  }
+
+  void describe(const std::string& description, std::function<void()> block) {
+    descriptions.push_back(description);
+    block();
+    descriptions.pop_back();
+  }
+
+  void it(const std::string& description, std::function<void()> block) {
+    descriptions.push_back(description);
+    specsCount++;
+    block();
+    descriptions.pop_back();
+  }
+
+  // Registers a failure, along with the descriptions of the current spec, in case the
+  // given condition is false
+  void expect(bool condition, const std::string& message) {
+    if (condition) return;
+
+    std::string failure;
+
+    for (const std::string& description : descriptions) {
+      failure += description + " ";
+    }
+
+    failures.push_back(failure + "- " + message);
+  }
+
+  // Prints the results and returns the exit code of the runner
+  int report() {
+    for (const std::string& failure : failures) {
+      std::printf("FAILED: %s\n", failure.c_str());
+    }
+
+    std::printf("%u specs, %u failures\n", specsCount, (unsigned) failures.size());
+    return failures.empty() ? 0 : 1;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+// A minimal spec runner for the native code, modeled after the Jasmine specs of
+// the JavaScript code
+namespace spec {
+  void describe(const std::string& description, std::function<void()> block);
+
+  void it(const std::string& description, std::function<void()> block);
+
+  void expect(bool condition, const std::string& message);
+
+  int report();
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include <string>
+#include "../src/stats.h"
+#include "../src/geometry/line.h"
+#include "spec.h"
+
+void describeStats() {
+  spec::describe("stats", [] {
+    spec::it("counts until reset", [] {
+      stats::reset();
+      stats::count(stats::Counter::MATCHING_RAD_CALLS);
+      stats::count(stats::Counter::MATCHING_RAD_CALLS);
+
+      spec::expect(stats::getSnapshot().counters[(unsigned) stats::Counter::MATCHING_RAD_CALLS] == 2,
+        "expected 2 calls");
+
+      stats::reset();
+      spec::expect(stats::getSnapshot().counters[(unsigned) stats::Counter::MATCHING_RAD_CALLS] == 0,
+        "expected no calls");
+    });
+
+    spec::it("counts intersections only when enabled", [] {
+      stats::reset();
+      geometry::Line(0, 0, 10, 10).getIntersection(geometry::Line(0, 10, 10, 0));
+      geometry::Line(0, 0, 1, 1).getIntersection(geometry::Line(5, 5, 6, 7));
+
+      stats::Snapshot snapshot = stats::getSnapshot();
+      unsigned long long expected[] = { 2, 1, 1 };
+      bool counted = true;
+
+      for (unsigned i = 0; i < 3; i++) {
+        counted = counted && snapshot.counters[i] == (stats::isEnabled() ? expected[i] : 0);
+      }
+
+      spec::expect(counted, "expected the calls, rejects and hits of lines");
+    });
+
+    spec::it("dumps timed scopes as trace events", [] {
+      stats::reset();
+      stats::startTrace(2);
+
+      for (unsigned i = 0; i < 3; i++) stats::Scope scope(stats::Timer::WORLD_STEP);
+
+      stats::stopTrace();
+      { stats::Scope scope(stats::Timer::RAY_CAST); }
+
+      std::string json = stats::getTraceJson();
+      stats::Snapshot snapshot = stats::getSnapshot();
+      std::size_t first = json.find("\"name\":\"World::step\"");
+      std::size_t second = json.find("\"name\":\"World::step\"", first + 1);
+
+      spec::expect(json.find("{\"traceEvents\":[{") == 0, "expected a trace event list");
+      spec::expect(second != std::string::npos && json.find("\"name\":\"World::step\"", second + 1) == std::string::npos,
+        "expected events up to the capacity");
+      spec::expect(json.find("World::castRays") == std::string::npos, "expected no events once stopped");
+      spec::expect(snapshot.timerCalls[(unsigned) stats::Timer::WORLD_STEP] == 3 &&
+        snapshot.timerCalls[(unsigned) stats::Timer::RAY_CAST] == 1, "expected all the scopes to be timed");
+    });
+  });
+}
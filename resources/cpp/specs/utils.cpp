@@ -0,0 +1,59 @@
+#include <cmath>
+#include "../src/utils.h"
+#include "allocations.h"
+#include "spec.h"
+
+void describeUtils() {
+  using namespace utils;
+
+  spec::describe("utils::Chain", [] {
+    spec::it("yields the same results as the nested utility calls", [] {
+      double rad = 1.23456789123;
+
+      spec::expect(
+        chain(rad).trim<Round::ROUND, 9>().result() == trim<Round::ROUND, 9>(rad),
+        "expected the trimmed value to match"
+      );
+      spec::expect(
+        chain(-803.0).mod(800).result() == 797,
+        "expected the modulo to match"
+      );
+      spec::expect(
+        chain(rad).trim<Round::FLOOR>(2).isBetween(1, 1.23).result(),
+        "expected the trimmed value to be in range"
+      );
+      spec::expect(
+        !chain(rad).trim<Round::CEIL>(2).isBetween(1, 1.23).result(),
+        "expected the trimmed value to be out of range"
+      );
+      spec::expect(
+        chain(0.4).compare<Precision::PX, Op::EQ>(0.1).result(),
+        "expected values to be equal in pixel precision"
+      );
+    });
+
+    spec::it("can be evaluated at compile time", [] {
+      constexpr int value = chain(5).result();
+      spec::expect(value == 5, "expected the accumulated value");
+    });
+
+    spec::it("makes no heap allocations", [] {
+      unsigned long allocationsCount = spec::allocations::count();
+      bool result = chain(M_PI).trim<Round::ROUND, 9>().isBetween(0, 2 * M_PI).result();
+      allocationsCount = spec::allocations::count() - allocationsCount;
+
+      spec::expect(allocationsCount == 0, "expected no allocations");
+      spec::expect(result, "expected the value to be in range");
+    });
+  });
+
+  spec::describe("utils::trim", [] {
+    spec::it("trims whole digits given negative decimals", [] {
+      static_assert(pow10(-3) == 0.001, "expected a negative power");
+
+      spec::expect(trim<Round::ROUND>(1234.5, -2) == 1200, "expected hundreds");
+      spec::expect(trim<Round::CEIL>(1234.5, -1) == 1240, "expected tens");
+      spec::expect(trim<Round::FLOOR, -3>(1234.5) == 1000, "expected thousands");
+    });
+  });
+}
\ No newline at end of file
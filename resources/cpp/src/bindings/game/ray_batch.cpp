@@ -0,0 +1,24 @@
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../../game/world.h"
+#include "../../game/ray_batch.h"
+#include "ray_batch.h"
+
+namespace game {
+  // The view is invalidated once the memory of the module grows, so it should be
+  // fetched again rather than stored for long
+  emscripten::val EMRayBatch::getRaysView() {
+    return emscripten::val(emscripten::typed_memory_view(_rays.size(), _rays.data()));
+  }
+}
+
+EMSCRIPTEN_BINDINGS(game_ray_batch_module) {
+  emscripten::class_<game::RayBatch>("game_ray_batch_base")
+    .constructor<unsigned>()
+    .function("getCapacity", &game::RayBatch::getCapacity)
+    .function("cast", &game::RayBatch::cast);
+
+  emscripten::class_<game::EMRayBatch, emscripten::base<game::RayBatch>>("game_ray_batch")
+    .constructor<unsigned>()
+    .function("getRaysView", &game::EMRayBatch::getRaysView);
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <emscripten/val.h>
+#include "../../game/ray_batch.h"
+
+namespace game {
+  class EMRayBatch : public RayBatch {
+  public:
+    using RayBatch::RayBatch;
+
+    emscripten::val getRaysView();
+  };
+}
\ No newline at end of file
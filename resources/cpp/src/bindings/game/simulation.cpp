@@ -0,0 +1,50 @@
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../../geometry/shape_batch.h"
+#include "../../game/world.h"
+#include "../../game/trail_log.h"
+#include "../../game/simulation.h"
+#include "simulation.h"
+
+namespace game {
+  EMStepStatus EMSimulation::tick() {
+    return Simulation::tick();
+  }
+
+  // Acquires the most recently published state, see Simulation for its layout. The
+  // view is invalidated once the memory of the module grows, and its content once the
+  // next state is acquired
+  emscripten::val EMSimulation::getStateView() {
+    const double* state = acquireState();
+    return emscripten::val(emscripten::typed_memory_view(_states.size(), state));
+  }
+
+  // Returns a view of a block of logged segments, see TrailLog, or undefined if the
+  // trail hasn't reached it yet. Only segments which the acquired state counts may be read
+  emscripten::val EMSimulation::getBlockView(unsigned snakeIndex, unsigned blockIndex) {
+    const double* block = _logs.at(snakeIndex).getBlock(blockIndex);
+
+    if (!block) return emscripten::val::undefined();
+
+    unsigned size = TrailLog::BLOCK_SIZE * geometry::ShapeBatch::SHAPE_STRIDE;
+    return emscripten::val(emscripten::typed_memory_view(size, block));
+  }
+}
+
+EMSCRIPTEN_BINDINGS(game_simulation_module) {
+  emscripten::class_<game::Simulation>("game_simulation_base")
+    .constructor<double, double, double>()
+    .function("addSnake", &game::Simulation::addSnake)
+    .function("addDefaultSnakes", &game::Simulation::addDefaultSnakes)
+    .function("reset", &game::Simulation::reset)
+    .function("start", &game::Simulation::start)
+    .function("stop", &game::Simulation::stop)
+    .function("isRunning", &game::Simulation::isRunning)
+    .function("pushInput", &game::Simulation::pushInput);
+
+  emscripten::class_<game::EMSimulation, emscripten::base<game::Simulation>>("game_simulation")
+    .constructor<double, double, double>()
+    .function("tick", &game::EMSimulation::tick)
+    .function("getStateView", &game::EMSimulation::getStateView)
+    .function("getBlockView", &game::EMSimulation::getBlockView);
+}
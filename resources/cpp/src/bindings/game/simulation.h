@@ -0,0 +1,18 @@
+#pragma once
+
+#include <emscripten/val.h>
+#include "../../game/simulation.h"
+#include "world.h"
+
+namespace game {
+  class EMSimulation : public Simulation {
+  public:
+    using Simulation::Simulation;
+
+    EMStepStatus tick();
+
+    emscripten::val getStateView();
+
+    emscripten::val getBlockView(unsigned snakeIndex, unsigned blockIndex);
+  };
+}
@@ -0,0 +1,37 @@
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include <vector>
+#include "../../graphics/framebuffer.h"
+#include "../../game/world.h"
+#include "../../game/trail_canvas.h"
+#include "trail_canvas.h"
+
+namespace game {
+  // The view can be wrapped with an ImageData and put into the canvas as is. It's
+  // invalidated once the memory of the module grows, so it should be fetched again
+  // rather than stored for long
+  emscripten::val EMTrailCanvas::getPixelsView() {
+    std::vector<unsigned char>& pixels = _framebuffer._pixels;
+    return emscripten::val(emscripten::typed_memory_view(pixels.size(), pixels.data()));
+  }
+}
+
+EMSCRIPTEN_BINDINGS(game_trail_canvas_module) {
+  emscripten::value_object<graphics::Color>("graphics_color")
+    .field("r", &graphics::Color::r)
+    .field("g", &graphics::Color::g)
+    .field("b", &graphics::Color::b)
+    .field("a", &graphics::Color::a);
+
+  emscripten::class_<game::TrailCanvas>("game_trail_canvas_base")
+    .constructor<unsigned, unsigned, graphics::Color>()
+    .function("getWidth", &game::TrailCanvas::getWidth)
+    .function("getHeight", &game::TrailCanvas::getHeight)
+    .function("setColor", &game::TrailCanvas::setColor)
+    .function("clear", &game::TrailCanvas::clear)
+    .function("draw", &game::TrailCanvas::draw);
+
+  emscripten::class_<game::EMTrailCanvas, emscripten::base<game::TrailCanvas>>("game_trail_canvas")
+    .constructor<unsigned, unsigned, graphics::Color>()
+    .function("getPixelsView", &game::EMTrailCanvas::getPixelsView);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <emscripten/val.h>
+#include "../../game/trail_canvas.h"
+
+namespace game {
+  class EMTrailCanvas : public TrailCanvas {
+  public:
+    using TrailCanvas::TrailCanvas;
+
+    emscripten::val getPixelsView();
+  };
+}
@@ -0,0 +1,94 @@
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../../geometry/line.h"
+#include "../../geometry/circle.h"
+#include "../../geometry/sweep.h"
+#include "../../geometry/trail_index.h"
+#include "../../geometry/shape_pool.h"
+#include "../../game/world.h"
+#include "world.h"
+
+namespace game {
+  EMStepStatus::EMStepStatus(const StepStatus& status):
+    alive(status.alive),
+    eliminated(status.eliminated),
+    aliveCount(status.aliveCount) {
+  }
+
+  EMStepStatus EMWorld::step(double span, unsigned inputBits) {
+    return World::step(span, inputBits);
+  }
+
+  EMStepStatus EMWorld::advance(double elapsed, unsigned inputBits) {
+    return World::advance(elapsed, inputBits);
+  }
+
+  unsigned EMWorld::getShapesCount(unsigned snakeIndex) {
+    return _snakes.at(snakeIndex)._trail.size();
+  }
+
+  // Returns a plain representation of a snake's shape, good enough for drawing.
+  // Lines are represented with "x1", "y1", "x2", "y2" and circles are represented
+  // with "x", "y", "r", "rad1", "rad2"
+  emscripten::val EMWorld::getShape(unsigned snakeIndex, unsigned shapeIndex) {
+    const geometry::TrailIndex& trail = _snakes.at(snakeIndex)._trail;
+    emscripten::val emShape = emscripten::val::object();
+
+    if (trail.isCircle(shapeIndex)) {
+      const geometry::Circle& circle = trail.getCircle(shapeIndex);
+      emShape.set("x", emscripten::val(circle._x));
+      emShape.set("y", emscripten::val(circle._y));
+      emShape.set("r", emscripten::val(circle._r));
+      emShape.set("rad1", emscripten::val(circle._rad1));
+      emShape.set("rad2", emscripten::val(circle._rad2));
+    }
+    else {
+      const geometry::Line& line = trail.getLine(shapeIndex);
+      emShape.set("x1", emscripten::val(line._x1));
+      emShape.set("y1", emscripten::val(line._y1));
+      emShape.set("x2", emscripten::val(line._x2));
+      emShape.set("y2", emscripten::val(line._y2));
+    }
+
+    return emShape;
+  }
+}
+
+EMSCRIPTEN_BINDINGS(game_world_module) {
+  emscripten::value_object<game::EMStepStatus>("game_step_status")
+    .field("alive", &game::EMStepStatus::alive)
+    .field("eliminated", &game::EMStepStatus::eliminated)
+    .field("aliveCount", &game::EMStepStatus::aliveCount);
+
+  emscripten::value_object<geometry::ShapePoolStats>("geometry_shape_pool_stats")
+    .field("allocations", &geometry::ShapePoolStats::allocations)
+    .field("live", &geometry::ShapePoolStats::live)
+    .field("capacity", &geometry::ShapePoolStats::capacity)
+    .field("growths", &geometry::ShapePoolStats::growths)
+    .field("resets", &geometry::ShapePoolStats::resets);
+
+  emscripten::value_object<geometry::Impact>("geometry_impact")
+    .field("time", &geometry::Impact::time)
+    .field("owner", &geometry::Impact::owner)
+    .field("segment", &geometry::Impact::segment)
+    .field("edges", &geometry::Impact::edges);
+
+  emscripten::class_<game::World>("game_world_base")
+    .constructor<double, double>()
+    .property<double>("width", &game::World::_width)
+    .property<double>("height", &game::World::_height)
+    .function("addSnake", &game::World::addSnake)
+    .function("setInput", &game::World::setInput)
+    .function("setTicksPerStep", &game::World::setTicksPerStep)
+    .function("reset", &game::World::reset)
+    .function("getImpact",
+      emscripten::select_overload<geometry::Impact(unsigned, double, unsigned)>(&game::World::getImpact))
+    .function("getShapeStats", &game::World::getShapeStats);
+
+  emscripten::class_<game::EMWorld, emscripten::base<game::World>>("game_world")
+    .constructor<double, double>()
+    .function("step", &game::EMWorld::step)
+    .function("advance", &game::EMWorld::advance)
+    .function("getShapesCount", &game::EMWorld::getShapesCount)
+    .function("getShape", &game::EMWorld::getShape);
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <emscripten/val.h>
+#include "../../game/world.h"
+
+namespace game {
+  // The outcome of a step as JS sees it. Bitwise operators of JS work on 32 bits, so
+  // the bits cover the first 32 snakes, while the count covers all of them
+  struct EMStepStatus {
+    unsigned alive;
+    unsigned eliminated;
+    unsigned aliveCount;
+
+    EMStepStatus(const StepStatus& status);
+  };
+
+  class EMWorld : public World {
+  public:
+    using World::World;
+
+    EMStepStatus step(double span, unsigned inputBits);
+
+    EMStepStatus advance(double elapsed, unsigned inputBits);
+
+    unsigned getShapesCount(unsigned snakeIndex);
+
+    emscripten::val getShape(unsigned snakeIndex, unsigned shapeIndex);
+  };
+}
\ No newline at end of file
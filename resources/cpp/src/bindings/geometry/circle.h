@@ -0,0 +1,25 @@
+#pragma once
+
+#include <emscripten/val.h>
+#include "../../geometry/circle.h"
+
+namespace geometry {
+  class EMLine;
+
+  class EMCircle : public Circle {
+  public:
+    using Circle::Circle;
+
+    emscripten::val getMatchingX(double y);
+
+    emscripten::val getMatchingY(double x);
+
+    emscripten::val getMatchingPoint(double rad);
+
+    emscripten::val getMatchingRad(double x, double y);
+
+    emscripten::val getIntersection(EMLine line);
+
+    emscripten::val getIntersection(EMCircle circle);
+  };
+}
\ No newline at end of file
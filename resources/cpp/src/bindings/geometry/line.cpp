@@ -0,0 +1,67 @@
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../../nullable.h"
+#include "../../geometry/point.h"
+#include "../../geometry/intersection.h"
+#include "../../geometry/line.h"
+#include "line.h"
+#include "circle.h"
+
+namespace geometry {
+  emscripten::val EMLine::getMatchingX(double y) {
+    Nullable<double> nullableX = Line::getMatchingX(y);
+    return nullableX.hasValue() ?
+      emscripten::val(nullableX.getValue()) :
+      emscripten::val::undefined();
+  }
+
+  emscripten::val EMLine::getMatchingY(double x) {
+    Nullable<double> nullableY = Line::getMatchingY(x);
+    return nullableY.hasValue() ?
+      emscripten::val(nullableY.getValue()) :
+      emscripten::val::undefined();
+  }
+
+  emscripten::val EMLine::getIntersection(EMLine emLine) {
+    Line line = Line(emLine._x1, emLine._y1, emLine._x2, emLine._y2);
+    Intersection intersection = Line::getIntersection(line);
+
+    if (intersection.isNull()) return emscripten::val::undefined();
+
+    const Point& point = intersection.at(0);
+    emscripten::val emPoint = emscripten::val::object();
+    emPoint.set("x", emscripten::val(point.x));
+    emPoint.set("y", emscripten::val(point.y));
+    return emPoint;
+  }
+
+  emscripten::val EMLine::getIntersection(EMCircle emCircle) {
+    return emCircle.getIntersection(*this);
+  }
+}
+
+EMSCRIPTEN_BINDINGS(geometry_line_module) {
+  emscripten::class_<geometry::Line>("geometry_line_base")
+    .constructor<double, double, double, double>()
+    .property("x1", &geometry::Line::getX1, &geometry::Line::setX1)
+    .property("y1", &geometry::Line::getY1, &geometry::Line::setY1)
+    .property("x2", &geometry::Line::getX2, &geometry::Line::setX2)
+    .property("y2", &geometry::Line::getY2, &geometry::Line::setY2)
+    .function("hasPoint", &geometry::Line::hasPoint)
+    .function("boundsHavePoint", &geometry::Line::boundsHavePoint);
+
+  emscripten::class_<geometry::EMLine, emscripten::base<geometry::Line>>("geometry_line")
+    .constructor<double, double, double, double>()
+    .function("getX", &geometry::EMLine::getMatchingX)
+    .function("getY", &geometry::EMLine::getMatchingY)
+    .function("getLineIntersection",
+      emscripten::select_overload<emscripten::val(geometry::EMLine)>(
+        &geometry::EMLine::getIntersection
+      )
+    )
+    .function("getCircleIntersection",
+      emscripten::select_overload<emscripten::val(geometry::EMCircle)>(
+        &geometry::EMLine::getIntersection
+      )
+    );
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <emscripten/val.h>
+#include "../../geometry/line.h"
+
+namespace geometry {
+  class EMCircle;
+
+  class EMLine : public Line {
+  public:
+    using Line::Line;
+
+    emscripten::val getMatchingX(double y);
+
+    emscripten::val getMatchingY(double x);
+
+    emscripten::val getIntersection(EMLine line);
+
+    emscripten::val getIntersection(EMCircle circle);
+  };
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include <emscripten/val.h>
+#include "../../geometry/point.h"
+#include "points.h"
+
+namespace geometry {
+  // Converts the given points, e.g. an intersection or a vector of points, into an array
+  // of { x, y } objects. Returns undefined when there are no points at all
+  template<typename Points>
+  emscripten::val toEMPoints(const Points& points) {
+    if (!points.size()) return emscripten::val::undefined();
+
+    emscripten::val emPoints = emscripten::val::array();
+    unsigned i = 0;
+
+    for (const Point& point : points) {
+      emscripten::val emPoint = emscripten::val::object();
+      emPoint.set("x", emscripten::val(point.x));
+      emPoint.set("y", emscripten::val(point.y));
+      emPoints.set(i++, emPoint);
+    }
+
+    return emPoints;
+  }
+}
\ No newline at end of file
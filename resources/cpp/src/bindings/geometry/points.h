@@ -0,0 +1,8 @@
+#pragma once
+
+#include <emscripten/val.h>
+
+namespace geometry {
+  template<typename Points>
+  emscripten::val toEMPoints(const Points& points);
+}
\ No newline at end of file
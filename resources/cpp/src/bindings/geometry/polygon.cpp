@@ -0,0 +1,84 @@
+#include <vector>
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../../geometry/point.h"
+#include "../../geometry/line.h"
+#include "../../geometry/circle.h"
+#include "../../geometry/polygon.h"
+#include "line.h"
+#include "circle.h"
+#include "points.h"
+#include "polygon.h"
+
+namespace geometry {
+  // bounds - An array of arrays, where each sub-array holds the arguments of an edge's
+  // line, the same as the arguments of the JavaScript polygon
+  EMPolygon::EMPolygon(emscripten::val bounds): Polygon(getEdges(bounds)) {
+  }
+
+  std::vector<Line> EMPolygon::getEdges(emscripten::val bounds) {
+    std::vector<Line> edges;
+    unsigned length = bounds["length"].as<unsigned>();
+
+    for (unsigned i = 0; i < length; i++) {
+      emscripten::val coords = bounds[i];
+      edges.push_back(Line(
+        coords[0].as<double>(), coords[1].as<double>(),
+        coords[2].as<double>(), coords[3].as<double>()
+      ));
+    }
+
+    return edges;
+  }
+
+  emscripten::val EMPolygon::getIntersection(EMLine line) {
+    return toEMPoints(Polygon::getIntersection(static_cast<const Line&>(line)));
+  }
+
+  emscripten::val EMPolygon::getIntersection(EMCircle circle) {
+    return toEMPoints(Polygon::getIntersection(static_cast<const Circle&>(circle)));
+  }
+
+  emscripten::val EMPolygon::getIntersection(EMPolygon& polygon) {
+    return toEMPoints(Polygon::getIntersection(static_cast<const Polygon&>(polygon)));
+  }
+}
+
+EMSCRIPTEN_BINDINGS(geometry_polygon_module) {
+  emscripten::class_<geometry::Polygon>("geometry_polygon_base")
+    .function("size", &geometry::Polygon::size)
+    .function("hasPoint", &geometry::Polygon::hasPoint)
+    .function("intersectsLine",
+      emscripten::select_overload<bool(const geometry::Line&) const>(
+        &geometry::Polygon::intersects
+      )
+    )
+    .function("intersectsCircle",
+      emscripten::select_overload<bool(const geometry::Circle&) const>(
+        &geometry::Polygon::intersects
+      )
+    )
+    .function("intersectsPolygon",
+      emscripten::select_overload<bool(const geometry::Polygon&) const>(
+        &geometry::Polygon::intersects
+      )
+    );
+
+  emscripten::class_<geometry::EMPolygon, emscripten::base<geometry::Polygon>>("geometry_polygon")
+    .constructor<emscripten::val>()
+    .function("getLineIntersection",
+      emscripten::select_overload<emscripten::val(geometry::EMLine)>(
+        &geometry::EMPolygon::getIntersection
+      )
+    )
+    .function("getCircleIntersection",
+      emscripten::select_overload<emscripten::val(geometry::EMCircle)>(
+        &geometry::EMPolygon::getIntersection
+      )
+    )
+    .function("getPolygonIntersection",
+      emscripten::select_overload<emscripten::val(geometry::EMPolygon&)>(
+        &geometry::EMPolygon::getIntersection
+      )
+    );
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+#include <emscripten/val.h>
+#include "../../geometry/line.h"
+#include "../../geometry/polygon.h"
+#include "line.h"
+#include "circle.h"
+
+namespace geometry {
+  class EMPolygon : public Polygon {
+  public:
+    EMPolygon(emscripten::val bounds);
+
+    emscripten::val getIntersection(EMLine line);
+
+    emscripten::val getIntersection(EMCircle circle);
+
+    emscripten::val getIntersection(EMPolygon& polygon);
+
+  private:
+    static std::vector<Line> getEdges(emscripten::val bounds);
+  };
+}
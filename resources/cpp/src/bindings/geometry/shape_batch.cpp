@@ -0,0 +1,36 @@
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../../geometry/shape_batch.h"
+#include "shape_batch.h"
+
+namespace geometry {
+  // The following views are invalidated once the memory of the module grows, so they
+  // should be fetched again rather than stored for long
+  emscripten::val EMShapeBatch::getShapesView() {
+    return emscripten::val(emscripten::typed_memory_view(_shapes.size(), _shapes.data()));
+  }
+
+  emscripten::val EMShapeBatch::getQueryView() {
+    return emscripten::val(emscripten::typed_memory_view(_query.size(), _query.data()));
+  }
+
+  emscripten::val EMShapeBatch::getPointsView() {
+    return emscripten::val(emscripten::typed_memory_view(_points.size(), _points.data()));
+  }
+}
+
+EMSCRIPTEN_BINDINGS(geometry_shape_batch_module) {
+  emscripten::class_<geometry::ShapeBatch>("geometry_shape_batch_base")
+    .constructor<unsigned, unsigned>()
+    .function("getShapesCapacity", &geometry::ShapeBatch::getShapesCapacity)
+    .function("getPointsCapacity", &geometry::ShapeBatch::getPointsCapacity)
+    .function("intersectQuery", &geometry::ShapeBatch::intersectQuery)
+    .function("intersectPairs", &geometry::ShapeBatch::intersectPairs);
+
+  emscripten::class_<geometry::EMShapeBatch, emscripten::base<geometry::ShapeBatch>>("geometry_shape_batch")
+    .constructor<unsigned, unsigned>()
+    .class_property("SHAPE_STRIDE", &geometry::ShapeBatch::SHAPE_STRIDE)
+    .function("getShapesView", &geometry::EMShapeBatch::getShapesView)
+    .function("getQueryView", &geometry::EMShapeBatch::getQueryView)
+    .function("getPointsView", &geometry::EMShapeBatch::getPointsView);
+}
\ No newline at end of file
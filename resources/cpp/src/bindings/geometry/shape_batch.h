@@ -0,0 +1,17 @@
+#pragma once
+
+#include <emscripten/val.h>
+#include "../../geometry/shape_batch.h"
+
+namespace geometry {
+  class EMShapeBatch : public ShapeBatch {
+  public:
+    using ShapeBatch::ShapeBatch;
+
+    emscripten::val getShapesView();
+
+    emscripten::val getQueryView();
+
+    emscripten::val getPointsView();
+  };
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../../geometry/point.h"
+#include "../../geometry/intersection.h"
+#include "../../geometry/line.h"
+#include "../../geometry/circle.h"
+#include "../../geometry/trail_index.h"
+#include "line.h"
+#include "circle.h"
+#include "points.h"
+#include "trail_index.h"
+
+namespace geometry {
+  void EMTrailIndex::appendLine(EMLine line) {
+    TrailIndex::append(line);
+  }
+
+  void EMTrailIndex::appendCircle(EMCircle circle) {
+    TrailIndex::append(circle);
+  }
+
+  void EMTrailIndex::updateLastLine(EMLine line) {
+    TrailIndex::updateLast(line);
+  }
+
+  void EMTrailIndex::updateLastCircle(EMCircle circle) {
+    TrailIndex::updateLast(circle);
+  }
+
+  emscripten::val EMTrailIndex::getIntersection(EMLine emLine, unsigned skip) {
+    Line line = Line(emLine._x1, emLine._y1, emLine._x2, emLine._y2);
+    return toEMPoints(TrailIndex::getIntersection(line, skip));
+  }
+
+  emscripten::val EMTrailIndex::getIntersection(EMCircle emCircle, unsigned skip) {
+    Circle circle = Circle(
+      emCircle._x, emCircle._y, emCircle._r, emCircle._rad1, emCircle._rad2
+    );
+    return toEMPoints(TrailIndex::getIntersection(circle, skip));
+  }
+}
+
+EMSCRIPTEN_BINDINGS(geometry_trail_index_module) {
+  emscripten::class_<geometry::TrailIndex>("geometry_trail_index_base")
+    .constructor<>()
+    .constructor<double>()
+    .function("size", &geometry::TrailIndex::size)
+    .function("pop", &geometry::TrailIndex::pop);
+
+  emscripten::class_<geometry::EMTrailIndex, emscripten::base<geometry::TrailIndex>>("geometry_trail_index")
+    .constructor<>()
+    .constructor<double>()
+    .function("appendLine", &geometry::EMTrailIndex::appendLine)
+    .function("appendCircle", &geometry::EMTrailIndex::appendCircle)
+    .function("updateLastLine", &geometry::EMTrailIndex::updateLastLine)
+    .function("updateLastCircle", &geometry::EMTrailIndex::updateLastCircle)
+    .function("getLineIntersection",
+      emscripten::select_overload<emscripten::val(geometry::EMLine, unsigned)>(
+        &geometry::EMTrailIndex::getIntersection
+      )
+    )
+    .function("getCircleIntersection",
+      emscripten::select_overload<emscripten::val(geometry::EMCircle, unsigned)>(
+        &geometry::EMTrailIndex::getIntersection
+      )
+    );
+}
\ No newline at end of file
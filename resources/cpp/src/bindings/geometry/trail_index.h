@@ -0,0 +1,25 @@
+#pragma once
+
+#include <emscripten/val.h>
+#include "../../geometry/trail_index.h"
+#include "line.h"
+#include "circle.h"
+
+namespace geometry {
+  class EMTrailIndex : public TrailIndex {
+  public:
+    using TrailIndex::TrailIndex;
+
+    void appendLine(EMLine line);
+
+    void appendCircle(EMCircle circle);
+
+    void updateLastLine(EMLine line);
+
+    void updateLastCircle(EMCircle circle);
+
+    emscripten::val getIntersection(EMLine line, unsigned skip);
+
+    emscripten::val getIntersection(EMCircle circle, unsigned skip);
+  };
+}
\ No newline at end of file
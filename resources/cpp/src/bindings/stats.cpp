@@ -0,0 +1,61 @@
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "../stats.h"
+
+namespace stats {
+  // Returns the counters by their names, along with the calls and total microseconds
+  // of each timer, e.g. { lineLineCalls, ..., timers: { "World::step": { calls, total } } }
+  emscripten::val getEMSnapshot() {
+    Snapshot snapshot = getSnapshot();
+    emscripten::val emSnapshot = emscripten::val::object();
+    emscripten::val emTimers = emscripten::val::object();
+
+    for (unsigned i = 0; i < COUNTERS_COUNT; i++) {
+      emSnapshot.set(getCounterName((Counter) i), emscripten::val((double) snapshot.counters[i]));
+    }
+
+    for (unsigned i = 0; i < TIMERS_COUNT; i++) {
+      emscripten::val emTimer = emscripten::val::object();
+      emTimer.set("calls", emscripten::val((double) snapshot.timerCalls[i]));
+      emTimer.set("total", emscripten::val(snapshot.timerTotals[i]));
+      emTimers.set(getTimerName((Timer) i), emTimer);
+    }
+
+    emSnapshot.set("timers", emTimers);
+
+    return emSnapshot;
+  }
+}
+
+#ifdef CORE_STATS
+// Counts the heap allocations of the whole module
+void* operator new(std::size_t size) {
+  STATS_COUNT(ALLOCATIONS);
+  void* pointer = std::malloc(size ? size : 1);
+  if (!pointer) throw std::bad_alloc();
+  return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+// Compilers may call the sized form instead, which would otherwise reach the default
+// deallocator with memory that came from the malloc above
+void operator delete(void* pointer, std::size_t) noexcept {
+  operator delete(pointer);
+}
+#endif
+
+EMSCRIPTEN_BINDINGS(stats_module) {
+  emscripten::function("stats_isEnabled", &stats::isEnabled);
+  emscripten::function("stats_snapshot", &stats::getEMSnapshot);
+  emscripten::function("stats_reset", &stats::reset);
+  emscripten::function("stats_startTrace", &stats::startTrace);
+  emscripten::function("stats_stopTrace", &stats::stopTrace);
+  emscripten::function("stats_getTrace", &stats::getTraceJson);
+}
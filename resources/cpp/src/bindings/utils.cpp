@@ -0,0 +1,22 @@
+#include <string>
+#include <emscripten/bind.h>
+#include "../utils.h"
+
+EMSCRIPTEN_BINDINGS(utils_module) {
+  emscripten::function("utils_mod", &utils::mod);
+  emscripten::function("utils_trim",
+    emscripten::select_overload<double(double, int, const std::string)>(
+      &utils::trim
+    )
+  );
+  emscripten::function("utils_isBetween",
+    emscripten::select_overload<bool(double, double, double, const std::string)>(
+      &utils::isBetween
+    )
+  );
+  emscripten::function("utils_compare",
+    emscripten::select_overload<bool(double, double, const std::string, const std::string)>(
+      &utils::compare
+    )
+  );
+}
\ No newline at end of file
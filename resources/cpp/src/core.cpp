@@ -0,0 +1,43 @@
+#include "nullable.cpp"
+#include "utils.cpp"
+#include "stats.cpp"
+#include "geometry/intersection.cpp"
+#include "geometry/line.cpp"
+#include "geometry/circle.cpp"
+#include "geometry/fixed_line.cpp"
+#include "geometry/fixed_circle.cpp"
+#include "geometry/shape_list.cpp"
+#include "geometry/sweep.cpp"
+#include "geometry/arena.cpp"
+#include "geometry/shape_pool.cpp"
+#include "geometry/trail_index.cpp"
+#include "geometry/shape_batch.cpp"
+#include "geometry/segment_buffer.cpp"
+#include "geometry/sweep_and_prune.cpp"
+#include "geometry/occupancy_grid.cpp"
+#include "geometry/polygon.cpp"
+#include "graphics/framebuffer.cpp"
+#include "game/snake.cpp"
+#include "game/world.cpp"
+#include "game/ray_batch.cpp"
+#include "game/trail_canvas.cpp"
+#include "game/input_queue.cpp"
+#include "game/state_buffer.cpp"
+#include "game/trail_log.cpp"
+#include "game/match.cpp"
+#include "game/replay.cpp"
+#include "game/rollback.cpp"
+#include "game/simulation.cpp"
+
+// Templates are defined alongside the rest of the sources, so the ones which are a part
+// of the public interface are instantiated explicitly for code which links against the
+// core library rather than including it
+template class Nullable<double>;
+template class Nullable<geometry::Point>;
+template class Nullable<geometry::SegmentHit>;
+template class geometry::ShapeList<geometry::DoubleBackend>;
+template class geometry::ShapeList<geometry::FixedBackend>;
+template geometry::Intersection geometry::ShapeList<geometry::DoubleBackend>::getIntersection(const geometry::Line&) const;
+template geometry::Intersection geometry::ShapeList<geometry::DoubleBackend>::getIntersection(const geometry::Circle&) const;
+template geometry::Intersection geometry::ShapeList<geometry::FixedBackend>::getIntersection(const geometry::FixedLine&) const;
+template geometry::Intersection geometry::ShapeList<geometry::FixedBackend>::getIntersection(const geometry::FixedCircle&) const;
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include <atomic>
+#include <vector>
+#include "input_queue.h"
+
+namespace game {
+  // capacity - The most input bits which can be queued at once, rounded up to a power
+  // of 2 so positions can simply wrap around
+  InputQueue::InputQueue(unsigned capacity):
+    _head(0),
+    _tail(0) {
+    unsigned size = 1;
+    while (size < capacity) size *= 2;
+
+    _slots.resize(size, 0);
+    _mask = size - 1;
+  }
+
+  unsigned InputQueue::getCapacity() const {
+    return _slots.size();
+  }
+
+  // Queues the given input bits, unless the queue is full. Meant to be called by the
+  // producing thread only
+  bool InputQueue::push(unsigned inputBits) {
+    unsigned tail = _tail.load(std::memory_order_relaxed);
+    unsigned head = _head.load(std::memory_order_acquire);
+
+    if (tail - head == _slots.size()) return false;
+
+    _slots[tail & _mask] = inputBits;
+    _tail.store(tail + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  // Takes the oldest queued input bits, unless the queue is empty. Meant to be called
+  // by the consuming thread only
+  bool InputQueue::pop(unsigned& inputBits) {
+    unsigned head = _head.load(std::memory_order_relaxed);
+    unsigned tail = _tail.load(std::memory_order_acquire);
+
+    if (head == tail) return false;
+
+    inputBits = _slots[head & _mask];
+    _head.store(head + 1, std::memory_order_release);
+
+    return true;
+  }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace game {
+  // A bounded queue of input bits, see World for their layout, which is pushed to by a
+  // single thread and popped from by another one without any locks. Each side only
+  // writes its own position, and publishes it once the slot it refers to is ready
+  class InputQueue {
+  public:
+    InputQueue(unsigned capacity);
+
+    unsigned getCapacity() const;
+
+    bool push(unsigned inputBits);
+
+    bool pop(unsigned& inputBits);
+
+  private:
+    std::vector<unsigned> _slots;
+    unsigned _mask;
+    // The position of the next slot to pop, only written by the consumer
+    std::atomic<unsigned> _head;
+    // Keeps both positions on separate cache lines, so the threads won't keep
+    // invalidating each other's line with every push and pop
+    char _padding[64];
+    // The position of the next slot to push, only written by the producer
+    std::atomic<unsigned> _tail;
+  };
+}
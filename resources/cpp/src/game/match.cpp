@@ -0,0 +1,132 @@
+#include <cmath>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "world.h"
+#include "match.h"
+
+namespace game {
+  constexpr double Match::WIDTH;
+  constexpr double Match::HEIGHT;
+  constexpr double Match::SPAN;
+
+  // span - The time each tick takes, in milliseconds
+  Match::Match(double width, double height, double span):
+    _world(width, height),
+    _span(span),
+    _tick(0) {
+  }
+
+  // Adds the red and blue snakes of the play screen
+  void Match::addDefaultSnakes() {
+    double width = _world._width;
+    double height = _world._height;
+
+    _world.addSnake(width / 4, height / 4, 50, M_PI / 4, 100);
+    _world.addSnake((width / 4) * 3, (height / 4) * 3, 50, (-M_PI / 4) * 3, 100);
+  }
+
+  // Clears the match so it can be played again, reusing the memory of its snakes
+  void Match::reset() {
+    _world.reset();
+    _tick = 0;
+  }
+
+  StepStatus Match::step(unsigned inputBits) {
+    _tick++;
+    return _world.step(_span, inputBits);
+  }
+
+  // Whether there's at most a single snake left standing
+  bool Match::isFinished() const {
+    unsigned aliveCount = 0;
+
+    for (unsigned i = 0; i < _world._snakes.size(); i++) {
+      if (_world._alive & (1ull << i)) aliveCount++;
+    }
+
+    return aliveCount <= 1;
+  }
+
+  MatchResult Match::getResult() const {
+    bool finished = isFinished();
+    int winner = -1;
+
+    for (unsigned i = 0; finished && i < _world._snakes.size(); i++) {
+      if (_world._alive & (1ull << i)) winner = i;
+    }
+
+    return { winner, _world._alive, _tick, finished };
+  }
+
+  // Steps the match until it's finished or until the given amount of ticks has passed
+  MatchResult Match::run(const MatchInput& input, unsigned maxTicks) {
+    while (!isFinished() && _tick < maxTicks) step(input(_tick));
+
+    return getResult();
+  }
+
+  // Saves the state of the match into the given snapshot, reusing its memory
+  void Match::save(MatchSnapshot& snapshot) const {
+    snapshot.tick = _tick;
+    _world.save(snapshot.world);
+  }
+
+  // Puts the match back into a state it was saved in, see World::restore()
+  void Match::restore(const MatchSnapshot& snapshot) {
+    _tick = snapshot.tick;
+    _world.restore(snapshot.world);
+  }
+
+  // minStretch - The minimal amount of ticks an input is held for
+  // maxStretch - The maximal amount of ticks an input is held for
+  RandomInput::RandomInput(unsigned seed, unsigned snakesCount, unsigned minStretch,
+      unsigned maxStretch):
+    _random(seed),
+    _minStretch(minStretch),
+    _maxStretch(maxStretch),
+    _inputs(snakesCount, 0),
+    _stretches(snakesCount, 0),
+    _tick(0),
+    _inputBits(0) {
+    if (snakesCount > World::MAX_PACKED_SNAKES)
+      throw std::invalid_argument("RandomInput: input bits cover up to 16 snakes");
+  }
+
+  // Returns the input bits of the given tick. Skipped ticks are drawn as well, and the
+  // last drawn tick may be asked for again
+  unsigned RandomInput::operator()(unsigned tick) {
+    if (tick + 1 < _tick) throw std::invalid_argument("RandomInput: tick was already passed");
+
+    while (_tick <= tick) draw();
+
+    return _inputBits;
+  }
+
+  void RandomInput::draw() {
+    _inputBits = 0;
+
+    for (unsigned i = 0; i < _inputs.size(); i++) {
+      if (!_stretches[i]) {
+        // Nothing, left or right
+        _inputs[i] = _random() % 3;
+        _stretches[i] = _minStretch + _random() % (_maxStretch - _minStretch + 1);
+      }
+
+      _stretches[i]--;
+      _inputBits |= _inputs[i] << (i * 2);
+    }
+
+    _tick++;
+  }
+
+  ScriptedInput::ScriptedInput(const std::vector<unsigned>& inputs): _inputs(inputs) {
+  }
+
+  unsigned ScriptedInput::operator()(unsigned tick) {
+    if (_inputs.empty()) return 0;
+    if (tick >= _inputs.size()) return _inputs.back();
+    return _inputs.at(tick);
+  }
+}
\ No newline at end of file
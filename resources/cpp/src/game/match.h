@@ -0,0 +1,99 @@
+#pragma once
+
+#include <functional>
+#include <random>
+#include <vector>
+#include "world.h"
+
+namespace game {
+  // The outcome of a whole match
+  struct MatchResult {
+    // The index of the last snake standing, or -1 for a tie or an unfinished match
+    int winner;
+    // A bit for each snake which was still in the game once the match was over
+    unsigned long long alive;
+    unsigned ticks;
+    // Whether the match ended with at most a single snake standing, rather than by
+    // running out of ticks
+    bool finished;
+  };
+
+  // The state of a match as it was at some point, see Match::save()
+  struct MatchSnapshot {
+    unsigned tick;
+    WorldSnapshot world;
+  };
+
+  // Provides the input bits for the given tick, see World::setInputBits() for their layout
+  typedef std::function<unsigned(unsigned tick)> MatchInput;
+
+  // A headless match which follows the rules of the play screen: snakes are added the
+  // same way, and the world is stepped until there's only one snake left standing, or
+  // none in case of a tie. Steps are made with a fixed span, so a match is fully
+  // determined by its input, down to the last bit
+  class Match {
+  public:
+    static constexpr double WIDTH = 1280;
+    static constexpr double HEIGHT = 720;
+    static constexpr double SPAN = World::TICK;
+
+    World _world;
+    double _span;
+    unsigned _tick;
+
+    Match(double width = WIDTH, double height = HEIGHT, double span = SPAN);
+
+    void addDefaultSnakes();
+
+    void reset();
+
+    StepStatus step(unsigned inputBits);
+
+    bool isFinished() const;
+
+    MatchResult getResult() const;
+
+    MatchResult run(const MatchInput& input, unsigned maxTicks);
+
+    void save(MatchSnapshot& snapshot) const;
+
+    void restore(const MatchSnapshot& snapshot);
+  };
+
+  // Input of a player who holds left, right or nothing for random stretches of time.
+  // Decisions are taken straight out of the generator's output, since distributions
+  // aren't guaranteed to produce the same numbers across standard libraries. Ticks are
+  // drawn in order, so the input of a tick doesn't depend on which ticks were asked for
+  // before it, and ticks which were already passed can't be asked for again
+  class RandomInput {
+  public:
+    RandomInput(unsigned seed, unsigned snakesCount, unsigned minStretch = 5,
+      unsigned maxStretch = 60);
+
+    unsigned operator()(unsigned tick);
+
+  private:
+    std::mt19937 _random;
+    unsigned _minStretch;
+    unsigned _maxStretch;
+    std::vector<unsigned> _inputs;
+    std::vector<unsigned> _stretches;
+    // The next tick to be drawn, and the input bits of the one before it
+    unsigned _tick;
+    unsigned _inputBits;
+
+    void draw();
+  };
+
+  // Input which is played back from a list of input bits, one for each tick. Once the
+  // list is exhausted its last input bits are held
+  class ScriptedInput {
+  public:
+    ScriptedInput(const std::vector<unsigned>& inputs);
+
+    unsigned operator()(unsigned tick);
+
+  private:
+    std::vector<unsigned> _inputs;
+  };
+}
\ No newline at end of file
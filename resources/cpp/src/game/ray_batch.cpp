@@ -0,0 +1,43 @@
+#include <algorithm>
+#include <vector>
+#include "../geometry/trail_index.h"
+#include "world.h"
+#include "ray_batch.h"
+
+namespace game {
+  // capacity - The maximum number of rays a single cast can be made of
+  RayBatch::RayBatch(unsigned capacity):
+    _rays(capacity * RAY_STRIDE),
+    _angles(capacity),
+    _hits(capacity) {
+  }
+
+  unsigned RayBatch::getCapacity() const {
+    return _rays.size() / RAY_STRIDE;
+  }
+
+  // Casts the first "count" rays of the batch from the given point into the given world,
+  // see World::castRays. Returns the number of rays which have hit anything
+  unsigned RayBatch::cast(World& world, double x, double y, unsigned count,
+      double maxDistance, int skipSnake) {
+    count = std::min(count, getCapacity());
+
+    for (unsigned i = 0; i < count; i++) {
+      _angles[i] = _rays[i * RAY_STRIDE];
+    }
+
+    world.castRays(x, y, _angles.data(), count, maxDistance, _hits.data(), skipSnake);
+
+    unsigned hitsCount = 0;
+
+    for (unsigned i = 0; i < count; i++) {
+      const geometry::RayHit& hit = _hits[i];
+      _rays[(i * RAY_STRIDE) + 1] = hit.distance;
+      _rays[(i * RAY_STRIDE) + 2] = hit.owner;
+      _rays[(i * RAY_STRIDE) + 3] = hit.segment;
+      if (hit.owner != -1) hitsCount++;
+    }
+
+    return hitsCount;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+#include "../geometry/trail_index.h"
+#include "world.h"
+
+namespace game {
+  // A batch of rays which lives in linear memory, so bots can fill in the angles they
+  // look at and read what they see through typed array views without creating any
+  // objects. Each ray record is made out of 4 numbers:
+  // angle, distance, snake index (-1 for none), segment index (-1 for none)
+  class RayBatch {
+  public:
+    static const unsigned RAY_STRIDE = 4;
+
+    std::vector<double> _rays;
+
+    RayBatch(unsigned capacity);
+
+    unsigned getCapacity() const;
+
+    unsigned cast(World& world, double x, double y, unsigned count, double maxDistance,
+      int skipSnake);
+
+  private:
+    std::vector<double> _angles;
+    std::vector<geometry::RayHit> _hits;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,469 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include "../geometry/line.h"
+#include "../geometry/circle.h"
+#include "../geometry/trail_index.h"
+#include "snake.h"
+#include "match.h"
+#include "replay.h"
+
+namespace game {
+  namespace {
+    const unsigned char MAGIC[] = { 'S', 'N', 'K', 'R' };
+    // Bumped whenever the same inputs would play out differently, e.g. once snakes
+    // which hit each other during the same step were disqualified together
+    const unsigned VERSION = 2;
+    const std::size_t HEADER_SIZE = 56;
+    const std::size_t SETUP_SIZE = 5 * 8;
+    // The next change of a cursor which has reached the end of the inputs
+    const unsigned NO_CHANGE = 0xffffffff;
+
+    void writeU8(std::vector<unsigned char>& bytes, unsigned value) {
+      bytes.push_back(value & 0xff);
+    }
+
+    void writeU32(std::vector<unsigned char>& bytes, std::uint32_t value) {
+      for (unsigned i = 0; i < 4; i++) bytes.push_back((value >> (i * 8)) & 0xff);
+    }
+
+    void writeF64(std::vector<unsigned char>& bytes, double value) {
+      std::uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      for (unsigned i = 0; i < 8; i++) bytes.push_back((bits >> (i * 8)) & 0xff);
+    }
+
+    // 7 bits at a time, where the high bit marks that more bytes follow
+    void writeVarint(std::vector<unsigned char>& bytes, std::uint32_t value) {
+      while (value >= 0x80) {
+        bytes.push_back((value & 0x7f) | 0x80);
+        value >>= 7;
+      }
+
+      bytes.push_back(value);
+    }
+
+    // Reads values out of a range of bytes, and fails rather than reading past it
+    struct ByteCursor {
+      const unsigned char* data;
+      std::size_t size;
+      std::size_t offset;
+
+      void require(std::size_t count) {
+        if (count > size || offset > size - count)
+          throw std::invalid_argument("ReplayReader: unexpected end of replay");
+      }
+
+      unsigned readU8() {
+        require(1);
+        return data[offset++];
+      }
+
+      std::uint32_t readU32() {
+        require(4);
+        std::uint32_t value = 0;
+        for (unsigned i = 0; i < 4; i++) value |= (std::uint32_t) data[offset++] << (i * 8);
+        return value;
+      }
+
+      double readF64() {
+        require(8);
+        std::uint64_t bits = 0;
+        for (unsigned i = 0; i < 8; i++) bits |= (std::uint64_t) data[offset++] << (i * 8);
+
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+      }
+
+      std::uint32_t readVarint() {
+        std::uint32_t value = 0;
+
+        for (unsigned shift = 0; shift < 32; shift += 7) {
+          unsigned byte = readU8();
+          value |= (std::uint32_t) (byte & 0x7f) << shift;
+          if (!(byte & 0x80)) return value;
+        }
+
+        throw std::invalid_argument("ReplayReader: malformed varint");
+      }
+    };
+
+    void writeLine(std::vector<unsigned char>& bytes, const geometry::Line& line) {
+      writeF64(bytes, line._x1);
+      writeF64(bytes, line._y1);
+      writeF64(bytes, line._x2);
+      writeF64(bytes, line._y2);
+    }
+
+    void writeCircle(std::vector<unsigned char>& bytes, const geometry::Circle& circle) {
+      writeF64(bytes, circle._x);
+      writeF64(bytes, circle._y);
+      writeF64(bytes, circle._r);
+      writeF64(bytes, circle._rad1);
+      writeF64(bytes, circle._rad2);
+    }
+
+    // Shapes are restored through their setters, since constructors trim the given
+    // values while shapes which keep growing hold untrimmed ones
+    geometry::Line readLine(ByteCursor& cursor) {
+      geometry::Line line(0, 0, 0, 0);
+      line.setX1(cursor.readF64());
+      line.setY1(cursor.readF64());
+      line.setX2(cursor.readF64());
+      line.setY2(cursor.readF64());
+      return line;
+    }
+
+    geometry::Circle readCircle(ByteCursor& cursor) {
+      geometry::Circle circle(0, 0, 0, 0, 0);
+      circle.setX(cursor.readF64());
+      circle.setY(cursor.readF64());
+      circle.setR(cursor.readF64());
+      circle.setRad1(cursor.readF64());
+      circle.setRad2(cursor.readF64());
+      return circle;
+    }
+
+    // Writes the whole state of a snake, along with the shapes of its trail starting
+    // from the given index
+    void writeSnake(std::vector<unsigned char>& bytes, const Snake& snake, unsigned from) {
+      writeF64(bytes, snake._x);
+      writeF64(bytes, snake._y);
+      writeF64(bytes, snake._r);
+      writeF64(bytes, snake._rad);
+      writeF64(bytes, snake._v);
+      writeU8(bytes, (unsigned) snake._direction);
+      writeU8(bytes, snake._currentIsCircle);
+      writeU8(bytes, snake._lastBitIsCircle);
+      writeLine(bytes, snake._currentLine);
+      writeCircle(bytes, snake._currentCircle);
+      writeLine(bytes, snake._lastLine);
+      writeCircle(bytes, snake._lastCircle);
+
+      const geometry::TrailIndex& trail = snake._trail;
+      writeU32(bytes, trail.size());
+      writeU32(bytes, from);
+
+      for (unsigned i = from; i < trail.size(); i++) {
+        writeU8(bytes, trail.isCircle(i));
+
+        if (trail.isCircle(i))
+          writeCircle(bytes, trail.getCircle(i));
+        else
+          writeLine(bytes, trail.getLine(i));
+      }
+    }
+
+    // Reads a snake which was written by writeSnake. Its trail is truncated back to
+    // where the written shapes start, and the rest of its state is only restored when
+    // asked to
+    void readSnake(ByteCursor& cursor, Snake& snake, bool trailOnly) {
+      double x = cursor.readF64();
+      double y = cursor.readF64();
+      double r = cursor.readF64();
+      double rad = cursor.readF64();
+      double v = cursor.readF64();
+      unsigned direction = cursor.readU8();
+      bool currentIsCircle = cursor.readU8();
+      bool lastBitIsCircle = cursor.readU8();
+      geometry::Line currentLine = readLine(cursor);
+      geometry::Circle currentCircle = readCircle(cursor);
+      geometry::Line lastLine = readLine(cursor);
+      geometry::Circle lastCircle = readCircle(cursor);
+
+      unsigned size = cursor.readU32();
+      unsigned from = cursor.readU32();
+      geometry::TrailIndex& trail = snake._trail;
+
+      if (direction > (unsigned) Direction::RIGHT || from > trail.size() || from > size)
+        throw std::invalid_argument("ReplayReader: malformed keyframe");
+
+      while (trail.size() > from) trail.pop();
+
+      for (unsigned i = from; i < size; i++) {
+        if (cursor.readU8())
+          trail.append(readCircle(cursor));
+        else
+          trail.append(readLine(cursor));
+      }
+
+      if (trailOnly) return;
+
+      snake._x = x;
+      snake._y = y;
+      snake._r = r;
+      snake._rad = rad;
+      snake._v = v;
+      snake._direction = (Direction) direction;
+      snake._currentIsCircle = currentIsCircle;
+      snake._lastBitIsCircle = lastBitIsCircle;
+      snake._currentLine = currentLine;
+      snake._currentCircle = currentCircle;
+      snake._lastLine = lastLine;
+      snake._lastCircle = lastCircle;
+    }
+  }
+
+  // match - A match which hasn't been stepped yet
+  // keyframeInterval - The number of ticks between keyframes
+  ReplayWriter::ReplayWriter(const Match& match, unsigned keyframeInterval):
+    _keyframeInterval(std::max(keyframeInterval, 1u)),
+    _ticks(0),
+    _inputBits(0),
+    _lastChange(0) {
+    if (match._tick) throw std::invalid_argument("ReplayWriter: match has already started");
+
+    if (match._world._snakes.size() > World::MAX_PACKED_SNAKES)
+      throw std::invalid_argument("ReplayWriter: input bits cover up to 16 snakes");
+
+    writeF64(_setup, match._world._width);
+    writeF64(_setup, match._world._height);
+    writeF64(_setup, match._span);
+
+    for (const Snake& snake : match._world._snakes) {
+      writeF64(_setup, snake._x);
+      writeF64(_setup, snake._y);
+      writeF64(_setup, snake._r);
+      writeF64(_setup, snake._rad);
+      writeF64(_setup, snake._v);
+      _trailSizes.push_back(snake._trail.size());
+    }
+  }
+
+  // Records the input bits of the tick which the match has just made
+  void ReplayWriter::record(const Match& match, unsigned inputBits) {
+    if (inputBits != _inputBits) {
+      writeVarint(_inputs, _ticks - _lastChange);
+      writeVarint(_inputs, inputBits ^ _inputBits);
+      _inputBits = inputBits;
+      _lastChange = _ticks;
+    }
+
+    _ticks++;
+
+    if (_ticks % _keyframeInterval == 0) writeKeyframe(match);
+  }
+
+  // A keyframe holds the state of the input cursor right after its tick, so input
+  // can be read from that point onwards
+  void ReplayWriter::writeKeyframe(const Match& match) {
+    _keyframeOffsets.push_back(_keyframes.size());
+
+    writeU32(_keyframes, _ticks);
+    // Replays hold 16 snakes at most, so their alive bits fit
+    writeU32(_keyframes, (unsigned) match._world._alive);
+    writeU32(_keyframes, _inputs.size());
+    writeU32(_keyframes, _inputBits);
+    writeU32(_keyframes, _lastChange);
+
+    for (unsigned i = 0; i < match._world._snakes.size(); i++) {
+      const Snake& snake = match._world._snakes.at(i);
+      // The last shape of the previous keyframe might have grown since
+      unsigned from = _trailSizes.at(i) ? _trailSizes.at(i) - 1 : 0;
+
+      writeSnake(_keyframes, snake, from);
+      _trailSizes.at(i) = snake._trail.size();
+    }
+  }
+
+  // Returns the replay of all the ticks which were recorded so far
+  std::vector<unsigned char> ReplayWriter::finish() const {
+    std::vector<unsigned char> bytes(MAGIC, MAGIC + sizeof(MAGIC));
+    writeU32(bytes, VERSION);
+    writeU32(bytes, _trailSizes.size());
+    writeU32(bytes, _ticks);
+    writeU32(bytes, _keyframeInterval);
+    writeU32(bytes, _keyframeOffsets.size());
+    writeU32(bytes, _inputs.size());
+    writeU32(bytes, _keyframes.size());
+
+    bytes.insert(bytes.end(), _setup.begin(), _setup.end());
+    bytes.insert(bytes.end(), _inputs.begin(), _inputs.end());
+    for (unsigned offset : _keyframeOffsets) writeU32(bytes, offset);
+    bytes.insert(bytes.end(), _keyframes.begin(), _keyframes.end());
+
+    return bytes;
+  }
+
+  ReplayReader::ReplayReader(const unsigned char* data, std::size_t size):
+    _data(data),
+    _size(size) {
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)))
+      throw std::invalid_argument("ReplayReader: not a replay");
+
+    ByteCursor cursor = { data, size, sizeof(MAGIC) };
+
+    if (cursor.readU32() != VERSION)
+      throw std::invalid_argument("ReplayReader: unsupported version");
+
+    _snakesCount = cursor.readU32();
+    _ticks = cursor.readU32();
+    _keyframeInterval = cursor.readU32();
+    _keyframesCount = cursor.readU32();
+    _inputsSize = cursor.readU32();
+    std::size_t keyframesSize = cursor.readU32();
+    _width = cursor.readF64();
+    _height = cursor.readF64();
+    _span = cursor.readF64();
+
+    // A world can't hold more snakes than its input bits can address
+    if (_snakesCount > World::MAX_PACKED_SNAKES || !_keyframeInterval)
+      throw std::invalid_argument("ReplayReader: malformed header");
+
+    _inputsOffset = HEADER_SIZE + _snakesCount * SETUP_SIZE;
+    _keyframesOffset = _inputsOffset + _inputsSize + _keyframesCount * 4;
+
+    cursor.offset = _inputsOffset;
+    cursor.require(_inputsSize + _keyframesCount * 4 + keyframesSize);
+
+    for (unsigned i = 0; i < _keyframesCount; i++) {
+      if (getKeyframeOffset(i) >= _size)
+        throw std::invalid_argument("ReplayReader: malformed keyframe table");
+    }
+
+    _tick = 0;
+    _inputBits = 0;
+    _inputOffset = 0;
+    readChange(0);
+  }
+
+  unsigned ReplayReader::getTicks() const {
+    return _ticks;
+  }
+
+  unsigned ReplayReader::getSnakesCount() const {
+    return _snakesCount;
+  }
+
+  unsigned ReplayReader::getKeyframesCount() const {
+    return _keyframesCount;
+  }
+
+  unsigned ReplayReader::getKeyframeTick(unsigned keyframe) const {
+    ByteCursor cursor = { _data, _size, getKeyframeOffset(keyframe) };
+    return cursor.readU32();
+  }
+
+  // Returns the absolute offset of a keyframe's record
+  std::size_t ReplayReader::getKeyframeOffset(unsigned keyframe) const {
+    if (keyframe >= _keyframesCount) throw std::out_of_range("ReplayReader::getKeyframeOffset");
+
+    ByteCursor cursor = { _data, _size, _inputsOffset + _inputsSize + keyframe * 4 };
+    return _keyframesOffset + cursor.readU32();
+  }
+
+  // Returns a new match at its very first tick, and rewinds the input to match it
+  Match ReplayReader::start() {
+    Match match(_width, _height, _span);
+    ByteCursor cursor = { _data, _size, HEADER_SIZE };
+
+    for (unsigned i = 0; i < _snakesCount; i++) {
+      double x = cursor.readF64();
+      double y = cursor.readF64();
+      double r = cursor.readF64();
+      double rad = cursor.readF64();
+      double v = cursor.readF64();
+      match._world.addSnake(x, y, r, rad, v);
+    }
+
+    _tick = 0;
+    _inputBits = 0;
+    _inputOffset = 0;
+    readChange(0);
+
+    return match;
+  }
+
+  // Returns a match at the given tick. The match is restored from the closest keyframe
+  // which precedes the tick, and only the ticks since then are simulated
+  Match ReplayReader::seek(unsigned tick) {
+    tick = std::min(tick, _ticks);
+
+    Match match = start();
+    unsigned keyframesCount = std::min(tick / _keyframeInterval, _keyframesCount);
+
+    // Each keyframe only holds the recent shapes of the trails, so all the preceding
+    // ones are needed to rebuild them
+    for (unsigned i = 0; i < keyframesCount; i++) {
+      restoreKeyframe(match, i, i + 1 < keyframesCount);
+    }
+
+    while (match._tick < tick) match.step(nextInput());
+
+    return match;
+  }
+
+  void ReplayReader::restoreKeyframe(Match& match, unsigned keyframe, bool trailsOnly) {
+    ByteCursor cursor = { _data, _size, getKeyframeOffset(keyframe) };
+
+    unsigned tick = cursor.readU32();
+    unsigned alive = cursor.readU32();
+    std::size_t inputOffset = cursor.readU32();
+    unsigned inputBits = cursor.readU32();
+    unsigned lastChange = cursor.readU32();
+
+    for (Snake& snake : match._world._snakes) readSnake(cursor, snake, trailsOnly);
+
+    if (trailsOnly) return;
+
+    if (inputOffset > _inputsSize || lastChange > tick)
+      throw std::invalid_argument("ReplayReader: malformed keyframe");
+
+    match._tick = tick;
+    match._world._alive = alive;
+    match._world.resync();
+
+    _tick = tick;
+    _inputBits = inputBits;
+    _inputOffset = inputOffset;
+    readChange(lastChange);
+  }
+
+  // Returns the input bits of the next tick, and moves on to the one after it
+  unsigned ReplayReader::nextInput() {
+    if (_tick == _nextChange) {
+      ByteCursor cursor = { _data + _inputsOffset, _inputsSize, _inputOffset };
+      _inputBits ^= cursor.readVarint();
+      _inputOffset = cursor.offset;
+      readChange(_tick);
+    }
+
+    _tick++;
+
+    return _inputBits;
+  }
+
+  // Reads when the next input change takes place, relative to the previous one
+  void ReplayReader::readChange(unsigned lastChange) {
+    if (_inputOffset >= _inputsSize) {
+      _nextChange = NO_CHANGE;
+      return;
+    }
+
+    ByteCursor cursor = { _data + _inputsOffset, _inputsSize, _inputOffset };
+    _nextChange = lastChange + cursor.readVarint();
+    _inputOffset = cursor.offset;
+  }
+
+  // Plays the given match until the end of the replay
+  MatchResult ReplayReader::play(Match& match) {
+    return match.run([this](unsigned) { return nextInput(); }, _ticks);
+  }
+
+  // A dump of the match's whole state, good for telling whether two matches are in the
+  // exact same state, down to the last bit
+  std::vector<unsigned char> getStateBytes(const Match& match) {
+    std::vector<unsigned char> bytes;
+    writeU32(bytes, match._tick);
+    writeU32(bytes, (unsigned) match._world._alive);
+    writeU32(bytes, (unsigned) (match._world._alive >> 32));
+
+    for (const Snake& snake : match._world._snakes) writeSnake(bytes, snake, 0);
+
+    return bytes;
+  }
+}
\ No newline at end of file
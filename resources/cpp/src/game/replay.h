@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "match.h"
+
+namespace game {
+  // Records a match into a compact binary replay, made out of:
+  // header - format, match size, tick span and the initial properties of each snake
+  // inputs - the input bits of each tick, stored as a list of changes, where each
+  //   change is the number of ticks since the previous change and the bits which have
+  //   flipped, both as varints. Players hold keys for many ticks, so most ticks take
+  //   no space at all
+  // keyframes - the full state of the match every few ticks, so a replay can be
+  //   sought without re-simulating it from the start. Trails only ever grow at their
+  //   end, so each keyframe stores the shapes which were added since the previous one
+  // All numbers are little endian, so replays can be shared across platforms
+  class ReplayWriter {
+  public:
+    static const unsigned KEYFRAME_INTERVAL = 600;
+
+    ReplayWriter(const Match& match, unsigned keyframeInterval = KEYFRAME_INTERVAL);
+
+    void record(const Match& match, unsigned inputBits);
+
+    std::vector<unsigned char> finish() const;
+
+  private:
+    unsigned _keyframeInterval;
+    unsigned _ticks;
+    unsigned _inputBits;
+    unsigned _lastChange;
+    std::vector<unsigned char> _setup;
+    std::vector<unsigned char> _inputs;
+    std::vector<unsigned char> _keyframes;
+    std::vector<unsigned> _keyframeOffsets;
+    std::vector<unsigned> _trailSizes;
+
+    void writeKeyframe(const Match& match);
+  };
+
+  // Plays a replay back straight out of the given memory, e.g. a memory mapped file,
+  // which has to outlive the reader. Malformed replays throw an invalid_argument
+  class ReplayReader {
+  public:
+    ReplayReader(const unsigned char* data, std::size_t size);
+
+    unsigned getTicks() const;
+
+    unsigned getSnakesCount() const;
+
+    unsigned getKeyframesCount() const;
+
+    unsigned getKeyframeTick(unsigned keyframe) const;
+
+    Match start();
+
+    Match seek(unsigned tick);
+
+    unsigned nextInput();
+
+    MatchResult play(Match& match);
+
+  private:
+    const unsigned char* _data;
+    std::size_t _size;
+    unsigned _snakesCount;
+    unsigned _ticks;
+    unsigned _keyframeInterval;
+    unsigned _keyframesCount;
+    std::size_t _inputsOffset;
+    std::size_t _inputsSize;
+    std::size_t _keyframesOffset;
+    double _width;
+    double _height;
+    double _span;
+    // The input cursor
+    unsigned _tick;
+    unsigned _inputBits;
+    unsigned _nextChange;
+    std::size_t _inputOffset;
+
+    std::size_t getKeyframeOffset(unsigned keyframe) const;
+
+    void restoreKeyframe(Match& match, unsigned keyframe, bool trailsOnly);
+
+    void readChange(unsigned lastChange);
+  };
+
+  std::vector<unsigned char> getStateBytes(const Match& match);
+}
\ No newline at end of file
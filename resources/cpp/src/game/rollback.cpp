@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "world.h"
+#include "match.h"
+#include "rollback.h"
+
+namespace game {
+  // window - The most ticks a correction may go back
+  Rollback::Rollback(unsigned window):
+    _snapshots(std::max(window, 1u)),
+    _inputs(std::max(window, 1u), 0) {
+  }
+
+  // Clears the match so it can be played again. Snapshots keep their memory
+  void Rollback::reset() {
+    _match.reset();
+  }
+
+  // Saves a snapshot of the match and steps it with the given input bits. Only the
+  // packed input bits are kept, so matches of more snakes than they cover are rejected
+  StepStatus Rollback::step(unsigned inputBits) {
+    if (_match._world._snakes.size() > World::MAX_PACKED_SNAKES)
+      throw std::invalid_argument("Rollback: input bits cover up to 16 snakes");
+
+    unsigned index = _match._tick % _snapshots.size();
+
+    _match.save(_snapshots[index]);
+    _inputs[index] = inputBits;
+
+    return _match.step(inputBits);
+  }
+
+  // Replaces the bits under the given mask in the input of the given tick and of all
+  // the ticks since then, as the input of a single player arrives in order and is
+  // predicted to be held until the next one does. If any input has changed, the match
+  // is rewound and re-simulated up to its current tick. Returns the number of ticks
+  // which were simulated again. Ticks which weren't stepped yet are left as they are,
+  // while ticks older than the window can't be corrected anymore, so the match would
+  // go out of sync with the actual input, which is an error
+  unsigned Rollback::correct(unsigned tick, unsigned inputBits, unsigned mask) {
+    unsigned current = _match._tick;
+
+    if (tick < getOldestTick())
+      throw std::out_of_range("Rollback::correct: tick is older than the window");
+
+    if (tick >= current) return 0;
+
+    bool changed = false;
+
+    for (unsigned t = tick; t < current; t++) {
+      unsigned& stepBits = _inputs[t % _inputs.size()];
+      unsigned corrected = (stepBits & ~mask) | (inputBits & mask);
+
+      changed = changed || corrected != stepBits;
+      stepBits = corrected;
+    }
+
+    if (!changed) return 0;
+
+    _match.restore(_snapshots[tick % _snapshots.size()]);
+
+    while (_match._tick < current) step(_inputs[_match._tick % _inputs.size()]);
+
+    return current - tick;
+  }
+
+  // The oldest tick which can still be corrected
+  unsigned Rollback::getOldestTick() const {
+    unsigned window = _snapshots.size();
+    return _match._tick > window ? _match._tick - window : 0;
+  }
+}
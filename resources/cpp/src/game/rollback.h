@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include "world.h"
+#include "match.h"
+
+namespace game {
+  // Steps a match while keeping snapshots of its last few ticks along with the input
+  // bits they were stepped with, so input which was predicted, e.g. a remote player's,
+  // can be corrected once it arrives: the match is rewound to the tick the input belongs
+  // to, and the ticks since then are simulated again
+  class Rollback {
+  public:
+    // The most ticks a correction may go back
+    static const unsigned WINDOW = 8;
+
+    Match _match;
+
+    Rollback(unsigned window = WINDOW);
+
+    void reset();
+
+    StepStatus step(unsigned inputBits);
+
+    unsigned correct(unsigned tick, unsigned inputBits, unsigned mask);
+
+    unsigned getOldestTick() const;
+
+  private:
+    // The snapshot of each tick, taken right before it was stepped, and its input bits.
+    // Both are indexed by the tick modulo the window
+    std::vector<MatchSnapshot> _snapshots;
+    std::vector<unsigned> _inputs;
+  };
+}
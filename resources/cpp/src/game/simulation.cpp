@@ -0,0 +1,184 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "../geometry/trail_index.h"
+#include "../geometry/shape_batch.h"
+#include "snake.h"
+#include "world.h"
+#include "match.h"
+#include "input_queue.h"
+#include "state_buffer.h"
+#include "trail_log.h"
+#include "simulation.h"
+
+namespace game {
+  // period - The real time between ticks, in milliseconds. Each tick steps the match by
+  // its own fixed span regardless, so 0 simply runs the match as fast as possible
+  Simulation::Simulation(double width, double height, double period):
+    _match(width, height),
+    _input(INPUT_CAPACITY),
+    _states(HEADER_SIZE),
+    _period(period),
+    _inputBits(0),
+    _running(false) {
+    publish();
+  }
+
+  Simulation::~Simulation() {
+    stop();
+  }
+
+  unsigned Simulation::addSnake(double x, double y, double r, double rad, double v) {
+    unsigned index = _match._world.addSnake(x, y, r, rad, v);
+    prepare();
+
+    return index;
+  }
+
+  void Simulation::addDefaultSnakes() {
+    _match.addDefaultSnakes();
+    prepare();
+  }
+
+  // Clears the match along with the logs and the input which wasn't handled yet
+  void Simulation::reset() {
+    unsigned inputBits;
+    while (_input.pop(inputBits));
+
+    _match.reset();
+    _inputBits = 0;
+
+    for (TrailLog& log : _logs) log.clear();
+
+    prepare();
+  }
+
+  // Makes room for the current snakes and publishes their initial state. Logs are kept
+  // along with their blocks for the snakes of the next matches
+  void Simulation::prepare() {
+    unsigned snakesCount = _match._world._snakes.size();
+
+    if (_logs.size() < snakesCount) _logs.resize(snakesCount);
+    _states.resize(HEADER_SIZE + snakesCount * SNAKE_STRIDE);
+    publish();
+  }
+
+  // Starts ticking on a thread of its own. Returns false if threads aren't supported,
+  // e.g. in a browser build without pthreads, in which case the caller should tick
+  bool Simulation::start() {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return false;
+#else
+    if (_thread.joinable()) return true;
+
+    _running.store(true, std::memory_order_release);
+    _thread = std::thread(&Simulation::run, this);
+
+    return true;
+#endif
+  }
+
+  // Stops ticking once the current tick is done, and waits for the thread to finish
+  void Simulation::stop() {
+    if (!_thread.joinable()) return;
+
+    _running.store(false, std::memory_order_release);
+    _thread.join();
+  }
+
+  bool Simulation::isRunning() const {
+    return _running.load(std::memory_order_acquire);
+  }
+
+  // Queues the input bits which should be held from the next tick onwards. Returns
+  // false if the queue is full. Meant to be called by a single thread only
+  bool Simulation::pushInput(unsigned inputBits) {
+    return _input.push(inputBits);
+  }
+
+  // Returns the most recently published state, which remains as is until the next
+  // call. Meant to be called by a single thread only
+  const double* Simulation::acquireState() {
+    return _states.acquire();
+  }
+
+  // Returns the descriptor of a logged segment. Only segments which were logged by the
+  // time the last acquired state was published may be read
+  const double* Simulation::getSegment(unsigned snakeIndex, unsigned id) const {
+    return _logs.at(snakeIndex).getSegment(id);
+  }
+
+  // Steps the match by a single tick with the latest input bits, and publishes the
+  // state it has left the world in
+  StepStatus Simulation::tick() {
+    unsigned inputBits;
+    while (_input.pop(inputBits)) _inputBits = inputBits;
+
+    StepStatus status = _match.step(_inputBits);
+    publish();
+
+    return status;
+  }
+
+  // Ticks at a fixed rate until stopped. A thread which falls behind catches up with a
+  // few ticks at most, the same way World::advance() does
+  void Simulation::run() {
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double, std::milli>(_period));
+    Clock::time_point next = Clock::now();
+
+    while (_running.load(std::memory_order_acquire)) {
+      tick();
+      next += period;
+
+      Clock::time_point now = Clock::now();
+
+      if (now - next > period * World::MAX_CATCH_UP)
+        next = now;
+      else
+        std::this_thread::sleep_until(next);
+    }
+  }
+
+  // Logs the segments which have become stable and writes the rest of the state into
+  // the back buffer before publishing it. Logged segments are written before the state
+  // which counts them is published, so a reader never sees a count it can't read
+  void Simulation::publish() {
+    const World& world = _match._world;
+    const unsigned stride = geometry::ShapeBatch::SHAPE_STRIDE;
+    double* state = _states.getBack();
+
+    unsigned aliveCount = 0;
+
+    state[0] = _match._tick;
+    state[2] = world._snakes.size();
+
+    for (unsigned i = 0; i < world._snakes.size(); i++) {
+      const Snake& snake = world._snakes[i];
+      const geometry::TrailIndex& trail = snake._trail;
+      TrailLog& log = _logs[i];
+      double* record = state + HEADER_SIZE + i * SNAKE_STRIDE;
+
+      log.sync(trail, snake.getStableShapesCount());
+
+      record[0] = snake._x;
+      record[1] = snake._y;
+      record[2] = snake._rad;
+      record[3] = (world._alive >> i) & 1;
+      record[4] = log.size();
+      record[5] = trail.size();
+      aliveCount += record[3];
+
+      for (unsigned j = 0; j < TAIL_SIZE && log.size() + j < trail.size(); j++) {
+        TrailLog::writeSegment(trail, log.size() + j, record + 6 + j * stride);
+      }
+    }
+
+    state[1] = aliveCount;
+
+    _states.publish();
+  }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../geometry/shape_batch.h"
+#include "snake.h"
+#include "world.h"
+#include "match.h"
+#include "input_queue.h"
+#include "state_buffer.h"
+#include "trail_log.h"
+
+namespace game {
+  // Runs a match on a thread of its own at a fixed tick rate, so a heavy step never
+  // holds back a frame. Input bits are pushed by the rendering thread into a queue,
+  // and the latest of them is held for each tick. After each tick the state of the
+  // world is published into a triple buffer, which the rendering thread reads without
+  // waiting. Each state is made out of 3 numbers:
+  // tick, alive snakes count, snakes count
+  // followed by a record of 6 + (TAIL_SIZE * 6) numbers for each snake:
+  // x, y, rad, alive (1 or 0), logged segments count, segments count, tail segments
+  // A trail is made out of the logged segments, see TrailLog, followed by the tail
+  // segments, which are laid out the same way and might still change.
+  // Snakes are added and the match is reset only while the thread is stopped
+  class Simulation {
+  public:
+    static const unsigned HEADER_SIZE = 3;
+    // The most segments which aren't logged yet, see Snake::getStableShapesCount()
+    static const unsigned TAIL_SIZE = Snake::CONNECTED_SHAPES + 1;
+    static const unsigned SNAKE_STRIDE = 6 + TAIL_SIZE * geometry::ShapeBatch::SHAPE_STRIDE;
+    static const unsigned INPUT_CAPACITY = 64;
+
+    Match _match;
+    InputQueue _input;
+    StateBuffer _states;
+    std::vector<TrailLog> _logs;
+
+    Simulation(double width = Match::WIDTH, double height = Match::HEIGHT,
+      double period = Match::SPAN);
+
+    ~Simulation();
+
+    unsigned addSnake(double x, double y, double r, double rad, double v);
+
+    void addDefaultSnakes();
+
+    void reset();
+
+    bool start();
+
+    void stop();
+
+    bool isRunning() const;
+
+    bool pushInput(unsigned inputBits);
+
+    const double* acquireState();
+
+    const double* getSegment(unsigned snakeIndex, unsigned id) const;
+
+    StepStatus tick();
+
+  private:
+    double _period;
+    unsigned _inputBits;
+    std::atomic<bool> _running;
+    std::thread _thread;
+
+    void run();
+
+    void prepare();
+
+    void publish();
+  };
+}
@@ -0,0 +1,385 @@
+#include <cmath>
+#include <vector>
+#include "../nullable.h"
+#include "../geometry/box.h"
+#include "../geometry/point.h"
+#include "../geometry/arena.h"
+#include "../geometry/intersection.h"
+#include "../geometry/line.h"
+#include "../geometry/circle.h"
+#include "../geometry/sweep.h"
+#include "../geometry/trail_index.h"
+#include "snake.h"
+
+namespace game {
+  SnakeSnapshot::SnakeSnapshot():
+    x(0),
+    y(0),
+    r(0),
+    rad(0),
+    v(0),
+    direction(Direction::NONE),
+    currentIsCircle(false),
+    currentLine(0, 0, 0, 0),
+    currentCircle(0, 0, 0, 0, 0),
+    lastBitIsCircle(false),
+    lastLine(0, 0, 0, 0),
+    lastCircle(0, 0, 0, 0, 0),
+    stableCount(0) {
+  }
+
+  // Represents a snake data-structure which will eventually appear on screen.
+  // All the properties provided to the constructor are the initial values of
+  // the snake
+  Snake::Snake(double x, double y, double r, double rad, double v):
+    _x(x),
+    _y(y),
+    _r(r),
+    _rad(rad),
+    _v(v),
+    _direction(Direction::NONE),
+    // A snake starts with a line
+    _currentIsCircle(false),
+    _currentLine(x, y, x, y),
+    _currentCircle(x, y, r, rad, rad),
+    _lastBitIsCircle(false),
+    _lastLine(x, y, x, y),
+    _lastCircle(x, y, r, rad, rad) {
+    _trail.append(_currentLine);
+  }
+
+  // Puts the snake back to its initial state with the given properties. The trail's
+  // storage is kept, so a recycled snake won't allocate memory for its shapes again
+  void Snake::reset(double x, double y, double r, double rad, double v) {
+    _x = x;
+    _y = y;
+    _r = r;
+    _rad = rad;
+    _v = v;
+    _direction = Direction::NONE;
+    _currentIsCircle = false;
+    _currentLine = geometry::Line(x, y, x, y);
+    _currentCircle = geometry::Circle(x, y, r, rad, rad);
+    _lastBitIsCircle = false;
+    _lastLine = geometry::Line(x, y, x, y);
+    _lastCircle = geometry::Circle(x, y, r, rad, rad);
+    _trail.clear();
+    _trail.append(_currentLine);
+  }
+
+  void Snake::update(double span, Direction direction, const geometry::Arena& arena) {
+    // Progress made based on elapsed time and velocity
+    double step = (_v * span) / 1000;
+
+    updateShapes(step, direction, UpdateOptions());
+    cycleThrough(step, direction, arena);
+  }
+
+  // Makes the given number of updates with the given span, as update() would while the
+  // snake keeps its direction and doesn't wrap around, e.g. once World::isClear() has
+  // made sure of both. The shapes go through the exact same values, while the trail
+  // is only updated once they're done
+  void Snake::move(double span, unsigned updates) {
+    if (!updates) return;
+
+    double step = (_v * span) / 1000;
+
+    for (unsigned i = 0; i < updates; i++) {
+      if (_currentIsCircle)
+        updateCurrentCircle(UpdateOptions());
+      else
+        updateCurrentLine(UpdateOptions());
+
+      extendCurrentShape(step, _direction);
+    }
+
+    if (_currentIsCircle)
+      _trail.updateLast(_currentCircle);
+    else
+      _trail.updateLast(_currentLine);
+  }
+
+  // Updates shapes based on progress made
+  void Snake::updateShapes(double step, Direction direction, const UpdateOptions& options) {
+    if (_currentIsCircle)
+      updateCurrentCircle(options);
+    else
+      updateCurrentLine(options);
+
+    changeDirection(direction, options);
+    continueDirection(step, direction);
+  }
+
+  // Updates current shape in case it is a line
+  void Snake::updateCurrentLine(const UpdateOptions& options) {
+    double lastX = options.lastX.hasValue() ? options.lastX.getValue() : _x;
+    double lastY = options.lastY.hasValue() ? options.lastY.getValue() : _y;
+    _x = options.x.hasValue() ? options.x.getValue() : _currentLine._x2;
+    _y = options.y.hasValue() ? options.y.getValue() : _currentLine._y2;
+    _lastBitIsCircle = false;
+    _lastLine = geometry::Line(lastX, lastY, _x, _y);
+  }
+
+  // Updates current shape in case it is a circle
+  void Snake::updateCurrentCircle(const UpdateOptions& options) {
+    double lastX = options.lastX.hasValue() ? options.lastX.getValue() : _currentCircle._x;
+    double lastY = options.lastY.hasValue() ? options.lastY.getValue() : _currentCircle._y;
+    double lastR = _currentCircle._r;
+
+    _lastBitIsCircle = true;
+
+    // Update logic for left rotation
+    if (_direction == Direction::LEFT) {
+      double lastRad = _rad + (0.5 * M_PI);
+      geometry::Point currentShapePoint = _currentCircle.getMatchingPoint(_currentCircle._rad1).getValue();
+      _x = options.x.hasValue() ? options.x.getValue() : currentShapePoint.x;
+      _y = options.y.hasValue() ? options.y.getValue() : currentShapePoint.y;
+      _rad = _currentCircle._rad1 - (0.5 * M_PI);
+      _lastCircle = geometry::Circle(lastX, lastY, lastR, _currentCircle._rad1, lastRad);
+    }
+    // Update logic for right rotation
+    else {
+      double lastRad = _rad - (0.5 * M_PI);
+      geometry::Point currentShapePoint = _currentCircle.getMatchingPoint(_currentCircle._rad2).getValue();
+      _x = options.x.hasValue() ? options.x.getValue() : currentShapePoint.x;
+      _y = options.y.hasValue() ? options.y.getValue() : currentShapePoint.y;
+      _rad = _currentCircle._rad2 + (0.5 * M_PI);
+      _lastCircle = geometry::Circle(lastX, lastY, lastR, lastRad, _currentCircle._rad2);
+    }
+  }
+
+  // Change the recent shape type according to the given direction
+  void Snake::changeDirection(Direction direction, const UpdateOptions& options) {
+    // If there is no change in direction, abort, unless we force it
+    if (direction == _direction && !options.force) return;
+
+    _direction = direction;
+
+    // This will push a new shape with new properties, based on the direction
+    switch (direction) {
+      case Direction::LEFT: {
+        double angle = _rad - (0.5 * M_PI);
+        double rad = _rad + (0.5 * M_PI);
+        double x = _x + (_r * std::cos(angle));
+        double y = _y + (_r * std::sin(angle));
+        _currentIsCircle = true;
+        _currentCircle = geometry::Circle(x, y, _r, rad, rad);
+        _trail.append(_currentCircle);
+        break;
+      }
+      case Direction::RIGHT: {
+        double angle = _rad + (0.5 * M_PI);
+        double rad = _rad - (0.5 * M_PI);
+        double x = _x + (_r * std::cos(angle));
+        double y = _y + (_r * std::sin(angle));
+        _currentIsCircle = true;
+        _currentCircle = geometry::Circle(x, y, _r, rad, rad);
+        _trail.append(_currentCircle);
+        break;
+      }
+      default:
+        _currentIsCircle = false;
+        _currentLine = geometry::Line(_x, _y, _x, _y);
+        _trail.append(_currentLine);
+    }
+  }
+
+  // Extend the recent shape based on progress made
+  void Snake::continueDirection(double step, Direction direction) {
+    extendCurrentShape(step, direction);
+
+    if (_currentIsCircle)
+      _trail.updateLast(_currentCircle);
+    else
+      _trail.updateLast(_currentLine);
+  }
+
+  // Extends the recent shape alone, leaving the trail as it is
+  void Snake::extendCurrentShape(double step, Direction direction) {
+    switch (direction) {
+      case Direction::LEFT:
+        _currentCircle.setRad1(_currentCircle._rad1 - (step / _r));
+        break;
+      case Direction::RIGHT:
+        _currentCircle.setRad2(_currentCircle._rad2 + (step / _r));
+        break;
+      default:
+        _currentLine.setX2(_currentLine._x2 + (step * std::cos(_rad)));
+        _currentLine.setY2(_currentLine._y2 + (step * std::sin(_rad)));
+    }
+  }
+
+  // Handles case where snake is out limits and we need to render it from
+  // the other side of the canvas
+  void Snake::cycleThrough(double step, Direction direction, const geometry::Arena& arena) {
+    geometry::Point head = { _x, _y };
+    geometry::Crossing crossing = _lastBitIsCircle ?
+      arena.getCrossing(_lastCircle, head) :
+      arena.getCrossing(_lastLine, head);
+
+    if (!crossing.hasValue()) return;
+
+    // Re-calculate position based on canvas bounds
+    _x = crossing.head.x;
+    _y = crossing.head.y;
+
+    // Update shapes again based on custom properties
+    UpdateOptions options;
+    options.force = true;
+    options.lastX.setValue(_x);
+    options.lastY.setValue(_y);
+    options.x.setValue(_x);
+    options.y.setValue(_y);
+
+    updateShapes(step, direction, options);
+  }
+
+  // Returns if last bit intersects with own shapes
+  bool Snake::hasSelfIntersection() {
+    if (hasFullTurn()) return true;
+
+    // The last shapes are always connected to the last bit, so they're ignored
+    return _lastBitIsCircle ?
+      _trail.getIntersection(_lastCircle, CONNECTED_SHAPES).hasValue() :
+      _trail.getIntersection(_lastLine, CONNECTED_SHAPES).hasValue();
+  }
+
+  // The number of leading shapes of the trail which will never change again. The last
+  // shape keeps growing, and the ones before it are still connected to the last bit
+  unsigned Snake::getStableShapesCount() const {
+    unsigned size = _trail.size();
+    return size > CONNECTED_SHAPES + 1 ? size - CONNECTED_SHAPES - 1 : 0;
+  }
+
+  // Saves the state of the snake into the given snapshot, reusing its memory. Only the
+  // unstable shapes of the trail are copied, so a save costs the same no matter how
+  // long the trail is
+  void Snake::save(SnakeSnapshot& snapshot) const {
+    snapshot.x = _x;
+    snapshot.y = _y;
+    snapshot.r = _r;
+    snapshot.rad = _rad;
+    snapshot.v = _v;
+    snapshot.direction = _direction;
+    snapshot.currentIsCircle = _currentIsCircle;
+    snapshot.currentLine = _currentLine;
+    snapshot.currentCircle = _currentCircle;
+    snapshot.lastBitIsCircle = _lastBitIsCircle;
+    snapshot.lastLine = _lastLine;
+    snapshot.lastCircle = _lastCircle;
+    snapshot.stableCount = getStableShapesCount();
+    snapshot.tailKinds.clear();
+    snapshot.tailLines.clear();
+    snapshot.tailCircles.clear();
+
+    for (unsigned id = snapshot.stableCount; id < _trail.size(); id++) {
+      snapshot.tailKinds.push_back(_trail.isCircle(id));
+
+      if (_trail.isCircle(id))
+        snapshot.tailCircles.push_back(_trail.getCircle(id));
+      else
+        snapshot.tailLines.push_back(_trail.getLine(id));
+    }
+  }
+
+  // Puts the snake back into the state it was saved in. The trail is truncated back to
+  // its stable shapes and the saved ones are appended, so a restore only costs as much
+  // as the shapes which were added since. Stable shapes are taken as they are, so the
+  // snapshot must have been saved by this very snake, during the same match
+  void Snake::restore(const SnakeSnapshot& snapshot) {
+    _x = snapshot.x;
+    _y = snapshot.y;
+    _r = snapshot.r;
+    _rad = snapshot.rad;
+    _v = snapshot.v;
+    _direction = snapshot.direction;
+    _currentIsCircle = snapshot.currentIsCircle;
+    _currentLine = snapshot.currentLine;
+    _currentCircle = snapshot.currentCircle;
+    _lastBitIsCircle = snapshot.lastBitIsCircle;
+    _lastLine = snapshot.lastLine;
+    _lastCircle = snapshot.lastCircle;
+
+    while (_trail.size() > snapshot.stableCount) _trail.pop();
+
+    unsigned lineIndex = 0;
+    unsigned circleIndex = 0;
+
+    for (bool tailCircle : snapshot.tailKinds) {
+      if (tailCircle)
+        _trail.append(snapshot.tailCircles[circleIndex++]);
+      else
+        _trail.append(snapshot.tailLines[lineIndex++]);
+    }
+  }
+
+  // Returns if last bit intersects with the given snake's shapes
+  bool Snake::hasSnakeIntersection(Snake& snake) {
+    // Only last bit is relevant, if we reached this point it means that
+    // previous intersection will definitely fail
+    return _lastBitIsCircle ?
+      snake._trail.getIntersection(_lastCircle).hasValue() :
+      snake._trail.getIntersection(_lastLine).hasValue();
+  }
+
+  // Returns if the snake has been turning for a whole circle, in which case it has
+  // surely run into itself
+  bool Snake::hasFullTurn() const {
+    return _currentIsCircle &&
+      std::abs(_currentCircle._rad1 - _currentCircle._rad2) >= 2 * M_PI;
+  }
+
+  // Returns if last bit intersects with the segment of the given trail, e.g. once
+  // a broad phase has found them to be close to each other
+  bool Snake::hitsSegment(const geometry::TrailIndex& trail, unsigned id) const {
+    if (trail.isCircle(id)) {
+      const geometry::Circle& circle = trail.getCircle(id);
+      return _lastBitIsCircle ?
+        _lastCircle.getIntersection(circle).hasValue() :
+        _lastLine.getIntersection(circle).hasValue();
+    }
+
+    const geometry::Line& line = trail.getLine(id);
+    return _lastBitIsCircle ?
+      _lastCircle.getIntersection(line).hasValue() :
+      _lastLine.getIntersection(line).hasValue();
+  }
+
+  const geometry::Box& Snake::getLastBitBox() const {
+    return _lastBitIsCircle ? _lastCircle.getBox() : _lastLine.getBox();
+  }
+
+  // Returns the path the head would make during the next update with the given span and
+  // direction. The head is at the end of the current shape, which is a step ahead of the
+  // last bit, and a turn in the same direction carries on along the current circle
+  geometry::Sweep Snake::getSweep(double span, Direction direction) const {
+    double step = (_v * span) / 1000;
+    double x = _x;
+    double y = _y;
+    double rad = _rad;
+
+    if (!_currentIsCircle) {
+      x = _currentLine._x2;
+      y = _currentLine._y2;
+    }
+    else if (_direction == Direction::LEFT) {
+      geometry::Point head = _currentCircle.getMatchingPoint(_currentCircle._rad1).getValue();
+      x = head.x;
+      y = head.y;
+      rad = _currentCircle._rad1 - (0.5 * M_PI);
+    }
+    else {
+      geometry::Point head = _currentCircle.getMatchingPoint(_currentCircle._rad2).getValue();
+      x = head.x;
+      y = head.y;
+      rad = _currentCircle._rad2 + (0.5 * M_PI);
+    }
+
+    geometry::Turn turn =
+      direction == Direction::LEFT ? geometry::Turn::LEFT :
+      direction == Direction::RIGHT ? geometry::Turn::RIGHT :
+      geometry::Turn::NONE;
+
+    return geometry::Sweep(x, y, rad, step, _r, turn);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include "../nullable.h"
+#include "../geometry/box.h"
+#include "../geometry/point.h"
+#include "../geometry/arena.h"
+#include "../geometry/line.h"
+#include "../geometry/circle.h"
+#include "../geometry/sweep.h"
+#include "../geometry/trail_index.h"
+
+namespace game {
+  enum class Direction {
+    NONE,
+    LEFT,
+    RIGHT
+  };
+
+  // Custom properties for a shapes update, used once the snake's position has been
+  // re-calculated e.g. when cycling through the canvas
+  struct UpdateOptions {
+    bool force;
+    Nullable<double> lastX;
+    Nullable<double> lastY;
+    Nullable<double> x;
+    Nullable<double> y;
+  };
+
+  // The state of a snake as it was at some point, see Snake::save(). Only the trail's
+  // shapes which might still change are kept, since the ones before them stay as they
+  // are for as long as the snake lives
+  struct SnakeSnapshot {
+    double x;
+    double y;
+    double r;
+    double rad;
+    double v;
+    Direction direction;
+    bool currentIsCircle;
+    geometry::Line currentLine;
+    geometry::Circle currentCircle;
+    bool lastBitIsCircle;
+    geometry::Line lastLine;
+    geometry::Circle lastCircle;
+    // The number of leading shapes of the trail which weren't kept
+    unsigned stableCount;
+    // The shapes which followed them
+    std::vector<bool> tailKinds;
+    std::vector<geometry::Line> tailLines;
+    std::vector<geometry::Circle> tailCircles;
+
+    SnakeSnapshot();
+  };
+
+  // The simulation core of a snake. It owns the snake's position, heading and shapes,
+  // so a whole step can be made without leaving the native code
+  class Snake {
+  public:
+    // The number of most recent shapes which are connected to the last bit
+    static const unsigned CONNECTED_SHAPES = 2;
+
+    double _x;
+    double _y;
+    double _r;
+    double _rad;
+    double _v;
+    Direction _direction;
+    bool _currentIsCircle;
+    geometry::Line _currentLine;
+    geometry::Circle _currentCircle;
+    bool _lastBitIsCircle;
+    geometry::Line _lastLine;
+    geometry::Circle _lastCircle;
+    geometry::TrailIndex _trail;
+
+    Snake(double x, double y, double r, double rad, double v);
+
+    void reset(double x, double y, double r, double rad, double v);
+
+    void update(double span, Direction direction, const geometry::Arena& arena);
+
+    void move(double span, unsigned updates);
+
+    bool hasSelfIntersection();
+
+    bool hasSnakeIntersection(Snake& snake);
+
+    bool hasFullTurn() const;
+
+    bool hitsSegment(const geometry::TrailIndex& trail, unsigned id) const;
+
+    const geometry::Box& getLastBitBox() const;
+
+    geometry::Sweep getSweep(double span, Direction direction) const;
+
+    unsigned getStableShapesCount() const;
+
+    void save(SnakeSnapshot& snapshot) const;
+
+    void restore(const SnakeSnapshot& snapshot);
+
+  private:
+    void updateShapes(double step, Direction direction, const UpdateOptions& options);
+
+    void updateCurrentLine(const UpdateOptions& options);
+
+    void updateCurrentCircle(const UpdateOptions& options);
+
+    void changeDirection(Direction direction, const UpdateOptions& options);
+
+    void continueDirection(double step, Direction direction);
+
+    void extendCurrentShape(double step, Direction direction);
+
+    void cycleThrough(double step, Direction direction, const geometry::Arena& arena);
+  };
+}
\ No newline at end of file
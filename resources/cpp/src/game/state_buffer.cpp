@@ -0,0 +1,49 @@
+#include <atomic>
+#include <vector>
+#include "state_buffer.h"
+
+namespace game {
+  // size - The amount of numbers each state is made out of
+  StateBuffer::StateBuffer(unsigned size):
+    _back(0),
+    _front(1),
+    _middle(2) {
+    resize(size);
+  }
+
+  unsigned StateBuffer::size() const {
+    return _buffers[0].size();
+  }
+
+  // Changes the size of the states and zeroes all of them, as if nothing was published.
+  // Neither side may use the buffer meanwhile
+  void StateBuffer::resize(unsigned size) {
+    for (std::vector<double>& buffer : _buffers) buffer.assign(size, 0);
+
+    _back = 0;
+    _front = 1;
+    _middle.store(2, std::memory_order_relaxed);
+  }
+
+  // The state which is being written. Nothing reads it until it's published
+  double* StateBuffer::getBack() {
+    return _buffers[_back].data();
+  }
+
+  // Hands over the back buffer to the reader, and takes whichever buffer the reader
+  // isn't using as the next back buffer. Meant to be called by the writer only
+  void StateBuffer::publish() {
+    _back = _middle.exchange(_back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+  }
+
+  // Returns the most recently published state. It remains as is until the next call,
+  // no matter how many states are published meanwhile. Meant to be called by the
+  // reader only
+  const double* StateBuffer::acquire() {
+    if (_middle.load(std::memory_order_relaxed) & FRESH) {
+      _front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    return _buffers[_front].data();
+  }
+}
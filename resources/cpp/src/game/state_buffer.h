@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace game {
+  // A triple buffer of states, each made out of a fixed amount of numbers, which a
+  // single thread writes while another one reads the most recent of them. Neither side
+  // ever waits: the writer fills the back buffer and swaps it with the middle one, and
+  // the reader swaps the middle buffer with the front one only when a newer state was
+  // published in the meantime. States which were published in between are skipped
+  class StateBuffer {
+  public:
+    StateBuffer(unsigned size);
+
+    unsigned size() const;
+
+    void resize(unsigned size);
+
+    double* getBack();
+
+    void publish();
+
+    const double* acquire();
+
+  private:
+    // Marks the middle buffer as published but not acquired yet
+    static const unsigned FRESH = 4;
+    static const unsigned INDEX_MASK = 3;
+
+    std::vector<double> _buffers[3];
+    // Only used by the writer
+    unsigned _back;
+    // Only used by the reader
+    unsigned _front;
+    // The index of the buffer which is being handed over, along with the fresh bit
+    std::atomic<unsigned> _middle;
+  };
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../geometry/line.h"
+#include "../geometry/circle.h"
+#include "../geometry/trail_index.h"
+#include "../graphics/framebuffer.h"
+#include "world.h"
+#include "trail_canvas.h"
+
+namespace game {
+  constexpr double TrailCanvas::LINE_WIDTH;
+
+  // width - The width of the canvas the trails are drawn into, in pixels
+  // height - The height of the canvas the trails are drawn into, in pixels
+  // background - The color of the canvas once cleared
+  TrailCanvas::TrailCanvas(unsigned width, unsigned height, const graphics::Color& background):
+    _framebuffer(width, height),
+    _background(background) {
+    _framebuffer.clear(background);
+  }
+
+  unsigned TrailCanvas::getWidth() const {
+    return _framebuffer._width;
+  }
+
+  unsigned TrailCanvas::getHeight() const {
+    return _framebuffer._height;
+  }
+
+  // Sets the color of the snake with the given index. Snakes with no color of their own
+  // are drawn in white
+  void TrailCanvas::setColor(unsigned index, const graphics::Color& color) {
+    if (_colors.size() <= index) _colors.resize(index + 1, { 255, 255, 255, 255 });
+    _colors[index] = color;
+  }
+
+  // Clears the canvas and forgets what was drawn, e.g. once a new match has started
+  void TrailCanvas::clear() {
+    _framebuffer.clear(_background);
+    _progress.clear();
+  }
+
+  // Draws whatever the trails of the given world have gained since the last draw.
+  // Returns the number of pixels which were painted
+  unsigned TrailCanvas::draw(const World& world) {
+    unsigned painted = 0;
+
+    for (unsigned i = 0; i < world._snakes.size(); i++) {
+      graphics::Color color = i < _colors.size() ?
+        _colors[i] :
+        graphics::Color { 255, 255, 255, 255 };
+
+      painted += drawTrail(i, world._snakes[i]._trail, color);
+    }
+
+    return painted;
+  }
+
+  // Draws whatever the given trail has gained since it was last drawn under the same
+  // index. Trails only change at their end, where the last segment grows and new ones
+  // are appended
+  unsigned TrailCanvas::drawTrail(unsigned index, const geometry::TrailIndex& trail,
+      const graphics::Color& color) {
+    if (_progress.size() <= index) {
+      _progress.resize(index + 1, {
+        0, false, geometry::Line(0, 0, 0, 0), geometry::Circle(0, 0, 0, 0, 0)
+      });
+    }
+
+    Progress& progress = _progress[index];
+
+    // The trail has been started over
+    if (trail.size() < progress.count) progress.count = 0;
+
+    unsigned size = trail.size();
+    unsigned painted = 0;
+
+    if (progress.count != 0) painted += drawGrowth(progress, trail, color);
+
+    for (unsigned id = progress.count; id < size; id++) {
+      painted += drawSegment(trail, id, color);
+    }
+
+    if (size == 0) return painted;
+
+    progress.count = size;
+    progress.lastIsCircle = trail.isCircle(size - 1);
+
+    if (progress.lastIsCircle)
+      progress.lastCircle = trail.getCircle(size - 1);
+    else
+      progress.lastLine = trail.getLine(size - 1);
+
+    return painted;
+  }
+
+  // Draws the part which the last drawn segment has grown by. Lines grow from their second
+  // point onwards, and arcs grow from either one of their radians
+  unsigned TrailCanvas::drawGrowth(Progress& progress, const geometry::TrailIndex& trail,
+      const graphics::Color& color) {
+    unsigned id = progress.count - 1;
+
+    if (trail.isCircle(id) != progress.lastIsCircle) return drawSegment(trail, id, color);
+
+    if (!progress.lastIsCircle) {
+      const geometry::Line& line = trail.getLine(id);
+      const geometry::Line& last = progress.lastLine;
+
+      if (line._x1 != last._x1 || line._y1 != last._y1) return drawSegment(trail, id, color);
+
+      double from = std::hypot(last._x2 - last._x1, last._y2 - last._y1);
+      double to = std::hypot(line._x2 - line._x1, line._y2 - line._y1);
+
+      return _framebuffer.strokeLine(line, color, LINE_WIDTH, from, to);
+    }
+
+    const geometry::Circle& circle = trail.getCircle(id);
+    const geometry::Circle& last = progress.lastCircle;
+
+    if (circle._x != last._x || circle._y != last._y || circle._r != last._r) {
+      return drawSegment(trail, id, color);
+    }
+
+    double minRad = std::min(circle._rad1, circle._rad2);
+    double maxRad = std::max(circle._rad1, circle._rad2);
+    double lastMinRad = std::min(last._rad1, last._rad2);
+    double lastMaxRad = std::max(last._rad1, last._rad2);
+
+    return
+      _framebuffer.strokeArc(circle, color, LINE_WIDTH, minRad, std::min(lastMinRad, maxRad)) +
+      _framebuffer.strokeArc(circle, color, LINE_WIDTH, std::max(lastMaxRad, minRad), maxRad);
+  }
+
+  unsigned TrailCanvas::drawSegment(const geometry::TrailIndex& trail, unsigned id,
+      const graphics::Color& color) {
+    return trail.isCircle(id) ?
+      _framebuffer.strokeArc(trail.getCircle(id), color, LINE_WIDTH) :
+      _framebuffer.strokeLine(trail.getLine(id), color, LINE_WIDTH);
+  }
+}
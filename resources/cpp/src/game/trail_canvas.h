@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include "../geometry/line.h"
+#include "../geometry/circle.h"
+#include "../geometry/trail_index.h"
+#include "../graphics/framebuffer.h"
+#include "world.h"
+
+namespace game {
+  // Rasterizes the trails of a world into a framebuffer which is kept across frames.
+  // Only the shapes which were added or have grown since the last draw are painted,
+  // so the cost of a frame depends on how far the snakes went rather than on how long
+  // their trails are, and the buffer can be put as is into the canvas once drawn
+  class TrailCanvas {
+  public:
+    // The width of a trail's stroke, in pixels
+    static constexpr double LINE_WIDTH = 3;
+
+    graphics::Framebuffer _framebuffer;
+    graphics::Color _background;
+    std::vector<graphics::Color> _colors;
+
+    TrailCanvas(unsigned width, unsigned height, const graphics::Color& background);
+
+    unsigned getWidth() const;
+
+    unsigned getHeight() const;
+
+    void setColor(unsigned index, const graphics::Color& color);
+
+    void clear();
+
+    unsigned draw(const World& world);
+
+    unsigned drawTrail(unsigned index, const geometry::TrailIndex& trail,
+      const graphics::Color& color);
+
+  private:
+    // How much of a single trail has been drawn so far
+    struct Progress {
+      // The number of segments which were drawn, the last of which might still grow
+      unsigned count;
+      // The last drawn segment, as it was when it was drawn
+      bool lastIsCircle;
+      geometry::Line lastLine;
+      geometry::Circle lastCircle;
+    };
+
+    std::vector<Progress> _progress;
+
+    unsigned drawGrowth(Progress& progress, const geometry::TrailIndex& trail,
+      const graphics::Color& color);
+
+    unsigned drawSegment(const geometry::TrailIndex& trail, unsigned id,
+      const graphics::Color& color);
+  };
+}
@@ -0,0 +1,67 @@
+#include <memory>
+#include "../geometry/line.h"
+#include "../geometry/circle.h"
+#include "../geometry/trail_index.h"
+#include "../geometry/shape_batch.h"
+#include "trail_log.h"
+
+namespace game {
+  TrailLog::TrailLog(): _size(0) {
+  }
+
+  unsigned TrailLog::size() const {
+    return _size;
+  }
+
+  const double* TrailLog::getSegment(unsigned id) const {
+    return &_blocks[id / BLOCK_SIZE][(id % BLOCK_SIZE) * geometry::ShapeBatch::SHAPE_STRIDE];
+  }
+
+  // Returns the block with the given index, or null if it wasn't needed yet
+  const double* TrailLog::getBlock(unsigned index) const {
+    return _blocks[index].get();
+  }
+
+  // Appends the segments of the given trail from the end of the log up to the given
+  // count. Segments which were logged are never written again, so only segments which
+  // won't change anymore should be logged
+  void TrailLog::sync(const geometry::TrailIndex& trail, unsigned count) {
+    const unsigned stride = geometry::ShapeBatch::SHAPE_STRIDE;
+
+    for (; _size < count && _size < BLOCK_SIZE * MAX_BLOCKS; _size++) {
+      std::unique_ptr<double[]>& block = _blocks[_size / BLOCK_SIZE];
+      if (!block) block.reset(new double[BLOCK_SIZE * stride]);
+
+      writeSegment(trail, _size, &block[(_size % BLOCK_SIZE) * stride]);
+    }
+  }
+
+  // Empties the log, keeping its blocks for the next trail. Readers must not look at
+  // the log meanwhile
+  void TrailLog::clear() {
+    _size = 0;
+  }
+
+  // Writes the segment with the given id into the given shape descriptor
+  void TrailLog::writeSegment(const geometry::TrailIndex& trail, unsigned id,
+      double* descriptor) {
+    if (trail.isCircle(id)) {
+      const geometry::Circle& circle = trail.getCircle(id);
+      descriptor[0] = geometry::ShapeBatch::CIRCLE;
+      descriptor[1] = circle._x;
+      descriptor[2] = circle._y;
+      descriptor[3] = circle._r;
+      descriptor[4] = circle._rad1;
+      descriptor[5] = circle._rad2;
+    }
+    else {
+      const geometry::Line& line = trail.getLine(id);
+      descriptor[0] = geometry::ShapeBatch::LINE;
+      descriptor[1] = line._x1;
+      descriptor[2] = line._y1;
+      descriptor[3] = line._x2;
+      descriptor[4] = line._y2;
+      descriptor[5] = 0;
+    }
+  }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include "../geometry/trail_index.h"
+
+namespace game {
+  // An append-only copy of the stable segments of a trail, see Snake, written by a
+  // single thread while others read the segments which were published to them. Each
+  // segment is a shape descriptor laid out the same way as ShapeBatch's. Segments are
+  // kept in fixed blocks which are never moved, so appending never invalidates what
+  // readers might be looking at
+  class TrailLog {
+  public:
+    // The number of segments in each block
+    static const unsigned BLOCK_SIZE = 256;
+    // Segments beyond the last block are left out of the log
+    static const unsigned MAX_BLOCKS = 1024;
+
+    TrailLog();
+
+    unsigned size() const;
+
+    const double* getSegment(unsigned id) const;
+
+    const double* getBlock(unsigned index) const;
+
+    void sync(const geometry::TrailIndex& trail, unsigned count);
+
+    void clear();
+
+    static void writeSegment(const geometry::TrailIndex& trail, unsigned id, double* descriptor);
+
+  private:
+    std::unique_ptr<double[]> _blocks[MAX_BLOCKS];
+    unsigned _size;
+  };
+}
@@ -0,0 +1,485 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../stats.h"
+#include "../geometry/point.h"
+#include "../geometry/arena.h"
+#include "../geometry/shape_pool.h"
+#include "../geometry/sweep.h"
+#include "../geometry/trail_index.h"
+#include "../geometry/sweep_and_prune.h"
+#include "../geometry/occupancy_grid.h"
+#include "snake.h"
+#include "world.h"
+
+namespace game {
+  constexpr double World::TICK;
+  constexpr unsigned World::MAX_CATCH_UP;
+
+  constexpr unsigned World::MAX_SNAKES;
+  constexpr unsigned World::MAX_PACKED_SNAKES;
+
+  namespace {
+    // Left has priority over right, in case both are pressed
+    Direction getDirection(unsigned input) {
+      return
+        input & 1 ? Direction::LEFT :
+        input & 2 ? Direction::RIGHT :
+        Direction::NONE;
+    }
+  }
+
+  // width - The width of the canvas the snakes are moving on
+  // height - The height of the canvas the snakes are moving on
+  World::World(double width, double height):
+    _width(width),
+    _height(height),
+    _alive(0),
+    _lag(0),
+    _ticksPerStep(1),
+    _arena(width, height),
+    _occupancy(width, height) {
+  }
+
+  // Adds a snake with the given initial properties and returns its index. Each snake
+  // takes a bit of the alive bits, so a world can contain up to MAX_SNAKES snakes
+  unsigned World::addSnake(double x, double y, double r, double rad, double v) {
+    if (_snakes.size() >= MAX_SNAKES)
+      throw std::length_error("World::addSnake: a world can contain up to 64 snakes");
+
+    if (_spareSnakes.empty()) {
+      _snakes.push_back(Snake(x, y, r, rad, v));
+    }
+    else {
+      _snakes.push_back(std::move(_spareSnakes.back()));
+      _spareSnakes.pop_back();
+      _snakes.back().reset(x, y, r, rad, v);
+    }
+
+    unsigned index = _snakes.size() - 1;
+    _alive |= 1ull << index;
+    _inputs.push_back(0);
+
+    if (_shapeProxies.size() <= index) _shapeProxies.resize(index + 1);
+    _shapeProxies[index].clear();
+    syncBroadPhase(index);
+
+    if (_stampedCounts.size() <= index) _stampedCounts.resize(index + 1);
+    _stampedCounts[index] = 0;
+    syncOccupancy(index);
+
+    return index;
+  }
+
+  // Removes all the snakes at once, so a new match can be started. Snakes are recycled
+  // by the following matches, so a world which is kept for a whole session stops
+  // allocating memory once its trails have grown enough
+  void World::reset() {
+    while (!_snakes.empty()) {
+      _spareSnakes.push_back(std::move(_snakes.back()));
+      _snakes.pop_back();
+    }
+
+    _alive = 0;
+    _lag = 0;
+    _inputs.clear();
+    _broadPhase.clear();
+    _occupancy.clear();
+  }
+
+  // Sums up the shape pools of all the snakes, including the spare ones
+  geometry::ShapePoolStats World::getShapeStats() const {
+    geometry::ShapePoolStats stats = { 0, 0, 0, 0, 0 };
+
+    for (const std::vector<Snake>* snakes : { &_snakes, &_spareSnakes }) {
+      for (const Snake& snake : *snakes) {
+        geometry::ShapePoolStats snakeStats = snake._trail.getShapeStats();
+        stats.allocations += snakeStats.allocations;
+        stats.live += snakeStats.live;
+        stats.capacity += snakeStats.capacity;
+        stats.growths += snakeStats.growths;
+        stats.resets += snakeStats.resets;
+      }
+    }
+
+    return stats;
+  }
+
+  // Mirrors the changes of a snake's trail and last bit in the broad phase. Trails only
+  // change at their end, so segments which were mirrored before are left as they are
+  void World::syncBroadPhase(unsigned index) {
+    Snake& snake = _snakes.at(index);
+    geometry::TrailIndex& trail = snake._trail;
+    std::vector<unsigned>& proxies = _shapeProxies.at(index);
+    unsigned size = trail.size();
+
+    for (unsigned id = trail.getDirtyFrom(); id < size && id < proxies.size(); id++) {
+      _broadPhase.updateShape(proxies[id], trail.getBox(id));
+    }
+
+    while (proxies.size() > size) {
+      _broadPhase.removeShape(proxies.back());
+      proxies.pop_back();
+    }
+
+    while (proxies.size() < size) {
+      unsigned id = proxies.size();
+      proxies.push_back(_broadPhase.addShape(trail.getBox(id), index, id));
+    }
+
+    trail.clearDirty();
+    _broadPhase.setQuery(index, snake.getLastBitBox().expand(1));
+  }
+
+  // Stamps the segments of a snake's trail which have become stable into the occupancy
+  // grid. Later segments might still grow, and they're connected to the snake's own last
+  // bit anyway, so they're left to the exact tests. Stamps only ever grow: stable
+  // segments never change, and segments which are dropped by a restore keep their bits
+  // until the grid is cleared. So the grid covers at least the current stable segments,
+  // and only serves as a conservative prefilter ahead of the exact tests
+  void World::syncOccupancy(unsigned index) {
+    const Snake& snake = _snakes.at(index);
+    const geometry::TrailIndex& trail = snake._trail;
+    unsigned& stamped = _stampedCounts.at(index);
+
+    for (unsigned stable = snake.getStableShapesCount(); stamped < stable; stamped++) {
+      if (trail.isCircle(stamped))
+        _occupancy.stamp(trail.getCircle(stamped), index);
+      else
+        _occupancy.stamp(trail.getLine(stamped), index);
+    }
+  }
+
+  // Progresses all the snakes which are still in the game and disqualifies the ones
+  // which intersected with themselves or with an opponent. All the snakes are moved
+  // before any of them is tested, and disqualifications are applied at once, so
+  // snakes which hit each other during the same step are treated the same no matter
+  // in what order they are stored or the broad phase has paired them
+  StepStatus World::step(double span) {
+    STATS_SCOPE(WORLD_STEP);
+    unsigned long long eliminated = 0;
+
+    for (unsigned i = 0; i < _snakes.size(); i++) {
+      if (!(_alive & (1ull << i))) continue;
+
+      Snake& snake = _snakes.at(i);
+      snake.update(span, getDirection(_inputs[i]), _arena);
+      syncBroadPhase(i);
+      syncOccupancy(i);
+
+      // Disqualify if turned for a whole circle
+      if (snake.hasFullTurn()) eliminated |= 1ull << i;
+    }
+
+    const std::vector<geometry::BroadPhasePair>* pairs;
+
+    {
+      STATS_SCOPE(BROAD_PHASE);
+      pairs = &_broadPhase.getPairs();
+    }
+
+    // Candidate pairs are tested exactly. A snake's own segments which are connected
+    // to its last bit would always intersect with it, so they're ignored. Stable
+    // segments can only be hit by a last bit which shares a cell with their owner,
+    // and pairs are sorted by query, so the cells are looked up once per query
+    {
+      STATS_SCOPE(NARROW_PHASE);
+      int query = -1;
+      unsigned long long owners = 0;
+
+      for (const geometry::BroadPhasePair& pair : *pairs) {
+        if (eliminated & (1ull << pair.query)) continue;
+
+        const Snake& snake = _snakes.at(pair.query);
+        const geometry::TrailIndex& trail = _snakes.at(pair.owner)._trail;
+
+        if (pair.owner == pair.query && pair.segment + Snake::CONNECTED_SHAPES >= trail.size()) continue;
+
+        if ((int) pair.query != query) {
+          query = pair.query;
+          owners = _occupancy.getOwners(snake.getLastBitBox());
+        }
+
+        if (pair.segment < _stampedCounts.at(pair.owner) && !(owners & (1ull << pair.owner))) {
+          STATS_COUNT(OCCUPANCY_REJECTS);
+          continue;
+        }
+
+        if (snake.hitsSegment(trail, pair.segment)) eliminated |= 1ull << pair.query;
+      }
+    }
+
+    // Disqualified snakes are neither moved nor hit from now on
+    for (unsigned i = 0; i < _snakes.size(); i++) {
+      if (!(eliminated & (1ull << i))) continue;
+
+      _broadPhase.removeQuery(i);
+      _broadPhase.removeOwner(i);
+      _shapeProxies.at(i).clear();
+    }
+
+    _alive &= ~eliminated;
+
+    unsigned aliveCount = 0;
+    for (unsigned i = 0; i < _snakes.size(); i++) {
+      if (_alive & (1ull << i)) aliveCount++;
+    }
+
+    return { _alive, eliminated, aliveCount };
+  }
+
+  // Steps the world with the given input bits, see setInputBits()
+  StepStatus World::step(double span, unsigned inputBits) {
+    setInputBits(inputBits);
+    return step(span);
+  }
+
+  // Sets the input of a single snake, which is held for the following steps until it's
+  // set again. The first bit stands for a left turn and the second for a right turn
+  void World::setInput(unsigned index, unsigned input) {
+    _inputs.at(index) = input & 3;
+  }
+
+  // Sets the input of the first MAX_PACKED_SNAKES snakes at once, from a bit field with
+  // 2 bits per snake. The snakes which follow keep the input they were last set
+  void World::setInputBits(unsigned inputBits) {
+    unsigned count = std::min<unsigned>(_snakes.size(), MAX_PACKED_SNAKES);
+
+    for (unsigned i = 0; i < count; i++) _inputs[i] = (inputBits >> (i * 2)) & 3;
+  }
+
+  // Saves the state of all the snakes into the given snapshot, reusing its memory
+  void World::save(WorldSnapshot& snapshot) const {
+    snapshot.alive = _alive;
+    snapshot.lag = _lag;
+    snapshot.snakes.resize(_snakes.size());
+
+    for (unsigned i = 0; i < _snakes.size(); i++) _snakes[i].save(snapshot.snakes[i]);
+  }
+
+  // Puts the world back into a state it was saved in during the current match, e.g. to
+  // re-simulate the ticks since then with corrected input. Only the shapes which were
+  // added since are mirrored again, unless a snake is brought back into the game.
+  // Stamps of shapes which were taken back are left in the occupancy grid; they only
+  // keep a few pairs from being rejected early, so they're cleared with the match
+  void World::restore(const WorldSnapshot& snapshot) {
+    if (snapshot.snakes.size() != _snakes.size())
+      throw std::invalid_argument("World::restore: snakes count mismatch");
+
+    _alive = snapshot.alive;
+    _lag = snapshot.lag;
+
+    for (unsigned i = 0; i < _snakes.size(); i++) _snakes[i].restore(snapshot.snakes[i]);
+
+    resync();
+  }
+
+  // Mirrors the snakes in the broad phase and the occupancy grid once their state was
+  // put back from outside of the step, e.g. by restore() or out of a replay. Snakes
+  // which are out of the game are dropped from the broad phase, and the trails of the
+  // rest are mirrored from where they have changed
+  void World::resync() {
+    for (unsigned i = 0; i < _snakes.size(); i++) {
+      if (!(_alive & (1ull << i))) {
+        _broadPhase.removeQuery(i);
+
+        if (!_shapeProxies[i].empty()) {
+          _broadPhase.removeOwner(i);
+          _shapeProxies[i].clear();
+        }
+
+        continue;
+      }
+
+      _stampedCounts[i] = std::min(_stampedCounts[i], _snakes[i].getStableShapesCount());
+      syncBroadPhase(i);
+      syncOccupancy(i);
+    }
+  }
+
+  // Steps the world in fixed ticks for the given elapsed time, carrying the remainder
+  // over to the next call. Unlike stepping with wall-clock spans, the outcome depends
+  // on nothing but the input bits of each tick, so matches can be reproduced exactly.
+  // Once more than a single tick per step is allowed, runs of ticks which are clear of
+  // any impact only have their first and last ticks stepped, while the ones in between
+  // are moved without being tested. The snakes are moved tick by tick either way, so
+  // they end up exactly where ticks alone would have taken them. The returned status
+  // covers all the ticks which were made
+  StepStatus World::advance(double elapsed) {
+    _lag = std::min(_lag + elapsed, MAX_CATCH_UP * TICK);
+
+    StepStatus status = { _alive, 0, 0 };
+
+    while (_lag >= TICK) {
+      // The lag is taken a tick at a time, so it's left with the exact same remainder
+      double lag = _lag - TICK;
+      unsigned ticks = 1;
+
+      while (ticks < _ticksPerStep && lag >= TICK) {
+        lag -= TICK;
+        ticks++;
+      }
+
+      // Runs of 2 ticks have no ticks in between to move
+      if (ticks > 2 && isClear(ticks * TICK)) {
+        _lag = lag;
+      }
+      else {
+        ticks = 1;
+        _lag -= TICK;
+      }
+
+      // The first tick tests the bit which leads up to the heads, ahead of the paths
+      // which isClear() has timed, so it's stepped either way
+      unsigned long long eliminated = status.eliminated;
+      status = step(TICK);
+      status.eliminated |= eliminated;
+
+      if (ticks > 1) {
+        move(ticks - 2);
+
+        eliminated = status.eliminated;
+        status = step(TICK);
+        status.eliminated |= eliminated;
+      }
+    }
+
+    status.aliveCount = 0;
+    for (unsigned i = 0; i < _snakes.size(); i++) {
+      if (_alive & (1ull << i)) status.aliveCount++;
+    }
+
+    return status;
+  }
+
+  // Advances the world with the given input bits, see setInputBits()
+  StepStatus World::advance(double elapsed, unsigned inputBits) {
+    setInputBits(inputBits);
+    return advance(elapsed);
+  }
+
+  // Lets advance() make up to the given number of ticks at once, see isClear(). A single
+  // tick per step, which is the default, tests every tick
+  void World::setTicksPerStep(unsigned ticks) {
+    if (ticks == 0 || ticks > MAX_CATCH_UP)
+      throw std::out_of_range("World::setTicksPerStep: ticks must be between 1 and MAX_CATCH_UP");
+
+    _ticksPerStep = ticks;
+  }
+
+  // Whether the ticks which make up the given span could be made without testing any of
+  // them but the first and the last. They could, as long as no snake turns another way,
+  // which would add a shape, or comes close to turning for a whole circle or to an edge,
+  // and as long as no head would run into a trail or come close to the path of another
+  // head. The paths of the heads are timed against the trails, see getImpact()
+  bool World::isClear(double span) {
+    auto isInside = [this](const geometry::Box& box) {
+      return box.minX > geometry::BOX_TOLERANCE && box.minY > geometry::BOX_TOLERANCE &&
+        box.maxX < _width - geometry::BOX_TOLERANCE && box.maxY < _height - geometry::BOX_TOLERANCE;
+    };
+
+    _sweepBoxes.clear();
+
+    for (unsigned i = 0; i < _snakes.size(); i++) {
+      if (!(_alive & (1ull << i))) continue;
+
+      const Snake& snake = _snakes.at(i);
+      Direction direction = getDirection(_inputs[i]);
+      if (direction != snake._direction) return false;
+
+      geometry::Sweep sweep = snake.getSweep(span, direction);
+      const geometry::Circle& circle = snake._currentCircle;
+      double turned = std::abs(circle._rad1 - circle._rad2) + (sweep.getStep() / snake._r);
+      if (snake._currentIsCircle && turned >= 2 * M_PI) return false;
+
+      const geometry::Box& path = sweep.getBox();
+      if (!isInside(path)) return false;
+
+      for (const geometry::Box& box : _sweepBoxes) {
+        if (path.overlaps(box, 1)) return false;
+      }
+
+      if (getImpact(i, sweep).hasValue()) return false;
+
+      _sweepBoxes.push_back(path);
+    }
+
+    return true;
+  }
+
+  // Moves the snakes which are still in the game by the given number of ticks, without
+  // testing them, see isClear(). Trails report their changes until they're cleared, so
+  // the broad phase catches up with all of them on the next step
+  void World::move(unsigned ticks) {
+    for (unsigned i = 0; i < _snakes.size(); i++) {
+      if (_alive & (1ull << i)) _snakes[i].move(TICK, ticks);
+    }
+  }
+
+  // Casts a ray from the given point for each of the given angles, e.g. so a bot could
+  // look around, and fills the given hits with the nearest shape each ray meets within
+  // the given distance. Rays which meet nothing are reported with a -1 snake. Only
+  // snakes which are still in the game are seen, and the snake given by "skipSnake"
+  // doesn't see the shapes which are connected to its own head
+  void World::castRays(double x, double y, const double* angles, unsigned count,
+      double maxDistance, geometry::RayHit* hits, int skipSnake) {
+    STATS_SCOPE(RAY_CAST);
+
+    if (!std::isfinite(maxDistance) || maxDistance < 0) {
+      throw std::invalid_argument("World::castRays: maxDistance must be finite and non-negative");
+    }
+
+    _rayDirections.resize(count);
+
+    for (unsigned i = 0; i < count; i++) {
+      _rayDirections[i] = { std::cos(angles[i]), std::sin(angles[i]) };
+      hits[i] = { maxDistance, -1, -1 };
+    }
+
+    geometry::Point origin = { x, y };
+
+    for (unsigned i = 0; i < _snakes.size(); i++) {
+      if (!(_alive & (1ull << i))) continue;
+
+      unsigned skip = (int) i == skipSnake ? Snake::CONNECTED_SHAPES : 0;
+      _snakes.at(i)._trail.castRays(origin, _rayDirections.data(), count, hits, i, skip);
+    }
+  }
+
+  // Returns the earliest impact the given snake would make during a step with the given
+  // span and its current input, against the trails of the snakes which are still in the
+  // game and against the edges of the arena. Unlike a regular step, which only tests the
+  // last bit once it was made, the whole path is timed, so advance() can tell whether a
+  // run of ticks could be made without testing each of them, see isClear(). A time of 1
+  // with no segment and no edges means the step is clear
+  geometry::Impact World::getImpact(unsigned index, double span) {
+    const Snake& snake = _snakes.at(index);
+    return getImpact(index, snake.getSweep(span, getDirection(_inputs[index])));
+  }
+
+  // The same, only with the input of the given input bits, see setInputBits(). Snakes
+  // which aren't covered by the bits are swept with their current input
+  geometry::Impact World::getImpact(unsigned index, double span, unsigned inputBits) {
+    const Snake& snake = _snakes.at(index);
+    unsigned input = index < MAX_PACKED_SNAKES ? (inputBits >> (index * 2)) & 3 : _inputs.at(index);
+    return getImpact(index, snake.getSweep(span, getDirection(input)));
+  }
+
+  // Times the given path of a snake's head against the trails and the edges
+  geometry::Impact World::getImpact(unsigned index, const geometry::Sweep& sweep) {
+    geometry::Impact impact = { 1, -1, -1, 0 };
+
+    for (unsigned i = 0; i < _snakes.size(); i++) {
+      if (!(_alive & (1ull << i))) continue;
+
+      unsigned skip = i == index ? Snake::CONNECTED_SHAPES : 0;
+      _snakes.at(i)._trail.sweep(sweep, impact, i, skip);
+    }
+
+    _arena.sweep(sweep, impact);
+
+    return impact;
+  }
+}
\ No newline at end of file
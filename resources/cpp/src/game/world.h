@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include "../geometry/point.h"
+#include "../geometry/arena.h"
+#include "../geometry/shape_pool.h"
+#include "../geometry/sweep.h"
+#include "../geometry/trail_index.h"
+#include "../geometry/sweep_and_prune.h"
+#include "../geometry/occupancy_grid.h"
+#include "snake.h"
+
+namespace game {
+  // The outcome of a single world step
+  struct StepStatus {
+    // A bit for each snake which is still in the game
+    unsigned long long alive;
+    // A bit for each snake which was disqualified during this step
+    unsigned long long eliminated;
+    unsigned aliveCount;
+  };
+
+  // The state of a world as it was at some point, see World::save()
+  struct WorldSnapshot {
+    unsigned long long alive;
+    double lag;
+    std::vector<SnakeSnapshot> snakes;
+  };
+
+  // Holds all the snakes of a match and steps them all at once.
+  // Input is held for each snake, see setInput(), where the first bit stands for a left
+  // turn and the second bit stands for a right turn. The input of the first few snakes
+  // can be provided at once as a bit field with 2 bits per snake, see setInputBits()
+  class World {
+  public:
+    // The most snakes a world can contain, one for each of the alive bits
+    static constexpr unsigned MAX_SNAKES = 64;
+    // The number of snakes which fit into the input bits
+    static constexpr unsigned MAX_PACKED_SNAKES = 16;
+    // The span of a single fixed tick, in milliseconds
+    static constexpr double TICK = 1000.0 / 60;
+    // The most ticks a single advance would catch up with, e.g. after the page was
+    // in the background for a while
+    static constexpr unsigned MAX_CATCH_UP = 10;
+
+    double _width;
+    double _height;
+    unsigned long long _alive;
+    double _lag;
+    // The most ticks advance() would make at once, see isClear()
+    unsigned _ticksPerStep;
+    geometry::Arena _arena;
+    std::vector<Snake> _snakes;
+    // Snakes of previous matches, kept along with their memory for the next ones
+    std::vector<Snake> _spareSnakes;
+    // The input of each snake, held until it's set again
+    std::vector<unsigned> _inputs;
+    // The directions of the most recent ray cast, kept so casts won't allocate memory
+    std::vector<geometry::Point> _rayDirections;
+    // The paths of the heads which were found clear so far, kept for the same reason
+    std::vector<geometry::Box> _sweepBoxes;
+    // Pairs the last bits of the snakes with the segments of the trails they're close to
+    geometry::SweepAndPrune _broadPhase;
+    // The broad phase proxies of each snake's segments, by segment id
+    std::vector<std::vector<unsigned>> _shapeProxies;
+    // The cells each snake's stable segments pass through, which rules out most of the
+    // broad phase pairs before they're tested exactly
+    geometry::OccupancyGrid _occupancy;
+    // The number of leading segments of each snake which were stamped into the grid
+    std::vector<unsigned> _stampedCounts;
+
+    World(double width, double height);
+
+    unsigned addSnake(double x, double y, double r, double rad, double v);
+
+    void reset();
+
+    geometry::ShapePoolStats getShapeStats() const;
+
+    void setInput(unsigned index, unsigned input);
+
+    void setInputBits(unsigned inputBits);
+
+    StepStatus step(double span);
+
+    StepStatus step(double span, unsigned inputBits);
+
+    StepStatus advance(double elapsed);
+
+    StepStatus advance(double elapsed, unsigned inputBits);
+
+    void setTicksPerStep(unsigned ticks);
+
+    void castRays(double x, double y, const double* angles, unsigned count,
+      double maxDistance, geometry::RayHit* hits, int skipSnake = -1);
+
+    geometry::Impact getImpact(unsigned index, double span);
+
+    geometry::Impact getImpact(unsigned index, double span, unsigned inputBits);
+
+    void save(WorldSnapshot& snapshot) const;
+
+    void restore(const WorldSnapshot& snapshot);
+
+    void resync();
+
+  private:
+    void syncBroadPhase(unsigned index);
+
+    void syncOccupancy(unsigned index);
+
+    geometry::Impact getImpact(unsigned index, const geometry::Sweep& sweep);
+
+    bool isClear(double span);
+
+    void move(unsigned ticks);
+  };
+}
\ No newline at end of file
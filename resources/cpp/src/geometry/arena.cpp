@@ -0,0 +1,109 @@
+#include "../utils.h"
+#include "box.h"
+#include "point.h"
+#include "intersection.h"
+#include "line.h"
+#include "circle.h"
+#include "sweep.h"
+#include "arena.h"
+
+namespace geometry {
+  // width - The width of the arena, starting at 0
+  // height - The height of the arena, starting at 0
+  Arena::Arena(double width, double height):
+    _edges {
+      Line(0, 0, width, 0),
+      Line(width, 0, width, height),
+      Line(width, height, 0, height),
+      Line(0, height, 0, 0)
+    },
+    _width(width),
+    _height(height) {
+  }
+
+  // Returns all the points where the given bit meets the edges, in the order of the
+  // edges, and wraps its head along each axis whose edges it has crossed
+  template <typename T>
+  Crossing Arena::cross(const T& bit, const Point& head) const {
+    // Points are left uninitialized, since most bits don't cross anything
+    Crossing crossing;
+    crossing.edges = 0;
+    crossing.pointsCount = 0;
+    crossing.head = head;
+
+    // Intersection methods reject boxes which are further than the tolerance apart,
+    // so this gives the exact same result, only without running them
+    const Box& box = bit.getBox();
+    if (box.minX > BOX_TOLERANCE && box.minY > BOX_TOLERANCE &&
+        box.maxX < _width - BOX_TOLERANCE && box.maxY < _height - BOX_TOLERANCE) {
+      return crossing;
+    }
+
+    for (unsigned i = 0; i < 4; i++) {
+      Intersection intersection = bit.getIntersection(_edges[i]);
+      if (intersection.isNull()) continue;
+
+      crossing.edges |= 1u << i;
+
+      for (const Point& point : intersection) {
+        crossing.points[crossing.pointsCount++] = point;
+      }
+    }
+
+    if (!crossing.hasValue()) return crossing;
+
+    // A bit which passes by a corner only meets one of its edges, while its head ends
+    // up beyond both of them
+    if (head.x < 0) crossing.edges |= LEFT;
+    if (head.x > _width) crossing.edges |= RIGHT;
+    if (head.y < 0) crossing.edges |= TOP;
+    if (head.y > _height) crossing.edges |= BOTTOM;
+
+    if (crossing.edges & (LEFT | RIGHT))
+      crossing.head.x = utils::mod(head.x - _width, _width);
+    if (crossing.edges & (TOP | BOTTOM))
+      crossing.head.y = utils::mod(head.y - _height, _height);
+
+    return crossing;
+  }
+
+  // head - The point the bit ends at
+  Crossing Arena::getCrossing(const Line& bit, const Point& head) const {
+    return cross(bit, head);
+  }
+
+  Crossing Arena::getCrossing(const Circle& bit, const Point& head) const {
+    return cross(bit, head);
+  }
+
+  // Records the edges the given sweep meets, in case they're met before the current
+  // impact, so a long step can be split where the head should wrap around. A head which
+  // starts off right on an edge, e.g. once it was wrapped, doesn't meet it again
+  void Arena::sweep(const Sweep& sweep, Impact& impact) const {
+    const Box& box = sweep.getBox();
+    if (box.minX > BOX_TOLERANCE && box.minY > BOX_TOLERANCE &&
+        box.maxX < _width - BOX_TOLERANCE && box.maxY < _height - BOX_TOLERANCE) {
+      return;
+    }
+
+    if (sweep.getStep() <= 0) return;
+
+    double startTime = BOX_TOLERANCE / sweep.getStep();
+
+    for (unsigned i = 0; i < 4; i++) {
+      Intersection intersection = sweep.isTurning() ?
+        sweep.getCircle().getIntersection(_edges[i]) :
+        sweep.getLine().getIntersection(_edges[i]);
+
+      for (const Point& point : intersection) {
+        double time = sweep.getTime(point);
+        if (time <= startTime) continue;
+
+        if (time < impact.time)
+          impact = { time, -1, -1, 1u << i };
+        else if (time == impact.time && impact.segment == -1)
+          impact.edges |= 1u << i;
+      }
+    }
+  }
+}
\ No newline at end of file
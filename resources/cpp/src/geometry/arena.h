@@ -0,0 +1,57 @@
+#pragma once
+
+#include "box.h"
+#include "point.h"
+#include "line.h"
+#include "circle.h"
+#include "sweep.h"
+
+namespace geometry {
+  class Line;
+  class Circle;
+
+  // The way a bit of movement has met the bounds of an arena
+  struct Crossing {
+    // A bit for each edge which was crossed, see Arena
+    unsigned edges;
+    // The points where the bit meets the edges, which is where its shape should be
+    // split. Each shape meets each edge at 2 points at most
+    unsigned pointsCount;
+    Point points[8];
+    // The position of the bit's head, wrapped around to the other side of the arena
+    // along each axis whose edges were met
+    Point head;
+
+    bool hasValue() const {
+      return edges != 0;
+    }
+  };
+
+  // The rectangular bounds of a match, which snakes wrap around. The edges are built
+  // once, and bits which are well within the bounds are told apart by their bounding
+  // boxes alone, so most queries don't run any intersection at all
+  class Arena {
+  private:
+    Line _edges[4];
+
+    template <typename T>
+    Crossing cross(const T& bit, const Point& head) const;
+
+  public:
+    static const unsigned TOP = 1;
+    static const unsigned RIGHT = 2;
+    static const unsigned BOTTOM = 4;
+    static const unsigned LEFT = 8;
+
+    double _width;
+    double _height;
+
+    Arena(double width, double height);
+
+    Crossing getCrossing(const Line& bit, const Point& head) const;
+
+    Crossing getCrossing(const Circle& bit, const Point& head) const;
+
+    void sweep(const Sweep& sweep, Impact& impact) const;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "line.h"
+#include "circle.h"
+#include "fixed_line.h"
+#include "fixed_circle.h"
+
+namespace geometry {
+  // The shapes of the double backend, where coordinates are doubles trimmed to 9
+  // decimals. Code which can run on either backend takes it as a template parameter,
+  // e.g. ShapeList<FixedBackend>, and refers to its shapes through it
+  struct DoubleBackend {
+    typedef geometry::Line LineType;
+    typedef geometry::Circle CircleType;
+  };
+
+  // The shapes of the fixed-point backend, where coordinates are nano unit integers
+  struct FixedBackend {
+    typedef geometry::FixedLine LineType;
+    typedef geometry::FixedCircle CircleType;
+  };
+}
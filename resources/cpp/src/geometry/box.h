@@ -0,0 +1,29 @@
+#pragma once
+
+#include <algorithm>
+
+namespace geometry {
+  // Intersection points are trimmed to 9 decimals, so they might slightly exceed the
+  // boxes of the shapes they were calculated for. Boxes are compared with this
+  // tolerance whenever an exact intersection result depends on it
+  constexpr double BOX_TOLERANCE = 1e-6;
+
+  // An axis aligned bounding box, used to quickly tell whether two shapes are
+  // even close enough to intersect
+  struct Box {
+    double minX;
+    double minY;
+    double maxX;
+    double maxY;
+
+    bool overlaps(const Box& box, double tolerance = 0) const {
+      return minX <= box.maxX + tolerance && box.minX <= maxX + tolerance &&
+             minY <= box.maxY + tolerance && box.minY <= maxY + tolerance;
+    }
+
+    // Grows the box in all directions by the given amount
+    Box expand(double amount) const {
+      return { minX - amount, minY - amount, maxX + amount, maxY + amount };
+    }
+  };
+}
\ No newline at end of file
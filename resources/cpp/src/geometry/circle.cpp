@@ -1,104 +1,245 @@
 #include <algorithm>
 #include <cmath>
-#include <vector>
-#include <emscripten/bind.h>
-#include <emscripten/val.h>
 #include "../nullable.h"
 #include "../utils.h"
+#include "../stats.h"
+#include "box.h"
 #include "point.h"
+#include "intersection.h"
 #include "line.h"
 
 namespace geometry {
+  // Directions which deviate from an arc by less than this many radians are still
+  // considered a part of it, since all radians are trimmed to 9 decimals
+  static constexpr double ANGLE_TOLERANCE = 1e-9;
+
   // x - The x value of the circle's center
   // y - The y value of the circle's center
   // r - The radius of the center
   // rad1 - The first radian of the circle, not necessarily its beginning
   // rad2 - The second radian of the circle, not necessarily its beginning
   Circle::Circle(double x, double y, double r, double rad1, double rad2) {
-    _x = utils::trim(x, 9);
-    _y = utils::trim(y, 9);
-    _r = utils::trim(r, 9);
+    _x = utils::trim<utils::Round::ROUND, 9>(x);
+    _y = utils::trim<utils::Round::ROUND, 9>(y);
+    _r = utils::trim<utils::Round::ROUND, 9>(r);
 
     // Trimming mode is done based on which radian represents the ending and which radian
     // represents the ending
     if (rad1 > rad2) {
-      _rad1 = utils::trim(rad1, 9, "floor");
-      _rad2 = utils::trim(rad2, 9, "ceil");
+      _rad1 = utils::trim<utils::Round::FLOOR, 9>(rad1);
+      _rad2 = utils::trim<utils::Round::CEIL, 9>(rad2);
     }
     else {
-      _rad1 = utils::trim(rad1, 9, "ceil");
-      _rad2 = utils::trim(rad2, 9, "floor");
+      _rad1 = utils::trim<utils::Round::CEIL, 9>(rad1);
+      _rad2 = utils::trim<utils::Round::FLOOR, 9>(rad2);
     }
+
+    updateArc();
+  }
+
+  double Circle::getX() const {
+    return _x;
+  }
+
+  double Circle::getY() const {
+    return _y;
+  }
+
+  double Circle::getR() const {
+    return _r;
+  }
+
+  double Circle::getRad1() const {
+    return _rad1;
+  }
+
+  double Circle::getRad2() const {
+    return _rad2;
+  }
+
+  void Circle::setX(double x) {
+    _x = x;
+    updateBox();
+  }
+
+  void Circle::setY(double y) {
+    _y = y;
+    updateBox();
+  }
+
+  void Circle::setR(double r) {
+    _r = r;
+    updateBox();
+  }
+
+  void Circle::setRad1(double rad1) {
+    _rad1 = rad1;
+    updateArc();
+  }
+
+  void Circle::setRad2(double rad2) {
+    _rad2 = rad2;
+    updateArc();
   }
 
   // Gets the matching x value for the given radian
-  Nullable<double> Circle::getMatchingX(double rad) {
-    if (!utils::chain(rad)->trim(9)->isBetween(_rad1, _rad2)->result()) {
+  Nullable<double> Circle::getMatchingX(double rad) const {
+    if (!utils::chain(rad).trim<utils::Round::ROUND, 9>().isBetween(_rad1, _rad2).result()) {
       return Nullable<double>();
     }
 
-    return Nullable<double>(utils::trim((_r * std::cos(rad)) + _x, 9));
+    return Nullable<double>(utils::trim<utils::Round::ROUND, 9>((_r * std::cos(rad)) + _x));
   }
 
   // Gets the matching y value for the given radian
-  Nullable<double> Circle::getMatchingY(double rad) {
-    if (!utils::chain(rad)->trim(9)->isBetween(_rad1, _rad2)->result()) {
+  Nullable<double> Circle::getMatchingY(double rad) const {
+    if (!utils::chain(rad).trim<utils::Round::ROUND, 9>().isBetween(_rad1, _rad2).result()) {
       return Nullable<double>();
     }
 
-    return Nullable<double>(utils::trim((_r * std::sin(rad)) + _y, 9));
+    return Nullable<double>(utils::trim<utils::Round::ROUND, 9>((_r * std::sin(rad)) + _y));
   }
 
   // Gets the matching point for the given radian
-  Nullable<Point> Circle::getMatchingPoint(double rad) {
-    if (!utils::isBetween(rad, _rad1, _rad2)) {
+  Nullable<Point> Circle::getMatchingPoint(double rad) const {
+    if (!utils::isBetween<utils::Precision::EXACT>(rad, _rad1, _rad2)) {
       return Nullable<Point>();
     }
 
     return Nullable<Point>({
-      utils::trim((_r * std::cos(rad)) + _x, 9),
-      utils::trim((_r * std::sin(rad)) + _y, 9)
+      utils::trim<utils::Round::ROUND, 9>((_r * std::cos(rad)) + _x),
+      utils::trim<utils::Round::ROUND, 9>((_r * std::sin(rad)) + _y)
     });
   }
 
   // Gets the matching radian for the given point
-  Nullable<double> Circle::getMatchingRad(double x, double y) {
-    double rad = std::atan2(y - _y, x - _x);
+  Nullable<double> Circle::getMatchingRad(double x, double y) const {
+    STATS_COUNT(MATCHING_RAD_CALLS);
+
+    if (!hasPoint(x, y)) return Nullable<double>();
 
-    // If calculated radian is in circle's radian range, return it
-    if (!std::isnan(rad) && utils::isBetween(rad, _rad1, _rad2)) {
-      return Nullable<double>(rad);
+    return Nullable<double>(std::atan2(y - _y, x - _x));
+  }
+
+  // Returns if circle has given points, meaning the direction from the circle's center
+  // to the point is within the arc's sweep. This is decided by the signs of the cross
+  // products with the arc's end vectors, so no trigonometry is involved, and arcs which
+  // have wound several full turns are handled as whole circles
+  bool Circle::hasPoint(double x, double y) const {
+    double dx = x - _x;
+    double dy = y - _y;
+
+    if (std::isnan(dx) || std::isnan(dy)) return false;
+    if (_sweep >= 2 * M_PI) return true;
+
+    double tolerance = ANGLE_TOLERANCE * std::sqrt((dx * dx) + (dy * dy));
+    // Positive when the direction is counter clockwise to the arc's start
+    double fromStart = (_startX * dy) - (_startY * dx);
+    // Positive when the direction is clockwise to the arc's end
+    double toEnd = (dx * _endY) - (dy * _endX);
+
+    // An arc of up to a half circle is the intersection of both half planes, on the
+    // side of its middle
+    if (_sweep <= M_PI) {
+      return fromStart >= -tolerance && toEnd >= -tolerance &&
+             (dx * (_startX + _endX)) + (dy * (_startY + _endY)) >= 0;
     }
 
-    // The calculated radian can still be in the circle's radian range in case one
-    // of the radians is greater than 2 PIEs
-    double greatestRad = std::abs(_rad1) > std::abs(_rad2) ? _rad1 : _rad2;
+    // A greater arc is the union of both half planes
+    return fromStart >= -tolerance || toEnd >= -tolerance;
+  }
+
+  // Returns the distance from the given origin along the given direction, which is
+  // expected to be a unit vector, until the ray hits the arc. Both points where the
+  // ray meets the whole circle are tried, nearest first
+  Nullable<double> Circle::getRayDistance(const Point& origin, const Point& direction) const {
+    double fx = origin.x - _x;
+    double fy = origin.y - _y;
+    double b = (fx * direction.x) + (fy * direction.y);
+    double delta = (b * b) - ((fx * fx) + (fy * fy) - (_r * _r));
+
+    if (delta < 0) return Nullable<double>();
+
+    double root = std::sqrt(delta);
 
-    // Check if the absolute radian is in the circle's radian range
-    if (utils::chain(rad + (2 * M_PI * std::floor(greatestRad / (2 * M_PI))))
-        ->trim(9)->isBetween(_rad1, _rad2)->result() ||
-        utils::chain(rad + (2 * M_PI * std::ceil(greatestRad / (2 * M_PI))))
-        ->trim(9)->isBetween(_rad1, _rad2)->result()) {
-      return Nullable<double>(rad);
+    for (double distance : { -b - root, -b + root }) {
+      if (distance < 0) continue;
+
+      double x = origin.x + (distance * direction.x);
+      double y = origin.y + (distance * direction.y);
+      if (hasPoint(x, y)) return Nullable<double>(distance);
     }
 
     return Nullable<double>();
   }
 
-  // Returns if circle has given points
-  bool Circle::hasPoint(double x, double y) {
-    return getMatchingRad(x, y).hasValue();
+  // Returns if the given radian, or any of its 2 PIEs multiples, is in the arc's sweep
+  bool Circle::sweepsThrough(double rad) const {
+    return utils::mod(rad - _start, 2 * M_PI) <= _sweep;
+  }
+
+  // Re-calculates the cached arc representation, followed by the bounding box
+  void Circle::updateArc() {
+    double minRad = std::min(_rad1, _rad2);
+    double maxRad = std::max(_rad1, _rad2);
+
+    _start = utils::mod(minRad, 2 * M_PI);
+    _sweep = maxRad - minRad;
+    _startX = std::cos(minRad);
+    _startY = std::sin(minRad);
+    _endX = std::cos(maxRad);
+    _endY = std::sin(maxRad);
+
+    updateBox();
+  }
+
+  // Re-calculates the cached bounding box of the circle. In case of an arc, only its
+  // actual sweep is covered: the box of its end points, extended wherever the sweep
+  // passes through one of the circle's extreme points
+  void Circle::updateBox() {
+    if (_sweep >= 2 * M_PI) {
+      _box = { _x - _r, _y - _r, _x + _r, _y + _r };
+      return;
+    }
+
+    double x1 = _x + (_r * _startX);
+    double y1 = _y + (_r * _startY);
+    double x2 = _x + (_r * _endX);
+    double y2 = _y + (_r * _endY);
+
+    _box = {
+      std::min(x1, x2), std::min(y1, y2),
+      std::max(x1, x2), std::max(y1, y2)
+    };
+
+    if (sweepsThrough(0)) _box.maxX = _x + _r;
+    if (sweepsThrough(0.5 * M_PI)) _box.maxY = _y + _r;
+    if (sweepsThrough(M_PI)) _box.minX = _x - _r;
+    if (sweepsThrough(1.5 * M_PI)) _box.minY = _y - _r;
+  }
+
+  // Returns the bounding box of the circle
+  const Box& Circle::getBox() const {
+    return _box;
   }
 
   // circle - circle intersection method
-  Nullable<std::vector<Point>> Circle::getIntersection(Circle circle) {
+  Intersection Circle::getIntersection(const Circle& circle) const {
+    STATS_COUNT(CIRCLE_CIRCLE_CALLS);
+
+    // Escape if circles are not even close to each other
+    if (!_box.overlaps(circle._box, BOX_TOLERANCE)) {
+      STATS_COUNT(CIRCLE_CIRCLE_REJECTS);
+      return Intersection();
+    }
+
     double dx = circle._x - _x;
     double dy = circle._y - _y;
     double d = std::sqrt(std::pow(dx, 2) + std::pow(dy, 2));
 
     if (d > _r + circle._r ||
        d < std::abs(_r - circle._r)) {
-      return Nullable<std::vector<Point>>();
+      return Intersection();
     }
 
     double a = ((std::pow(_r, 2) - std::pow(circle._r, 2)) + std::pow(d, 2)) / (2 * d);
@@ -108,47 +249,35 @@ namespace geometry {
     double rx = (- dy * h) / d;
     double ry = (dx * h) / d;
 
-    std::vector<Point> interPoints(2);
-    interPoints.at(0).x = x + rx;
-    interPoints.at(0).y = y + ry;
-    interPoints.at(1).x = x - rx;
-    interPoints.at(1).y = y - ry;
+    Point interPoints[] = {
+      { utils::trim<utils::Round::ROUND, 9>(x + rx), utils::trim<utils::Round::ROUND, 9>(y + ry) },
+      { utils::trim<utils::Round::ROUND, 9>(x - rx), utils::trim<utils::Round::ROUND, 9>(y - ry) }
+    };
 
-    for (unsigned i = 0; i < interPoints.size(); i++) {
-      Point& point = interPoints.at(i);
-      point.x = utils::trim(point.x, 9);
-      point.y = utils::trim(point.y, 9);
-    }
+    Intersection intersection;
 
-    auto pointsBegin = std::unique(interPoints.begin(), interPoints.end(),
-      [](Point pointA, Point pointB) {
-        return pointA.x == pointB.x && pointA.y == pointB.y;
+    // Only points which are contained by both circles are relevant
+    for (const Point& point : interPoints) {
+      if (hasPoint(point.x, point.y) && circle.hasPoint(point.x, point.y)) {
+        intersection.push(point);
       }
-    );
-
-    interPoints.erase(pointsBegin, interPoints.end());
+    }
 
-    std::vector<Circle> circles = { *this, circle };
+    if (intersection.hasValue()) STATS_COUNT(CIRCLE_CIRCLE_HITS);
 
-    std::for_each(circles.begin(), circles.end(), [&interPoints](Circle circle) {
-      auto pointsBegin = std::remove_if(interPoints.begin(), interPoints.end(),
-        [&circle](Point point) {
-          return !circle.hasPoint(point.x, point.y);
-        }
-      );
+    return intersection;
+  }
 
-      interPoints.erase(pointsBegin, interPoints.end());
-    });
+  // circle - line intersection method
+  Intersection Circle::getIntersection(const Line& line) const {
+    STATS_COUNT(CIRCLE_LINE_CALLS);
 
-    if (interPoints.size()) {
-      return Nullable<std::vector<Point>>(interPoints);
+    // Escape if shapes are not even close to each other
+    if (!_box.overlaps(line.getBox(), BOX_TOLERANCE)) {
+      STATS_COUNT(CIRCLE_LINE_REJECTS);
+      return Intersection();
     }
 
-    return Nullable<std::vector<Point>>();
-  }
-
-  // circle - line intersection method
-  Nullable<std::vector<Point>> Circle::getIntersection(Line line) {
     double x1 = line._x1 - _x;
     double x2 = line._x2 - _x;
     double y1 = line._y1 - _y;
@@ -159,148 +288,33 @@ namespace geometry {
     double h = (x1 * y2) - (x2 * y1);
     double delta = (std::pow(_r, 2) * std::pow(d, 2)) - std::pow(h, 2);
 
-    if (delta < 0) Nullable<std::vector<Point>>();
+    if (delta < 0) return Intersection();
 
     double sign = dy / std::abs(dy); if (std::isnan(sign)) sign = 1;
     double sqrtx = sign * dx * std::sqrt(delta);
     double sqrty = std::abs(dy) * std::sqrt(delta);
 
-    std::vector<Point> interPoints(2);
-    interPoints.at(0).x = (((h * dy) + sqrtx) / std::pow(d, 2)) + _x;
-    interPoints.at(0).y = (((-h * dx) + sqrty) / std::pow(d, 2)) + _y;
-    interPoints.at(1).x = (((h * dy) - sqrtx) / std::pow(d, 2)) + _x;
-    interPoints.at(1).y = (((-h * dx) - sqrty) / std::pow(d, 2)) + _y;
-
-    for (unsigned i = 0; i < interPoints.size(); i++) {
-      Point& point = interPoints.at(i);
-      point.x = utils::trim(point.x, 9);
-      point.y = utils::trim(point.y, 9);
-    }
-
-    auto pointsBegin = std::remove_if(interPoints.begin(), interPoints.end(),
-      [this, &line](Point point) {
-        return !hasPoint(point.x, point.y) ||
-          !line.boundsHavePoint(point.x, point.y);
+    Point interPoints[] = {
+      {
+        utils::trim<utils::Round::ROUND, 9>((((h * dy) + sqrtx) / std::pow(d, 2)) + _x),
+        utils::trim<utils::Round::ROUND, 9>((((-h * dx) + sqrty) / std::pow(d, 2)) + _y)
+      },
+      {
+        utils::trim<utils::Round::ROUND, 9>((((h * dy) - sqrtx) / std::pow(d, 2)) + _x),
+        utils::trim<utils::Round::ROUND, 9>((((-h * dx) - sqrty) / std::pow(d, 2)) + _y)
       }
-    );
+    };
 
-    interPoints.erase(pointsBegin, interPoints.end());
+    Intersection intersection;
 
-    pointsBegin = std::unique(interPoints.begin(), interPoints.end(),
-      [](Point pointA, Point pointB) {
-        return pointA.x == pointB.x && pointA.y == pointB.y;
+    for (const Point& point : interPoints) {
+      if (hasPoint(point.x, point.y) && line.boundsHavePoint(point.x, point.y)) {
+        intersection.push(point);
       }
-    );
-
-    interPoints.erase(pointsBegin, interPoints.end());
-
-    if (interPoints.size()) {
-      return Nullable<std::vector<Point>>(interPoints);
     }
 
-    return Nullable<std::vector<Point>>();
-  }
-
-  emscripten::val EMCircle::getMatchingX(double y) {
-    Nullable<double> nullableX = Circle::getMatchingX(y);
-    return nullableX.hasValue() ?
-      emscripten::val(nullableX.getValue()) :
-      emscripten::val::undefined();
-  }
-
-  emscripten::val EMCircle::getMatchingY(double x) {
-    Nullable<double> nullableY = Circle::getMatchingY(x);
-    return nullableY.hasValue() ?
-      emscripten::val(nullableY.getValue()) :
-      emscripten::val::undefined();
-  }
-
-  emscripten::val EMCircle::getMatchingPoint(double rad) {
-    Nullable<Point> nullablePoint = Circle::getMatchingPoint(rad);
-
-    if (nullablePoint.isNull()) return emscripten::val::undefined();
-
-    Point point = nullablePoint.getValue();
-    emscripten::val emPoint = emscripten::val::object();
-    emPoint.set("x", emscripten::val(point.x));
-    emPoint.set("y", emscripten::val(point.y));
-    return emPoint;
-  }
-
-  emscripten::val EMCircle::getMatchingRad(double x, double y) {
-    Nullable<double> nullableRad = Circle::getMatchingRad(x, y);
-    return nullableRad.hasValue() ?
-      emscripten::val(nullableRad.getValue()) :
-      emscripten::val::undefined();
-  }
-
-  emscripten::val EMCircle::getIntersection(EMLine emLine) {
-    Line line = Line(emLine._x1, emLine._y1, emLine._x2, emLine._y2);
-    Nullable<std::vector<Point>> nullablePoints = Circle::getIntersection(line);
-
-    if (nullablePoints.isNull()) return emscripten::val::undefined();
-
-    std::vector<Point> points = nullablePoints.getValue();
-    emscripten::val emPoints = emscripten::val::array();
-
-    for (unsigned i = 0; i < points.size(); i++) {
-      Point point = points.at(i);
-      emscripten::val emPoint = emscripten::val::object();
-      emPoint.set("x", emscripten::val(point.x));
-      emPoint.set("y", emscripten::val(point.y));
-      emPoints.set(i, emPoint);
-    }
-
-    return emPoints;
-  }
-
-  emscripten::val EMCircle::getIntersection(EMCircle emCircle) {
-    Circle circle = Circle(
-      emCircle._x, emCircle._y, emCircle._r, emCircle._rad1, emCircle._rad2
-    );
-    Nullable<std::vector<Point>> nullablePoints = Circle::getIntersection(circle);
-
-    if (nullablePoints.isNull()) return emscripten::val::undefined();
-
-    std::vector<Point> points = nullablePoints.getValue();
-    emscripten::val emPoints = emscripten::val::array();
-
-    for (unsigned i = 0; i < points.size(); i++) {
-      Point point = points.at(i);
-      emscripten::val emPoint = emscripten::val::object();
-      emPoint.set("x", emscripten::val(point.x));
-      emPoint.set("y", emscripten::val(point.y));
-      emPoints.set(i, emPoint);
-    }
+    if (intersection.hasValue()) STATS_COUNT(CIRCLE_LINE_HITS);
 
-    return emPoints;
+    return intersection;
   }
-}
-
-EMSCRIPTEN_BINDINGS(geometry_circle_module) {
-  emscripten::class_<geometry::Circle>("geometry_circle_base")
-    .constructor<double, double, double, double, double>()
-    .property<double>("x", &geometry::Circle::_x)
-    .property<double>("y", &geometry::Circle::_y)
-    .property<double>("r", &geometry::Circle::_r)
-    .property<double>("rad1", &geometry::Circle::_rad1)
-    .property<double>("rad2", &geometry::Circle::_rad2)
-    .function("hasPoint", &geometry::Circle::hasPoint);
-
-  emscripten::class_<geometry::EMCircle, emscripten::base<geometry::Circle>>("geometry_circle")
-    .constructor<double, double, double, double, double>()
-    .function("getX", &geometry::EMCircle::getMatchingX)
-    .function("getY", &geometry::EMCircle::getMatchingY)
-    .function("getPoint", &geometry::EMCircle::getMatchingPoint)
-    .function("getRad", &geometry::EMCircle::getMatchingRad)
-    .function("getLineIntersection",
-      emscripten::select_overload<emscripten::val(geometry::EMLine)>(
-        &geometry::EMCircle::getIntersection
-      )
-    )
-    .function("getCircleIntersection",
-      emscripten::select_overload<emscripten::val(geometry::EMCircle)>(
-        &geometry::EMCircle::getIntersection
-      )
-    );
 }
\ No newline at end of file
@@ -1,16 +1,34 @@
 #pragma once
 
-#include <vector>
-#include <emscripten/val.h>
 #include "../nullable.h"
+#include "box.h"
 #include "point.h"
+#include "intersection.h"
 #include "line.h"
 
 namespace geometry {
   class Line;
-  class EMLine;
 
+  // The properties should only be modified using the setters, so the cached arc and
+  // bounding box would remain up to date
   class Circle {
+  private:
+    Box _box;
+    // The arc in a trigonometry free form: its normalized start radian, its sweep, and
+    // the unit vectors of both of its ends
+    double _start;
+    double _sweep;
+    double _startX;
+    double _startY;
+    double _endX;
+    double _endY;
+
+    void updateArc();
+
+    void updateBox();
+
+    bool sweepsThrough(double rad) const;
+
   public:
     double _x;
     double _y;
@@ -20,35 +38,42 @@ namespace geometry {
 
     Circle(double x, double y, double r, double rad1, double rad2);
 
-    Nullable<double> getMatchingX(double rad);
+    double getX() const;
 
-    Nullable<double> getMatchingY(double rad);
+    double getY() const;
 
-    Nullable<Point> getMatchingPoint(double rad);
+    double getR() const;
 
-    Nullable<double> getMatchingRad(double x, double y);
+    double getRad1() const;
 
-    bool hasPoint(double x, double y);
+    double getRad2() const;
 
-    Nullable<std::vector<Point>> getIntersection(Circle circle);
+    void setX(double x);
 
-    Nullable<std::vector<Point>> getIntersection(Line line);
-  };
+    void setY(double y);
 
-  class EMCircle : public Circle {
-  public:
-    using Circle::Circle;
+    void setR(double r);
+
+    void setRad1(double rad1);
+
+    void setRad2(double rad2);
+
+    Nullable<double> getMatchingX(double rad) const;
+
+    Nullable<double> getMatchingY(double rad) const;
+
+    Nullable<Point> getMatchingPoint(double rad) const;
 
-    emscripten::val getMatchingX(double y);
+    Nullable<double> getMatchingRad(double x, double y) const;
 
-    emscripten::val getMatchingY(double x);
+    bool hasPoint(double x, double y) const;
 
-    emscripten::val getMatchingPoint(double rad);
+    Nullable<double> getRayDistance(const Point& origin, const Point& direction) const;
 
-    emscripten::val getMatchingRad(double x, double y);
+    const Box& getBox() const;
 
-    emscripten::val getIntersection(EMLine line);
+    Intersection getIntersection(const Circle& circle) const;
 
-    emscripten::val getIntersection(EMCircle circle);
+    Intersection getIntersection(const Line& line) const;
   };
 }
\ No newline at end of file
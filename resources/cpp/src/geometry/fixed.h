@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cmath>
+
+namespace geometry {
+  // A coordinate of the fixed-point backend, in nano units. Doubles are trimmed to 9
+  // decimals all over the geometry core, so this is the exact same resolution, only
+  // comparisons of coordinates are exact without any trimming
+  typedef long long Fixed;
+
+  // Products of 2 differences of coordinates are made with twice as many bits, so
+  // orientation tests never overflow for coordinates of up to a few thousand units
+  typedef __int128 FixedProduct;
+
+  constexpr double FIXED_SCALE = 1e9;
+
+  // Intersection points of arcs are rounded, the same way doubles are trimmed, so they
+  // might slightly exceed the boxes of the shapes. This is BOX_TOLERANCE in nano units
+  constexpr Fixed FIXED_TOLERANCE = 1000;
+
+  inline Fixed toFixed(double value) {
+    return std::llround(value * FIXED_SCALE);
+  }
+
+  inline double toDouble(Fixed value) {
+    return value / FIXED_SCALE;
+  }
+
+  // An axis aligned bounding box of the fixed-point backend
+  struct FixedBox {
+    Fixed minX;
+    Fixed minY;
+    Fixed maxX;
+    Fixed maxY;
+
+    bool overlaps(const FixedBox& box, Fixed tolerance = 0) const {
+      return minX <= box.maxX + tolerance && box.minX <= maxX + tolerance &&
+             minY <= box.maxY + tolerance && box.minY <= maxY + tolerance;
+    }
+
+    bool hasPoint(Fixed x, Fixed y) const {
+      return minX <= x && x <= maxX && minY <= y && y <= maxY;
+    }
+  };
+
+  // The sign of the cross product of (b - a) and (c - a): positive when c is clockwise
+  // to the direction from a to b on the canvas, negative when it's counter clockwise,
+  // and 0 when all 3 points are on a single line
+  inline int getOrientation(Fixed ax, Fixed ay, Fixed bx, Fixed by, Fixed cx, Fixed cy) {
+    FixedProduct cross =
+      ((FixedProduct) (bx - ax) * (cy - ay)) - ((FixedProduct) (by - ay) * (cx - ax));
+    return (cross > 0) - (cross < 0);
+  }
+}
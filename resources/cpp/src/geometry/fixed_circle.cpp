@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cmath>
+#include "../utils.h"
+#include "point.h"
+#include "intersection.h"
+#include "fixed.h"
+#include "fixed_line.h"
+#include "fixed_circle.h"
+
+namespace geometry {
+  // x - The x value of the circle's center
+  // y - The y value of the circle's center
+  // r - The radius of the center
+  // rad1 - The first radian of the circle, not necessarily its beginning
+  // rad2 - The second radian of the circle, not necessarily its beginning
+  FixedCircle::FixedCircle(double x, double y, double r, double rad1, double rad2):
+    _x(toFixed(x)),
+    _y(toFixed(y)),
+    _r(toFixed(r)) {
+    // Radians are trimmed the same way as Circle's, so both backends cover the same arcs
+    if (rad1 > rad2) {
+      _rad1 = utils::trim<utils::Round::FLOOR, 9>(rad1);
+      _rad2 = utils::trim<utils::Round::CEIL, 9>(rad2);
+    }
+    else {
+      _rad1 = utils::trim<utils::Round::CEIL, 9>(rad1);
+      _rad2 = utils::trim<utils::Round::FLOOR, 9>(rad2);
+    }
+
+    updateArc();
+  }
+
+  double FixedCircle::getX() const {
+    return toDouble(_x);
+  }
+
+  double FixedCircle::getY() const {
+    return toDouble(_y);
+  }
+
+  double FixedCircle::getR() const {
+    return toDouble(_r);
+  }
+
+  // Returns if the given radian, or any of its 2 PIEs multiples, is in the arc's sweep
+  bool FixedCircle::sweepsThrough(double rad) const {
+    return utils::mod(rad - _start, 2 * M_PI) <= _sweep;
+  }
+
+  // Re-calculates the cached arc representation along with the bounding box, the same
+  // way Circle does. The extreme points of the circle are exact
+  void FixedCircle::updateArc() {
+    double minRad = std::min(_rad1, _rad2);
+    double maxRad = std::max(_rad1, _rad2);
+
+    _start = utils::mod(minRad, 2 * M_PI);
+    _sweep = maxRad - minRad;
+    _startX = std::cos(minRad);
+    _startY = std::sin(minRad);
+    _endX = std::cos(maxRad);
+    _endY = std::sin(maxRad);
+
+    if (_sweep >= 2 * M_PI) {
+      _box = { _x - _r, _y - _r, _x + _r, _y + _r };
+      return;
+    }
+
+    double r = toDouble(_r);
+    Fixed x1 = _x + toFixed(r * _startX);
+    Fixed y1 = _y + toFixed(r * _startY);
+    Fixed x2 = _x + toFixed(r * _endX);
+    Fixed y2 = _y + toFixed(r * _endY);
+
+    _box = {
+      std::min(x1, x2), std::min(y1, y2),
+      std::max(x1, x2), std::max(y1, y2)
+    };
+
+    if (sweepsThrough(0)) _box.maxX = _x + _r;
+    if (sweepsThrough(0.5 * M_PI)) _box.maxY = _y + _r;
+    if (sweepsThrough(M_PI)) _box.minX = _x - _r;
+    if (sweepsThrough(1.5 * M_PI)) _box.minY = _y - _r;
+  }
+
+  // Returns if the direction from the circle's center to the given point is within the
+  // arc's sweep, see Circle::hasPoint
+  bool FixedCircle::hasPoint(Fixed x, Fixed y) const {
+    if (_sweep >= 2 * M_PI) return true;
+
+    double dx = toDouble(x - _x);
+    double dy = toDouble(y - _y);
+    double tolerance = 1e-9 * std::sqrt((dx * dx) + (dy * dy));
+    double fromStart = (_startX * dy) - (_startY * dx);
+    double toEnd = (dx * _endY) - (dy * _endX);
+
+    if (_sweep <= M_PI) {
+      return fromStart >= -tolerance && toEnd >= -tolerance &&
+             (dx * (_startX + _endX)) + (dy * (_startY + _endY)) >= 0;
+    }
+
+    return fromStart >= -tolerance || toEnd >= -tolerance;
+  }
+
+  const FixedBox& FixedCircle::getBox() const {
+    return _box;
+  }
+
+  // circle - circle intersection method. Whether the circles are too far apart or one
+  // is within the other is told exactly, and the points themselves are calculated
+  // relatively to this circle's center
+  Intersection FixedCircle::getIntersection(const FixedCircle& circle) const {
+    if (!_box.overlaps(circle._box, FIXED_TOLERANCE)) return Intersection();
+
+    Fixed fdx = circle._x - _x;
+    Fixed fdy = circle._y - _y;
+    FixedProduct distance = ((FixedProduct) fdx * fdx) + ((FixedProduct) fdy * fdy);
+    FixedProduct sum = (FixedProduct) _r + circle._r;
+    FixedProduct difference = (FixedProduct) _r - circle._r;
+
+    if (!distance || distance > sum * sum || distance < difference * difference) {
+      return Intersection();
+    }
+
+    double dx = toDouble(fdx);
+    double dy = toDouble(fdy);
+    double r1 = toDouble(_r);
+    double r2 = toDouble(circle._r);
+    double d = std::sqrt((dx * dx) + (dy * dy));
+    double a = (((r1 * r1) - (r2 * r2)) + (d * d)) / (2 * d);
+    double x = (dx * a) / d;
+    double y = (dy * a) / d;
+    double h = std::sqrt(std::max((r1 * r1) - (a * a), 0.0));
+    double rx = (- dy * h) / d;
+    double ry = (dx * h) / d;
+
+    Fixed interPoints[2][2] = {
+      { _x + toFixed(x + rx), _y + toFixed(y + ry) },
+      { _x + toFixed(x - rx), _y + toFixed(y - ry) }
+    };
+
+    Intersection intersection;
+
+    for (const Fixed* point : interPoints) {
+      if (hasPoint(point[0], point[1]) && circle.hasPoint(point[0], point[1])) {
+        intersection.push({ toDouble(point[0]), toDouble(point[1]) });
+      }
+    }
+
+    return intersection;
+  }
+
+  // circle - line intersection method, see Circle's. The line's bounds are checked exactly
+  Intersection FixedCircle::getIntersection(const FixedLine& line) const {
+    if (!_box.overlaps(line.getBox(), FIXED_TOLERANCE)) return Intersection();
+
+    double x1 = toDouble(line._x1 - _x);
+    double x2 = toDouble(line._x2 - _x);
+    double y1 = toDouble(line._y1 - _y);
+    double y2 = toDouble(line._y2 - _y);
+    double r = toDouble(_r);
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    double d2 = (dx * dx) + (dy * dy);
+    double h = (x1 * y2) - (x2 * y1);
+    double delta = (r * r * d2) - (h * h);
+
+    if (delta < 0 || !d2) return Intersection();
+
+    double sign = dy < 0 ? -1 : 1;
+    double sqrtx = sign * dx * std::sqrt(delta);
+    double sqrty = std::abs(dy) * std::sqrt(delta);
+
+    Fixed interPoints[2][2] = {
+      { _x + toFixed(((h * dy) + sqrtx) / d2), _y + toFixed(((-h * dx) + sqrty) / d2) },
+      { _x + toFixed(((h * dy) - sqrtx) / d2), _y + toFixed(((-h * dx) - sqrty) / d2) }
+    };
+
+    Intersection intersection;
+
+    for (const Fixed* point : interPoints) {
+      if (hasPoint(point[0], point[1]) && line.boundsHavePoint(point[0], point[1])) {
+        intersection.push({ toDouble(point[0]), toDouble(point[1]) });
+      }
+    }
+
+    return intersection;
+  }
+}
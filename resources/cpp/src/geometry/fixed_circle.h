@@ -0,0 +1,51 @@
+#pragma once
+
+#include "intersection.h"
+#include "fixed.h"
+#include "fixed_line.h"
+
+namespace geometry {
+  class FixedLine;
+
+  // A circle of the fixed-point backend. The center and the radius are integers, so
+  // circles which can't possibly meet are told apart exactly, while radians remain
+  // doubles, since the points where arcs meet can only be found with sqrt and trig
+  class FixedCircle {
+  private:
+    FixedBox _box;
+    // The arc in a trigonometry free form, see Circle
+    double _start;
+    double _sweep;
+    double _startX;
+    double _startY;
+    double _endX;
+    double _endY;
+
+    void updateArc();
+
+    bool sweepsThrough(double rad) const;
+
+  public:
+    Fixed _x;
+    Fixed _y;
+    Fixed _r;
+    double _rad1;
+    double _rad2;
+
+    FixedCircle(double x, double y, double r, double rad1, double rad2);
+
+    double getX() const;
+
+    double getY() const;
+
+    double getR() const;
+
+    bool hasPoint(Fixed x, Fixed y) const;
+
+    const FixedBox& getBox() const;
+
+    Intersection getIntersection(const FixedCircle& circle) const;
+
+    Intersection getIntersection(const FixedLine& line) const;
+  };
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cmath>
+#include "point.h"
+#include "intersection.h"
+#include "fixed.h"
+#include "fixed_circle.h"
+#include "fixed_line.h"
+
+namespace geometry {
+  // x1 - The first point's x value
+  // y1 - The first point's y value
+  // x2 - The second point's x value
+  // y2 - The second point's y value
+  FixedLine::FixedLine(double x1, double y1, double x2, double y2):
+    _x1(toFixed(x1)),
+    _y1(toFixed(y1)),
+    _x2(toFixed(x2)),
+    _y2(toFixed(y2)) {
+    updateBox();
+  }
+
+  double FixedLine::getX1() const {
+    return toDouble(_x1);
+  }
+
+  double FixedLine::getY1() const {
+    return toDouble(_y1);
+  }
+
+  double FixedLine::getX2() const {
+    return toDouble(_x2);
+  }
+
+  double FixedLine::getY2() const {
+    return toDouble(_y2);
+  }
+
+  // Returns if given point is contained by the bounds aka cage of line
+  bool FixedLine::boundsHavePoint(Fixed x, Fixed y) const {
+    return _box.hasPoint(x, y);
+  }
+
+  void FixedLine::updateBox() {
+    _box = {
+      std::min(_x1, _x2), std::min(_y1, _y2),
+      std::max(_x1, _x2), std::max(_y1, _y2)
+    };
+  }
+
+  const FixedBox& FixedLine::getBox() const {
+    return _box;
+  }
+
+  // line - line intersection method. Lines meet once the ends of each one of them are
+  // not both on the same side of the other, which is told exactly. Parallel lines don't
+  // meet at all, just like with the double backend
+  Intersection FixedLine::getIntersection(const FixedLine& line) const {
+    if (!_box.overlaps(line._box)) return Intersection();
+
+    Fixed rx = _x2 - _x1;
+    Fixed ry = _y2 - _y1;
+    Fixed sx = line._x2 - line._x1;
+    Fixed sy = line._y2 - line._y1;
+    FixedProduct denominator = ((FixedProduct) rx * sy) - ((FixedProduct) ry * sx);
+
+    if (!denominator) return Intersection();
+
+    int side1 = getOrientation(_x1, _y1, _x2, _y2, line._x1, line._y1);
+    int side2 = getOrientation(_x1, _y1, _x2, _y2, line._x2, line._y2);
+    if (side1 && side1 == side2) return Intersection();
+
+    int side3 = getOrientation(line._x1, line._y1, line._x2, line._y2, _x1, _y1);
+    int side4 = getOrientation(line._x1, line._y1, line._x2, line._y2, _x2, _y2);
+    if (side3 && side3 == side4) return Intersection();
+
+    // How far along this line the other one is crossed, from 0 to 1
+    FixedProduct numerator =
+      ((FixedProduct) (line._x1 - _x1) * sy) - ((FixedProduct) (line._y1 - _y1) * sx);
+    double position = (double) numerator / (double) denominator;
+
+    // The point is rounded to the nano unit, so it's kept within both lines, which are
+    // known to meet
+    Fixed x = _x1 + std::llround(rx * position);
+    Fixed y = _y1 + std::llround(ry * position);
+    x = std::min(std::max(x, std::max(_box.minX, line._box.minX)), std::min(_box.maxX, line._box.maxX));
+    y = std::min(std::max(y, std::max(_box.minY, line._box.minY)), std::min(_box.maxY, line._box.maxY));
+
+    return Intersection({ toDouble(x), toDouble(y) });
+  }
+
+  // line - circle intersection method
+  Intersection FixedLine::getIntersection(const FixedCircle& circle) const {
+    return circle.getIntersection(*this);
+  }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "intersection.h"
+#include "fixed.h"
+#include "fixed_circle.h"
+
+namespace geometry {
+  class FixedCircle;
+
+  // A line of the fixed-point backend. Coordinates are converted once they're given and
+  // stay as integers from then on, so whether 2 lines intersect is decided by exact
+  // orientation tests, and only the intersection point itself is calculated with doubles
+  class FixedLine {
+  private:
+    FixedBox _box;
+
+    void updateBox();
+
+  public:
+    Fixed _x1;
+    Fixed _y1;
+    Fixed _x2;
+    Fixed _y2;
+
+    FixedLine(double x1, double y1, double x2, double y2);
+
+    double getX1() const;
+
+    double getY1() const;
+
+    double getX2() const;
+
+    double getY2() const;
+
+    bool boundsHavePoint(Fixed x, Fixed y) const;
+
+    const FixedBox& getBox() const;
+
+    Intersection getIntersection(const FixedLine& line) const;
+
+    Intersection getIntersection(const FixedCircle& circle) const;
+  };
+}
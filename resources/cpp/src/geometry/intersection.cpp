@@ -0,0 +1,46 @@
+#include <stdexcept>
+#include "point.h"
+#include "intersection.h"
+
+namespace geometry {
+  Intersection::Intersection(): _size(0) {
+  }
+
+  Intersection::Intersection(const Point& point): _size(1) {
+    _points[0] = point;
+  }
+
+  unsigned Intersection::size() const {
+    return _size;
+  }
+
+  const Point& Intersection::at(unsigned index) const {
+    if (index >= _size) throw std::out_of_range("Intersection::at");
+    return _points[index];
+  }
+
+  const Point* Intersection::begin() const {
+    return _points;
+  }
+
+  const Point* Intersection::end() const {
+    return _points + _size;
+  }
+
+  // Adds a point, unless it's identical to the most recent one, which is the case with
+  // kissing shapes. Points beyond capacity are ignored
+  void Intersection::push(const Point& point) {
+    if (_size && _points[_size - 1].x == point.x && _points[_size - 1].y == point.y) return;
+    if (_size >= CAPACITY) return;
+
+    _points[_size++] = point;
+  }
+
+  bool Intersection::hasValue() const {
+    return _size > 0;
+  }
+
+  bool Intersection::isNull() const {
+    return _size == 0;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "point.h"
+
+namespace geometry {
+  // The result of an intersection between 2 shapes. Lines and circles can intersect
+  // in at most 2 points, so the points are stored inline and no heap allocation is
+  // ever made
+  class Intersection {
+  private:
+    Point _points[2];
+    unsigned _size;
+
+  public:
+    static const unsigned CAPACITY = 2;
+
+    Intersection();
+
+    Intersection(const Point& point);
+
+    unsigned size() const;
+
+    const Point& at(unsigned index) const;
+
+    const Point* begin() const;
+
+    const Point* end() const;
+
+    void push(const Point& point);
+
+    bool hasValue() const;
+
+    bool isNull() const;
+  };
+}
\ No newline at end of file
@@ -1,9 +1,11 @@
-#include <vector>
-#include <emscripten/bind.h>
-#include <emscripten/val.h>
+#include <algorithm>
+#include <cmath>
 #include "../nullable.h"
 #include "../utils.h"
+#include "../stats.h"
+#include "box.h"
 #include "point.h"
+#include "intersection.h"
 #include "circle.h"
 #include "line.h"
 
@@ -13,23 +15,61 @@ namespace geometry {
   // x1 - The second point's x value
   // y2 - The second point's y value
   Line::Line(double x1, double y1, double x2, double y2) {
-    _x1 = utils::trim(x1, 9);
-    _y1 = utils::trim(y1, 9);
-    _x2 = utils::trim(x2, 9);
-    _y2 = utils::trim(y2, 9);
+    _x1 = utils::trim<utils::Round::ROUND, 9>(x1);
+    _y1 = utils::trim<utils::Round::ROUND, 9>(y1);
+    _x2 = utils::trim<utils::Round::ROUND, 9>(x2);
+    _y2 = utils::trim<utils::Round::ROUND, 9>(y2);
+
+    updateBox();
+  }
+
+  double Line::getX1() const {
+    return _x1;
+  }
+
+  double Line::getY1() const {
+    return _y1;
+  }
+
+  double Line::getX2() const {
+    return _x2;
+  }
+
+  double Line::getY2() const {
+    return _y2;
+  }
+
+  void Line::setX1(double x1) {
+    _x1 = x1;
+    updateBox();
+  }
+
+  void Line::setY1(double y1) {
+    _y1 = y1;
+    updateBox();
+  }
+
+  void Line::setX2(double x2) {
+    _x2 = x2;
+    updateBox();
+  }
+
+  void Line::setY2(double y2) {
+    _y2 = y2;
+    updateBox();
   }
 
   // Gets the matching x value for a given y value
-  Nullable<double> Line::getMatchingX(double y) {
+  Nullable<double> Line::getMatchingX(double y) const {
     // If an error was thrown it means we divided a number by zero,
     // in which case there is not intersection point
-    double x = utils::trim(
+    double x = utils::trim<utils::Round::ROUND, 9>(
       (((y - _y1) * (_x2 - _x1)) /
        (_y2 - _y1)) + _x1
-    , 9, "exact");
+    );
 
     // Check if result is in values range
-    if (utils::isBetween(x, _x1, _x2, "round")) {
+    if (utils::isBetween<utils::Precision::EXACT>(x, _x1, _x2)) {
       return Nullable<double>(x);
     }
 
@@ -37,16 +77,16 @@ namespace geometry {
   }
 
   // Gets the matching y value for a given x value
-  Nullable<double> Line::getMatchingY(double x) {
+  Nullable<double> Line::getMatchingY(double x) const {
     // If an error was thrown it means we divided a number by zero,
     // in which case there is not intersection point
-    double y = utils::trim(
+    double y = utils::trim<utils::Round::ROUND, 9>(
       (((x - _x1) * (_y2 - _y1)) /
        (_x2 - _x1)) + _y1
-    , 9, "exact");
+    );
 
     // Check if result is in values range
-    if (utils::isBetween(y, _y1, _y2, "round")) {
+    if (utils::isBetween<utils::Precision::EXACT>(y, _y1, _y2)) {
       return Nullable<double>(y);
     }
 
@@ -54,112 +94,112 @@ namespace geometry {
   }
 
   // Returns if line has given point
-  bool Line::hasPoint(double x, double y) {
+  bool Line::hasPoint(double x, double y) const {
     if (!boundsHavePoint(x, y)) return 0;
 
-    double m = utils::trim(
-      (_y2 - _y1) / (_x2 - _x1),
-    9, "exact");
+    double m = utils::trim<utils::Round::ROUND, 9>(
+      (_y2 - _y1) / (_x2 - _x1)
+    );
 
     return (y - _y1) / (x - _x1) == m;
   }
 
   // Returns if given point is contained by the bounds aka cage of line
-  bool Line::boundsHavePoint(double x, double y) {
-    return utils::isBetween(x, _x1, _x2, "round") &&
-           utils::isBetween(y, _y1, _y2, "round");
+  bool Line::boundsHavePoint(double x, double y) const {
+    return utils::isBetween<utils::Precision::EXACT>(x, _x1, _x2) &&
+           utils::isBetween<utils::Precision::EXACT>(y, _y1, _y2);
+  }
+
+  // Returns the distance from the given origin along the given direction, which is
+  // expected to be a unit vector, until the ray hits the line. A ray which runs along
+  // the line hits its nearest point in front of the origin. Directions are calculated
+  // out of radians, so rays which deviate from the line by less than the precision
+  // of a trimmed radian are considered to run along it
+  Nullable<double> Line::getRayDistance(const Point& origin, const Point& direction) const {
+    double ex = _x2 - _x1;
+    double ey = _y2 - _y1;
+    double px = _x1 - origin.x;
+    double py = _y1 - origin.y;
+    double denominator = (direction.x * ey) - (direction.y * ex);
+    // How far along the line the ray crosses it, scaled by the denominator
+    double crossing = (px * direction.y) - (py * direction.x);
+
+    if (denominator * denominator <= 1e-18 * ((ex * ex) + (ey * ey))) {
+      if (std::abs(crossing) > BOX_TOLERANCE) return Nullable<double>();
+
+      double distance1 = (px * direction.x) + (py * direction.y);
+      double distance2 = ((_x2 - origin.x) * direction.x) + ((_y2 - origin.y) * direction.y);
+
+      if (distance1 < 0 && distance2 < 0) return Nullable<double>();
+      // The origin is on the line itself
+      if (distance1 < 0 || distance2 < 0) return Nullable<double>(0);
+
+      return Nullable<double>(std::min(distance1, distance2));
+    }
+
+    double distance = ((px * ey) - (py * ex)) / denominator;
+    double position = crossing / denominator;
+
+    if (distance < 0 || position < 0 || position > 1) return Nullable<double>();
+
+    return Nullable<double>(distance);
+  }
+
+  // Re-calculates the cached bounding box of the line
+  void Line::updateBox() {
+    _box = {
+      std::min(_x1, _x2), std::min(_y1, _y2),
+      std::max(_x1, _x2), std::max(_y1, _y2)
+    };
+  }
+
+  // Returns the bounding box of the line
+  const Box& Line::getBox() const {
+    return _box;
   }
 
   // line - line intersection method
-  Nullable<Point> Line::getIntersection(Line line) {
+  Intersection Line::getIntersection(const Line& line) const {
+    STATS_COUNT(LINE_LINE_CALLS);
+
+    // Escape if lines are not even close to each other
+    if (!_box.overlaps(line._box, BOX_TOLERANCE)) {
+      STATS_COUNT(LINE_LINE_REJECTS);
+      return Intersection();
+    }
+
     // Escape if lines are parallel
     if (!(((_x1 - _x2) * (line._y1 - line._y2)) -
           ((_y1 - _y2) * (line._x1 - line._x2))))
-      return Nullable<Point>();
+      return Intersection();
 
     // Intersection point formula
-    double x = utils::trim(
+    double x = utils::trim<utils::Round::ROUND, 9>(
       ((((_x1 * _y2) - (_y1 * _x2)) * (line._x1 - line._x2)) -
        ((_x1 - _x2) * ((line._x1 * line._y2) - (line._y1 * line._x2)))) /
       (((_x1 - _x2) * (line._y1 - line._y2)) - ((_y1 - _y2) *
         (line._x1 - line._x2)))
-    , 9, "exact");
-    double y = utils::trim(
+    );
+    double y = utils::trim<utils::Round::ROUND, 9>(
       ((((_x1 * _y2) - (_y1 * _x2)) * (line._y1 - line._y2)) -
        ((_y1 - _y2) * ((line._x1 * line._y2) - (line._y1 * line._x2)))) /
       (((_x1 - _x2) * (line._y1 - line._y2)) - ((_y1 - _y2) *
         (line._x1 - line._x2)))
-    , 9, "exact");
+    );
 
-    if (utils::isBetween(x, _x1, _x2, "round") &&
-        utils::isBetween(x, line._x1, line._x2, "round") &&
-        utils::isBetween(y, _y1, _y2, "round") &&
-        utils::isBetween(y, line._y1, line._y2, "round")) {
-      return Nullable<Point>({ x, y });
+    if (utils::isBetween<utils::Precision::EXACT>(x, _x1, _x2) &&
+        utils::isBetween<utils::Precision::EXACT>(x, line._x1, line._x2) &&
+        utils::isBetween<utils::Precision::EXACT>(y, _y1, _y2) &&
+        utils::isBetween<utils::Precision::EXACT>(y, line._y1, line._y2)) {
+      STATS_COUNT(LINE_LINE_HITS);
+      return Intersection({ x, y });
     }
 
-    return Nullable<Point>();
+    return Intersection();
   }
 
-  // circle - circle intersection method
-  Nullable<std::vector<Point>> Line::getIntersection(Circle circle) {
+  // line - circle intersection method
+  Intersection Line::getIntersection(const Circle& circle) const {
     return circle.getIntersection(*this);
   }
-
-  emscripten::val EMLine::getMatchingX(double y) {
-    Nullable<double> nullableX = Line::getMatchingX(y);
-    return nullableX.hasValue() ?
-      emscripten::val(nullableX.getValue()) :
-      emscripten::val::undefined();
-  }
-
-  emscripten::val EMLine::getMatchingY(double x) {
-    Nullable<double> nullableY = Line::getMatchingY(x);
-    return nullableY.hasValue() ?
-      emscripten::val(nullableY.getValue()) :
-      emscripten::val::undefined();
-  }
-
-  emscripten::val EMLine::getIntersection(EMLine emLine) {
-    Line line = Line(emLine._x1, emLine._y1, emLine._x2, emLine._y2);
-    Nullable<Point> nullablePoint = Line::getIntersection(line);
-
-    if (nullablePoint.isNull()) return emscripten::val::undefined();
-
-    Point point = nullablePoint.getValue();
-    emscripten::val emPoint = emscripten::val::object();
-    emPoint.set("x", emscripten::val(point.x));
-    emPoint.set("y", emscripten::val(point.y));
-    return emPoint;
-  }
-
-  emscripten::val EMLine::getIntersection(EMCircle emCircle) {
-    return emCircle.getIntersection(*this);
-  }
-}
-
-EMSCRIPTEN_BINDINGS(geometry_line_module) {
-  emscripten::class_<geometry::Line>("geometry_line_base")
-    .constructor<double, double, double, double>()
-    .property<double>("x1", &geometry::Line::_x1)
-    .property<double>("y1", &geometry::Line::_y1)
-    .property<double>("x2", &geometry::Line::_x2)
-    .property<double>("y2", &geometry::Line::_y2)
-    .function("hasPoint", &geometry::Line::hasPoint)
-    .function("boundsHavePoint", &geometry::Line::boundsHavePoint);
-
-  emscripten::class_<geometry::EMLine, emscripten::base<geometry::Line>>("geometry_line")
-    .constructor<double, double, double, double>()
-    .function("getX", &geometry::EMLine::getMatchingX)
-    .function("getY", &geometry::EMLine::getMatchingY)
-    .function("getLineIntersection",
-      emscripten::select_overload<emscripten::val(geometry::EMLine)>(
-        &geometry::EMLine::getIntersection
-      )
-    )
-    .function("getCircleIntersection",
-      emscripten::select_overload<emscripten::val(geometry::EMCircle)>(
-        &geometry::EMLine::getIntersection
-      )
-    );
 }
\ No newline at end of file
@@ -1,16 +1,22 @@
 #pragma once
 
-#include <vector>
-#include <emscripten/val.h>
 #include "../nullable.h"
+#include "box.h"
 #include "point.h"
+#include "intersection.h"
 #include "circle.h"
 
 namespace geometry {
   class Circle;
-  class EMCircle;
 
+  // The coordinates should only be modified using the setters, so the cached bounding
+  // box would remain up to date
   class Line {
+  private:
+    Box _box;
+
+    void updateBox();
+
   public:
     double _x1;
     double _y1;
@@ -19,29 +25,36 @@ namespace geometry {
 
     Line(double x1, double y1, double x2, double y2);
 
-    Nullable<double> getMatchingX(double y);
+    double getX1() const;
 
-    Nullable<double> getMatchingY(double x);
+    double getY1() const;
 
-    bool hasPoint(double x, double y);
+    double getX2() const;
 
-    bool boundsHavePoint(double x, double y);
+    double getY2() const;
 
-    Nullable<Point> getIntersection(Line line);
+    void setX1(double x1);
 
-    Nullable<std::vector<Point>> getIntersection(Circle circle);
-  };
+    void setY1(double y1);
 
-  class EMLine : public Line {
-  public:
-    using Line::Line;
+    void setX2(double x2);
+
+    void setY2(double y2);
+
+    Nullable<double> getMatchingX(double y) const;
+
+    Nullable<double> getMatchingY(double x) const;
+
+    bool hasPoint(double x, double y) const;
+
+    bool boundsHavePoint(double x, double y) const;
 
-    emscripten::val getMatchingX(double y);
+    Nullable<double> getRayDistance(const Point& origin, const Point& direction) const;
 
-    emscripten::val getMatchingY(double x);
+    const Box& getBox() const;
 
-    emscripten::val getIntersection(EMLine line);
+    Intersection getIntersection(const Line& line) const;
 
-    emscripten::val getIntersection(EMCircle circle);
+    Intersection getIntersection(const Circle& circle) const;
   };
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "box.h"
+#include "line.h"
+#include "circle.h"
+#include "occupancy_grid.h"
+
+namespace geometry {
+  constexpr double OccupancyGrid::MARGIN;
+
+  // width - The width of the arena
+  // height - The height of the arena
+  // cellSize - The width and height of each cell
+  OccupancyGrid::OccupancyGrid(double width, double height, double cellSize):
+    _cellSize(cellSize),
+    _columns(std::max(1.0, std::ceil(width / cellSize))),
+    _rows(std::max(1.0, std::ceil(height / cellSize))),
+    _cells(_columns * _rows, 0) {
+  }
+
+  long long OccupancyGrid::getColumn(double x) const {
+    return std::min(std::max((long long) std::floor(x / _cellSize), 0ll), _columns - 1);
+  }
+
+  long long OccupancyGrid::getRow(double y) const {
+    return std::min(std::max((long long) std::floor(y / _cellSize), 0ll), _rows - 1);
+  }
+
+  void OccupancyGrid::stampBox(const Box& box, unsigned long long bit) {
+    long long maxColumn = getColumn(box.maxX);
+    long long maxRow = getRow(box.maxY);
+
+    for (long long row = getRow(box.minY); row <= maxRow; row++) {
+      for (long long column = getColumn(box.minX); column <= maxColumn; column++) {
+        _cells[row * _columns + column] |= bit;
+      }
+    }
+  }
+
+  // Lines are split into pieces no longer than a cell, and the padded box of each piece
+  // is stamped
+  void OccupancyGrid::stamp(const Line& line, unsigned owner) {
+    unsigned long long bit = 1ull << owner;
+    double dx = line._x2 - line._x1;
+    double dy = line._y2 - line._y1;
+    unsigned count = std::max(1.0, std::ceil(std::hypot(dx, dy) / _cellSize));
+
+    for (unsigned i = 0; i < count; i++) {
+      double x1 = line._x1 + (dx * i) / count;
+      double y1 = line._y1 + (dy * i) / count;
+      double x2 = line._x1 + (dx * (i + 1)) / count;
+      double y2 = line._y1 + (dy * (i + 1)) / count;
+
+      stampBox(Box {
+        std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2)
+      }.expand(MARGIN), bit);
+    }
+  }
+
+  // Arcs are split into pieces no longer than a cell, and each piece is stamped with the
+  // box of its chord, padded by how far the arc bulges out of it
+  void OccupancyGrid::stamp(const Circle& circle, unsigned owner) {
+    unsigned long long bit = 1ull << owner;
+    double from = std::min(circle._rad1, circle._rad2);
+    double sweep = std::min(std::abs(circle._rad2 - circle._rad1), 2 * M_PI);
+    unsigned count = std::max(1.0, std::ceil((sweep * circle._r) / _cellSize));
+    double piece = sweep / count;
+    double bulge = circle._r * (1 - std::cos(piece / 2));
+
+    for (unsigned i = 0; i < count; i++) {
+      double rad1 = from + piece * i;
+      double rad2 = from + piece * (i + 1);
+      double x1 = circle._x + circle._r * std::cos(rad1);
+      double y1 = circle._y + circle._r * std::sin(rad1);
+      double x2 = circle._x + circle._r * std::cos(rad2);
+      double y2 = circle._y + circle._r * std::sin(rad2);
+
+      stampBox(Box {
+        std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2)
+      }.expand(bulge + MARGIN), bit);
+    }
+  }
+
+  // Returns the bits of all the owners which were stamped into the cells the given box
+  // covers
+  unsigned long long OccupancyGrid::getOwners(const Box& box) const {
+    unsigned long long owners = 0;
+    long long maxColumn = getColumn(box.maxX);
+    long long maxRow = getRow(box.maxY);
+
+    for (long long row = getRow(box.minY); row <= maxRow; row++) {
+      for (long long column = getColumn(box.minX); column <= maxColumn; column++) {
+        owners |= _cells[row * _columns + column];
+      }
+    }
+
+    return owners;
+  }
+
+  void OccupancyGrid::clear() {
+    std::fill(_cells.begin(), _cells.end(), 0);
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include "box.h"
+#include "line.h"
+#include "circle.h"
+
+namespace geometry {
+  // A coarse occupancy bitmap over an arena, which holds a bit for each owner of the
+  // shapes which pass through a cell, e.g. for each snake. Unlike a bounding box, which
+  // might cover a large area for a long line or a wide arc, shapes are stamped along
+  // their actual path, so a small shape which shares no cell with an owner can't
+  // intersect any of its stamped shapes. Each cell holds 64 bits, so up to 64 owners
+  // are told apart. Bits are only ever set, until the grid is cleared. Shapes which
+  // stick out of the arena, e.g. before they're split by a wrap, are clamped into the
+  // cells along its edges, just like queries are, so shapes which meet beyond an edge
+  // still share a cell
+  class OccupancyGrid {
+  public:
+    // The padding around stamped shapes, the same as the padding of trail segments
+    static constexpr double MARGIN = 1;
+
+    OccupancyGrid(double width, double height, double cellSize = 16);
+
+    void stamp(const Line& line, unsigned owner);
+
+    void stamp(const Circle& circle, unsigned owner);
+
+    unsigned long long getOwners(const Box& box) const;
+
+    void clear();
+
+  private:
+    double _cellSize;
+    long long _columns;
+    long long _rows;
+    std::vector<unsigned long long> _cells;
+
+    long long getColumn(double x) const;
+
+    long long getRow(double y) const;
+
+    void stampBox(const Box& box, unsigned long long bit);
+  };
+}
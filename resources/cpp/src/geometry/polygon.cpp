@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "box.h"
+#include "point.h"
+#include "intersection.h"
+#include "line.h"
+#include "circle.h"
+#include "polygon.h"
+
+namespace geometry {
+  namespace {
+    Box merge(const Box& a, const Box& b) {
+      return {
+        std::min(a.minX, b.minX), std::min(a.minY, b.minY),
+        std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)
+      };
+    }
+
+    // The same as Box::overlaps, without branching on each comparison, since boxes of
+    // the hierarchy overlap a query box more or less at random
+    bool overlaps(const Box& a, const Box& b) {
+      return (a.minX <= b.maxX) & (b.minX <= a.maxX) & (a.minY <= b.maxY) & (b.minY <= a.maxY);
+    }
+
+    double getArea(const Box& box) {
+      return (box.maxX - box.minX) * (box.maxY - box.minY);
+    }
+  }
+
+  // edges - The lines the polygon is made of, not necessarily connected to one another
+  Polygon::Polygon(const std::vector<Line>& edges): _edges(edges) {
+    _boxes.reserve(_edges.size());
+    _order.reserve(_edges.size());
+    _candidates.reserve(_edges.size());
+
+    for (unsigned id = 0; id < _edges.size(); id++) {
+      _boxes.push_back(_edges[id].getBox().expand(1));
+      _order.push_back(id);
+    }
+
+    if (!_edges.empty()) build(0, _edges.size(), 0);
+  }
+
+  // Builds the node for the given range of ordered edges and returns its index. Inner
+  // nodes split their edges in half along the longer axis of their centers
+  unsigned Polygon::build(unsigned first, unsigned count, unsigned depth) {
+    unsigned index = _nodes.size();
+    Box box = _boxes[_order[first]];
+
+    for (unsigned i = first + 1; i < first + count; i++) {
+      box = merge(box, _boxes[_order[i]]);
+    }
+
+    _nodes.push_back({ box, 0, first, count });
+
+    if (count <= LEAF_SIZE || depth + 1 >= MAX_DEPTH) return index;
+
+    Box centers = { box.maxX, box.maxY, box.minX, box.minY };
+
+    for (unsigned i = first; i < first + count; i++) {
+      const Box& edgeBox = _boxes[_order[i]];
+      double x = (edgeBox.minX + edgeBox.maxX) / 2;
+      double y = (edgeBox.minY + edgeBox.maxY) / 2;
+      centers = merge(centers, { x, y, x, y });
+    }
+
+    bool vertical = centers.maxY - centers.minY > centers.maxX - centers.minX;
+    unsigned half = count / 2;
+
+    std::nth_element(_order.begin() + first, _order.begin() + first + half,
+      _order.begin() + first + count, [&](unsigned a, unsigned b) {
+        const Box& boxA = _boxes[a];
+        const Box& boxB = _boxes[b];
+        return vertical ?
+          boxA.minY + boxA.maxY < boxB.minY + boxB.maxY :
+          boxA.minX + boxA.maxX < boxB.minX + boxB.maxX;
+      });
+
+    build(first, half, depth + 1);
+    unsigned right = build(first + half, count - half, depth + 1);
+
+    _nodes[index].right = right;
+    _nodes[index].count = 0;
+
+    return index;
+  }
+
+  unsigned Polygon::size() const {
+    return _edges.size();
+  }
+
+  const Line& Polygon::getEdge(unsigned id) const {
+    return _edges.at(id);
+  }
+
+  // Returns the box of all edges, padded like each one of them. An empty polygon has
+  // an empty box at the origin
+  const Box& Polygon::getBox() const {
+    static const Box empty = { 0, 0, 0, 0 };
+    return _nodes.empty() ? empty : _nodes[0].box;
+  }
+
+  // Calls the given visitor with the id of each edge whose box overlaps the given box,
+  // until it returns true. Returns whether the visit was cut short
+  template <typename Visit>
+  bool Polygon::visit(const Box& box, Visit visitEdge) const {
+    if (_nodes.empty()) return false;
+
+    if (!overlaps(_nodes[0].box, box)) return false;
+
+    // Children are tested before they're pushed, so only overlapping nodes are visited
+    unsigned stack[MAX_DEPTH + 1];
+    unsigned stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize) {
+      unsigned index = stack[--stackSize];
+      const Node& node = _nodes[index];
+
+      if (node.count) {
+        for (unsigned i = node.first; i < node.first + node.count; i++) {
+          unsigned id = _order[i];
+          if (overlaps(_boxes[id], box) && visitEdge(id)) return true;
+        }
+
+        continue;
+      }
+
+      if (overlaps(_nodes[node.right].box, box)) stack[stackSize++] = node.right;
+      if (overlaps(_nodes[index + 1].box, box)) stack[stackSize++] = index + 1;
+    }
+
+    return false;
+  }
+
+  // Calls the given visitor with each pair of edges of both polygons whose boxes
+  // overlap, until it returns true. Both hierarchies are descended together, always
+  // splitting the larger node of a pair. Returns whether the visit was cut short
+  template <typename Visit>
+  bool Polygon::visitPairs(const Polygon& polygon, Visit visitEdges) const {
+    if (_nodes.empty() || polygon._nodes.empty()) return false;
+
+    std::pair<unsigned, unsigned> stack[(MAX_DEPTH * 2) + 1];
+    unsigned stackSize = 0;
+    stack[stackSize++] = { 0, 0 };
+
+    while (stackSize) {
+      std::pair<unsigned, unsigned> pair = stack[--stackSize];
+      const Node& a = _nodes[pair.first];
+      const Node& b = polygon._nodes[pair.second];
+
+      if (!overlaps(a.box, b.box)) continue;
+
+      if (a.count && b.count) {
+        for (unsigned i = a.first; i < a.first + a.count; i++) {
+          for (unsigned j = b.first; j < b.first + b.count; j++) {
+            unsigned idA = _order[i];
+            unsigned idB = polygon._order[j];
+
+            if (overlaps(_boxes[idA], polygon._boxes[idB]) && visitEdges(idA, idB)) return true;
+          }
+        }
+
+        continue;
+      }
+
+      if (!a.count && (b.count || getArea(a.box) >= getArea(b.box))) {
+        stack[stackSize++] = { a.right, pair.second };
+        stack[stackSize++] = { pair.first + 1, pair.second };
+      }
+      else {
+        stack[stackSize++] = { pair.first, b.right };
+        stack[stackSize++] = { pair.first, pair.second + 1 };
+      }
+    }
+
+    return false;
+  }
+
+  // Returns if any of the edges has the given point
+  bool Polygon::hasPoint(double x, double y) const {
+    return visit(Box { x, y, x, y }, [&](unsigned id) {
+      return _edges[id].hasPoint(x, y);
+    });
+  }
+
+  // polygon - line early-out intersection method
+  bool Polygon::intersects(const Line& line) const {
+    return visit(line.getBox(), [&](unsigned id) {
+      return line.getIntersection(_edges[id]).hasValue();
+    });
+  }
+
+  // polygon - circle early-out intersection method
+  bool Polygon::intersects(const Circle& circle) const {
+    return visit(circle.getBox(), [&](unsigned id) {
+      return circle.getIntersection(_edges[id]).hasValue();
+    });
+  }
+
+  // polygon - polygon early-out intersection method
+  bool Polygon::intersects(const Polygon& polygon) const {
+    return visitPairs(polygon, [&](unsigned id, unsigned otherId) {
+      return _edges[id].getIntersection(polygon._edges[otherId]).hasValue();
+    });
+  }
+
+  // Gathers the intersection points of the given shape with all the edges it meets,
+  // in the order of the edges
+  template <typename T>
+  const std::vector<Point>& Polygon::collectIntersection(const T& shape) {
+    _candidates.clear();
+    _points.clear();
+
+    visit(shape.getBox(), [&](unsigned id) {
+      _candidates.push_back(id);
+      return false;
+    });
+
+    std::sort(_candidates.begin(), _candidates.end());
+
+    for (unsigned id : _candidates) {
+      Intersection intersection = shape.getIntersection(_edges[id]);
+      _points.insert(_points.end(), intersection.begin(), intersection.end());
+    }
+
+    return _points;
+  }
+
+  // polygon - line intersection method. The points are kept until the next query
+  const std::vector<Point>& Polygon::getIntersection(const Line& line) {
+    return collectIntersection(line);
+  }
+
+  // polygon - circle intersection method. The points are kept until the next query
+  const std::vector<Point>& Polygon::getIntersection(const Circle& circle) {
+    return collectIntersection(circle);
+  }
+
+  // polygon - polygon intersection method, ordered by the edges of this polygon and
+  // then by the edges of the given one. The points are kept until the next query
+  const std::vector<Point>& Polygon::getIntersection(const Polygon& polygon) {
+    _pairs.clear();
+    _points.clear();
+
+    visitPairs(polygon, [&](unsigned id, unsigned otherId) {
+      _pairs.push_back({ id, otherId });
+      return false;
+    });
+
+    std::sort(_pairs.begin(), _pairs.end());
+
+    for (const std::pair<unsigned, unsigned>& pair : _pairs) {
+      Intersection intersection = _edges[pair.first].getIntersection(polygon._edges[pair.second]);
+      _points.insert(_points.end(), intersection.begin(), intersection.end());
+    }
+
+    return _points;
+  }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "box.h"
+#include "point.h"
+#include "line.h"
+#include "circle.h"
+
+namespace geometry {
+  // A set of edges, e.g. the bounds of an arena along with the obstacles within it.
+  // Edges are held by a bounding volume hierarchy, so a query only runs against the
+  // edges whose boxes overlap its own, and a whole polygon costs about the same as the
+  // few edges which are close to the queried shape. Edges keep the order they were
+  // given in, and so do the intersection points of all edges
+  class Polygon {
+  public:
+    // The most edges a leaf of the hierarchy holds
+    static const unsigned LEAF_SIZE = 4;
+
+    Polygon(const std::vector<Line>& edges);
+
+    unsigned size() const;
+
+    const Line& getEdge(unsigned id) const;
+
+    const Box& getBox() const;
+
+    bool hasPoint(double x, double y) const;
+
+    bool intersects(const Line& line) const;
+
+    bool intersects(const Circle& circle) const;
+
+    bool intersects(const Polygon& polygon) const;
+
+    const std::vector<Point>& getIntersection(const Line& line);
+
+    const std::vector<Point>& getIntersection(const Circle& circle);
+
+    const std::vector<Point>& getIntersection(const Polygon& polygon);
+
+  private:
+    // A node of the hierarchy. Nodes are stored depth first, so the left child of an
+    // inner node always follows it. Leaves hold a range of the ordered edges instead
+    struct Node {
+      Box box;
+      unsigned right;
+      unsigned first;
+      unsigned count;
+    };
+
+    // The deepest a query would go, far more than a balanced hierarchy needs
+    static const unsigned MAX_DEPTH = 64;
+
+    std::vector<Line> _edges;
+    // Edge boxes, padded like the segments of a trail
+    std::vector<Box> _boxes;
+    // Edge ids, ordered so each leaf holds a contiguous range of them
+    std::vector<unsigned> _order;
+    std::vector<Node> _nodes;
+    std::vector<unsigned> _candidates;
+    std::vector<std::pair<unsigned, unsigned>> _pairs;
+    std::vector<Point> _points;
+
+    unsigned build(unsigned first, unsigned count, unsigned depth);
+
+    template <typename Visit>
+    bool visit(const Box& box, Visit visitEdge) const;
+
+    template <typename Visit>
+    bool visitPairs(const Polygon& polygon, Visit visitEdges) const;
+
+    template <typename T>
+    const std::vector<Point>& collectIntersection(const T& shape);
+  };
+}
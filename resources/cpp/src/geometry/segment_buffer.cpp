@@ -0,0 +1,227 @@
+#include <vector>
+#include "../nullable.h"
+#include "../simd.h"
+#include "box.h"
+#include "point.h"
+#include "intersection.h"
+#include "line.h"
+#include "circle.h"
+#include "segment_buffer.h"
+
+namespace geometry {
+  unsigned SegmentBuffer::size() const {
+    return _lines.size();
+  }
+
+  const Line& SegmentBuffer::getLine(unsigned index) const {
+    return _lines.at(index);
+  }
+
+  // Lanes are padded, so the kernels can always load whole vectors out of them
+  void SegmentBuffer::resizeLanes() {
+    unsigned length = ((_lines.size() + simd::PADDING - 1) / simd::PADDING) * simd::PADDING;
+    _x1s.resize(length);
+    _y1s.resize(length);
+    _x2s.resize(length);
+    _y2s.resize(length);
+    _minXs.resize(length);
+    _minYs.resize(length);
+    _maxXs.resize(length);
+    _maxYs.resize(length);
+  }
+
+  void SegmentBuffer::append(const Line& line) {
+    unsigned index = _lines.size();
+    _lines.push_back(line);
+    resizeLanes();
+
+    _x1s[index] = line._x1;
+    _y1s[index] = line._y1;
+    _x2s[index] = line._x2;
+    _y2s[index] = line._y2;
+    _minXs[index] = line.getBox().minX;
+    _minYs[index] = line.getBox().minY;
+    _maxXs[index] = line.getBox().maxX;
+    _maxYs[index] = line.getBox().maxY;
+  }
+
+  void SegmentBuffer::pop() {
+    if (_lines.empty()) return;
+
+    _lines.pop_back();
+    resizeLanes();
+  }
+
+  void SegmentBuffer::clear() {
+    _lines.clear();
+    resizeLanes();
+  }
+
+  // Returns a bit for each of the segments starting at "from" which the given line
+  // might intersect with. A segment is filtered out if it's outside the line's box,
+  // using the exact same test the intersection method starts with, or if both ends of
+  // one of the two lies on the same side of the other, further than the box tolerance
+  unsigned SegmentBuffer::filterLines(const Line& line, unsigned from) const {
+    using namespace simd;
+
+    const Box& box = line.getBox();
+    Doubles tolerance = splat(BOX_TOLERANCE);
+
+    Mask apart = either(
+      either(
+        greaterThan(splat(box.minX), add(load(&_maxXs[from]), tolerance)),
+        greaterThan(load(&_minXs[from]), splat(box.maxX + BOX_TOLERANCE))
+      ),
+      either(
+        greaterThan(splat(box.minY), add(load(&_maxYs[from]), tolerance)),
+        greaterThan(load(&_minYs[from]), splat(box.maxY + BOX_TOLERANCE))
+      )
+    );
+
+    // Most segments are nowhere near, so there's no point going any further
+    if (bits(apart) == (1u << WIDTH) - 1) return 0;
+
+    Doubles x1 = load(&_x1s[from]);
+    Doubles y1 = load(&_y1s[from]);
+    Doubles x2 = load(&_x2s[from]);
+    Doubles y2 = load(&_y2s[from]);
+
+    // Sides of the segment's ends relative to the line, scaled by the line's length
+    double ex = line._x2 - line._x1;
+    double ey = line._y2 - line._y1;
+    Doubles lineEx = splat(ex);
+    Doubles lineEy = splat(ey);
+    Doubles lineLimit = splat(BOX_TOLERANCE * BOX_TOLERANCE * ((ex * ex) + (ey * ey)));
+    Doubles lineX1 = splat(line._x1);
+    Doubles lineY1 = splat(line._y1);
+    Doubles side1 = sub(mul(lineEx, sub(y1, lineY1)), mul(lineEy, sub(x1, lineX1)));
+    Doubles side2 = sub(mul(lineEx, sub(y2, lineY1)), mul(lineEy, sub(x2, lineX1)));
+
+    Mask segmentAside = both(
+      greaterThan(mul(side1, side2), splat(0)),
+      both(
+        greaterThan(mul(side1, side1), lineLimit),
+        greaterThan(mul(side2, side2), lineLimit)
+      )
+    );
+
+    // Sides of the line's ends relative to the segment, scaled by the segment's length
+    Doubles fx = sub(x2, x1);
+    Doubles fy = sub(y2, y1);
+    Doubles segmentLimit = mul(
+      splat(BOX_TOLERANCE * BOX_TOLERANCE), add(mul(fx, fx), mul(fy, fy))
+    );
+    Doubles side3 = sub(mul(fx, sub(lineY1, y1)), mul(fy, sub(lineX1, x1)));
+    Doubles side4 = sub(
+      mul(fx, sub(splat(line._y2), y1)), mul(fy, sub(splat(line._x2), x1))
+    );
+
+    Mask lineAside = both(
+      greaterThan(mul(side3, side4), splat(0)),
+      both(
+        greaterThan(mul(side3, side3), segmentLimit),
+        greaterThan(mul(side4, side4), segmentLimit)
+      )
+    );
+
+    unsigned rejected = bits(either(apart, either(segmentAside, lineAside)));
+
+    return ~rejected & ((1u << WIDTH) - 1);
+  }
+
+  // Returns a bit for each of the segments starting at "from" which the given arc
+  // might intersect with. A segment is filtered out if it's outside the arc's box,
+  // using the exact same test the intersection method starts with, if its closest
+  // point is further than the radius, or if it's contained by the circle entirely
+  unsigned SegmentBuffer::filterLines(const Circle& arc, unsigned from) const {
+    using namespace simd;
+
+    const Box& box = arc.getBox();
+    Doubles tolerance = splat(BOX_TOLERANCE);
+
+    Mask apart = either(
+      either(
+        greaterThan(splat(box.minX), add(load(&_maxXs[from]), tolerance)),
+        greaterThan(load(&_minXs[from]), splat(box.maxX + BOX_TOLERANCE))
+      ),
+      either(
+        greaterThan(splat(box.minY), add(load(&_maxYs[from]), tolerance)),
+        greaterThan(load(&_minYs[from]), splat(box.maxY + BOX_TOLERANCE))
+      )
+    );
+
+    // Most segments are nowhere near, so there's no point going any further
+    if (bits(apart) == (1u << WIDTH) - 1) return 0;
+
+    Doubles x1 = load(&_x1s[from]);
+    Doubles y1 = load(&_y1s[from]);
+    Doubles x2 = load(&_x2s[from]);
+    Doubles y2 = load(&_y2s[from]);
+
+    // Segment relative to the circle's center
+    Doubles px1 = sub(x1, splat(arc._x));
+    Doubles py1 = sub(y1, splat(arc._y));
+    Doubles px2 = sub(x2, splat(arc._x));
+    Doubles py2 = sub(y2, splat(arc._y));
+    Doubles fx = sub(px2, px1);
+    Doubles fy = sub(py2, py1);
+
+    // The segment's closest point to the center. Empty segments produce NaNs, in
+    // which case nothing is filtered
+    Doubles t = div(
+      sub(splat(0), add(mul(px1, fx), mul(py1, fy))),
+      add(mul(fx, fx), mul(fy, fy))
+    );
+    t = min(max(t, splat(0)), splat(1));
+    Doubles cx = add(px1, mul(t, fx));
+    Doubles cy = add(py1, mul(t, fy));
+
+    double outerR = arc._r + BOX_TOLERANCE;
+    double innerR = arc._r - BOX_TOLERANCE;
+    Mask outside = greaterThan(add(mul(cx, cx), mul(cy, cy)), splat(outerR * outerR));
+    Mask inside = both(
+      lessThan(add(mul(px1, px1), mul(py1, py1)), splat(innerR > 0 ? innerR * innerR : -1)),
+      lessThan(add(mul(px2, px2), mul(py2, py2)), splat(innerR > 0 ? innerR * innerR : -1))
+    );
+
+    unsigned rejected = bits(either(apart, either(outside, inside)));
+
+    return ~rejected & ((1u << WIDTH) - 1);
+  }
+
+  // Confirms the filtered segments one by one, in order, using the given shape's own
+  // intersection method
+  template <typename T>
+  Nullable<SegmentHit> SegmentBuffer::getFirstIntersection(const T& shape) const {
+    unsigned count = _lines.size();
+
+    for (unsigned from = 0; from < count; from += simd::WIDTH) {
+      unsigned candidates = filterLines(shape, from);
+
+      // Drop the padding lanes
+      if (count - from < simd::WIDTH) candidates &= (1u << (count - from)) - 1;
+
+      for (unsigned lane = 0; candidates; lane++, candidates >>= 1) {
+        if (!(candidates & 1)) continue;
+
+        Intersection intersection = shape.getIntersection(_lines[from + lane]);
+
+        if (intersection.hasValue()) {
+          return Nullable<SegmentHit>({ from + lane, intersection });
+        }
+      }
+    }
+
+    return Nullable<SegmentHit>();
+  }
+
+  // Returns the first segment which the given line intersects with
+  Nullable<SegmentHit> SegmentBuffer::getIntersection(const Line& line) const {
+    return getFirstIntersection(line);
+  }
+
+  // Returns the first segment which the given arc intersects with
+  Nullable<SegmentHit> SegmentBuffer::getIntersection(const Circle& arc) const {
+    return getFirstIntersection(arc);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include "../nullable.h"
+#include "point.h"
+#include "intersection.h"
+#include "line.h"
+#include "circle.h"
+
+namespace geometry {
+  class Line;
+  class Circle;
+
+  // The first segment of a buffer which was hit, along with the intersection points
+  struct SegmentHit {
+    unsigned index;
+    Intersection intersection;
+  };
+
+  // A buffer of line segments stored as a structure of arrays, so a single shape can be
+  // tested against many segments at once using vector instructions. Vector kernels only
+  // filter out segments which can't possibly be hit; the remaining ones are confirmed
+  // by the regular intersection methods, in order, so results are the same as testing
+  // the segments one by one
+  class SegmentBuffer {
+  private:
+    std::vector<Line> _lines;
+    std::vector<double> _x1s;
+    std::vector<double> _y1s;
+    std::vector<double> _x2s;
+    std::vector<double> _y2s;
+    std::vector<double> _minXs;
+    std::vector<double> _minYs;
+    std::vector<double> _maxXs;
+    std::vector<double> _maxYs;
+
+    void resizeLanes();
+
+    unsigned filterLines(const Line& line, unsigned from) const;
+
+    unsigned filterLines(const Circle& arc, unsigned from) const;
+
+    template <typename T>
+    Nullable<SegmentHit> getFirstIntersection(const T& shape) const;
+
+  public:
+    unsigned size() const;
+
+    const Line& getLine(unsigned index) const;
+
+    void append(const Line& line);
+
+    void pop();
+
+    void clear();
+
+    Nullable<SegmentHit> getIntersection(const Line& line) const;
+
+    Nullable<SegmentHit> getIntersection(const Circle& arc) const;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <vector>
+#include "point.h"
+#include "intersection.h"
+#include "line.h"
+#include "circle.h"
+#include "shape_batch.h"
+
+namespace geometry {
+  const unsigned ShapeBatch::SHAPE_STRIDE;
+
+  // shapesCapacity - The maximum number of shape descriptors in the batch
+  // pointsCapacity - The maximum number of intersection records a single call can output
+  ShapeBatch::ShapeBatch(unsigned shapesCapacity, unsigned pointsCapacity):
+    _shapes(shapesCapacity * SHAPE_STRIDE),
+    _query(SHAPE_STRIDE),
+    _points(pointsCapacity * POINT_STRIDE) {
+  }
+
+  unsigned ShapeBatch::getShapesCapacity() const {
+    return _shapes.size() / SHAPE_STRIDE;
+  }
+
+  unsigned ShapeBatch::getPointsCapacity() const {
+    return _points.size() / POINT_STRIDE;
+  }
+
+  // Tests the first "count" shapes against the query shape. Returns the number of
+  // intersections found, see writePoint()
+  unsigned ShapeBatch::intersectQuery(unsigned count) {
+    unsigned found = 0;
+
+    for (unsigned i = 0; i < count && i < getShapesCapacity(); i++) {
+      found = intersect(&_shapes.at(i * SHAPE_STRIDE), _query.data(), i, -1, found);
+    }
+
+    return found;
+  }
+
+  // Tests each pair of the first "count" shapes against each other. Returns the number
+  // of intersections found, see writePoint()
+  unsigned ShapeBatch::intersectPairs(unsigned count) {
+    unsigned found = 0;
+
+    for (unsigned i = 0; i < count && i < getShapesCapacity(); i++) {
+      for (unsigned j = i + 1; j < count && j < getShapesCapacity(); j++) {
+        found = intersect(&_shapes.at(i * SHAPE_STRIDE), &_shapes.at(j * SHAPE_STRIDE), i, j, found);
+      }
+    }
+
+    return found;
+  }
+
+  bool ShapeBatch::isCircle(const double* descriptor) const {
+    return descriptor[0] == CIRCLE;
+  }
+
+  Line ShapeBatch::getLine(const double* descriptor) const {
+    return Line(descriptor[1], descriptor[2], descriptor[3], descriptor[4]);
+  }
+
+  Circle ShapeBatch::getCircle(const double* descriptor) const {
+    return Circle(descriptor[1], descriptor[2], descriptor[3], descriptor[4], descriptor[5]);
+  }
+
+  // Intersects 2 shape descriptors and writes the results. Returns the updated number
+  // of intersections found
+  unsigned ShapeBatch::intersect(const double* descriptorA, const double* descriptorB,
+      double indexA, double indexB, unsigned found) {
+    Intersection intersection;
+
+    if (isCircle(descriptorA)) {
+      Circle circle = getCircle(descriptorA);
+      intersection = isCircle(descriptorB) ?
+        circle.getIntersection(getCircle(descriptorB)) :
+        circle.getIntersection(getLine(descriptorB));
+    }
+    else {
+      Line line = getLine(descriptorA);
+      intersection = isCircle(descriptorB) ?
+        line.getIntersection(getCircle(descriptorB)) :
+        line.getIntersection(getLine(descriptorB));
+    }
+
+    for (const Point& point : intersection) {
+      found = writePoint(indexA, indexB, point, found);
+    }
+
+    return found;
+  }
+
+  // Writes an intersection record as long as there is room for it. Intersections past
+  // the capacity are still counted, so a count which exceeds getPointsCapacity() tells
+  // that only the first records were written
+  unsigned ShapeBatch::writePoint(double indexA, double indexB, const Point& point, unsigned found) {
+    if (found >= getPointsCapacity()) return found + 1;
+
+    double* record = &_points.at(found * POINT_STRIDE);
+    record[0] = indexA;
+    record[1] = indexB;
+    record[2] = point.x;
+    record[3] = point.y;
+
+    return found + 1;
+  }
+}
\ No newline at end of file
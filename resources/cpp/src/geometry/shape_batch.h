@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include "line.h"
+#include "circle.h"
+
+namespace geometry {
+  // A batch of shape descriptors which lives in linear memory, so it can be filled and
+  // read through typed array views without creating any objects.
+  // Each shape descriptor is made out of 6 numbers:
+  // line - type, x1, y1, x2, y2, (unused)
+  // circle - type, x, y, r, rad1, rad2
+  // Each intersection record is made out of 4 numbers:
+  // first shape index, second shape index (-1 for the query shape), x, y
+  class ShapeBatch {
+  public:
+    static const unsigned LINE = 0;
+    static const unsigned CIRCLE = 1;
+    static const unsigned SHAPE_STRIDE = 6;
+    static const unsigned POINT_STRIDE = 4;
+
+    std::vector<double> _shapes;
+    std::vector<double> _query;
+    std::vector<double> _points;
+
+    ShapeBatch(unsigned shapesCapacity, unsigned pointsCapacity);
+
+    unsigned getShapesCapacity() const;
+
+    unsigned getPointsCapacity() const;
+
+    unsigned intersectQuery(unsigned count);
+
+    unsigned intersectPairs(unsigned count);
+
+  private:
+    bool isCircle(const double* descriptor) const;
+
+    Line getLine(const double* descriptor) const;
+
+    Circle getCircle(const double* descriptor) const;
+
+    unsigned intersect(const double* descriptorA, const double* descriptorB,
+      double indexA, double indexB, unsigned found);
+
+    unsigned writePoint(double indexA, double indexB, const Point& point, unsigned found);
+  };
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include <vector>
+#include "intersection.h"
+#include "backend.h"
+#include "shape_list.h"
+
+namespace geometry {
+  template <typename Backend>
+  unsigned ShapeList<Backend>::size() const {
+    return _entries.size();
+  }
+
+  template <typename Backend>
+  bool ShapeList<Backend>::isCircle(unsigned index) const {
+    return _entries.at(index).circle;
+  }
+
+  template <typename Backend>
+  const typename Backend::LineType& ShapeList<Backend>::getLine(unsigned index) const {
+    return _lines.at(_entries.at(index).index);
+  }
+
+  template <typename Backend>
+  const typename Backend::CircleType& ShapeList<Backend>::getCircle(unsigned index) const {
+    return _circles.at(_entries.at(index).index);
+  }
+
+  template <typename Backend>
+  void ShapeList<Backend>::appendLine(double x1, double y1, double x2, double y2) {
+    _entries.push_back({ false, (unsigned) _lines.size() });
+    _lines.push_back(LineType(x1, y1, x2, y2));
+  }
+
+  template <typename Backend>
+  void ShapeList<Backend>::appendCircle(double x, double y, double r, double rad1, double rad2) {
+    _entries.push_back({ true, (unsigned) _circles.size() });
+    _circles.push_back(CircleType(x, y, r, rad1, rad2));
+  }
+
+  template <typename Backend>
+  void ShapeList<Backend>::clear() {
+    _entries.clear();
+    _lines.clear();
+    _circles.clear();
+  }
+
+  // Returns the intersection points with the earliest shape which intersects with the
+  // given one, which should be a shape of the same backend
+  template <typename Backend>
+  template <typename T>
+  Intersection ShapeList<Backend>::getIntersection(const T& shape) const {
+    for (const Entry& entry : _entries) {
+      Intersection intersection = entry.circle ?
+        shape.getIntersection(_circles[entry.index]) :
+        shape.getIntersection(_lines[entry.index]);
+
+      if (intersection.hasValue()) return intersection;
+    }
+
+    return Intersection();
+  }
+}
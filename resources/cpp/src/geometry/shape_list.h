@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include "intersection.h"
+#include "backend.h"
+
+namespace geometry {
+  // A plain list of lines and circles of the given backend, see backend.h. Queries scan
+  // all the shapes in order, so both backends can be compared shape for shape, e.g. on
+  // the trails of recorded matches
+  template <typename Backend>
+  class ShapeList {
+  public:
+    typedef typename Backend::LineType LineType;
+    typedef typename Backend::CircleType CircleType;
+
+    unsigned size() const;
+
+    bool isCircle(unsigned index) const;
+
+    const LineType& getLine(unsigned index) const;
+
+    const CircleType& getCircle(unsigned index) const;
+
+    void appendLine(double x1, double y1, double x2, double y2);
+
+    void appendCircle(double x, double y, double r, double rad1, double rad2);
+
+    void clear();
+
+    template <typename T>
+    Intersection getIntersection(const T& shape) const;
+
+  private:
+    struct Entry {
+      bool circle;
+      unsigned index;
+    };
+
+    std::vector<Entry> _entries;
+    std::vector<LineType> _lines;
+    std::vector<CircleType> _circles;
+  };
+}
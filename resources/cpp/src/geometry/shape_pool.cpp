@@ -0,0 +1,121 @@
+#include <stdexcept>
+#include <vector>
+#include "line.h"
+#include "circle.h"
+#include "shape_pool.h"
+
+namespace geometry {
+  ShapePool::ShapePool():
+    _linesCount(0),
+    _circlesCount(0),
+    _generation(0),
+    _stats({ 0, 0, 0, 0, 0 }) {
+  }
+
+  ShapeHandle ShapePool::getHandle(bool isCircle, unsigned slot) const {
+    if (slot > SLOT_MASK) throw std::length_error("ShapePool: out of handles");
+
+    return (isCircle ? CIRCLE_BIT : 0) | (_generation << GENERATION_SHIFT) | slot;
+  }
+
+  // Returns the slot of the given handle, making sure it's still allocated
+  unsigned ShapePool::getSlot(ShapeHandle handle, bool isCircle) const {
+    unsigned slot = handle & SLOT_MASK;
+    unsigned count = isCircle ? _circlesCount : _linesCount;
+
+    if (bool(handle & CIRCLE_BIT) != isCircle ||
+        ((handle >> GENERATION_SHIFT) & GENERATION_MASK) != _generation ||
+        slot >= count) {
+      throw std::out_of_range("ShapePool: stale or mismatching handle");
+    }
+
+    return slot;
+  }
+
+  unsigned ShapePool::size() const {
+    return _linesCount + _circlesCount;
+  }
+
+  ShapePoolStats ShapePool::getStats() const {
+    ShapePoolStats stats = _stats;
+    stats.live = size();
+    stats.capacity = _lines.capacity() + _circles.capacity();
+    return stats;
+  }
+
+  bool ShapePool::isCircle(ShapeHandle handle) const {
+    return handle & CIRCLE_BIT;
+  }
+
+  const Line& ShapePool::getLine(ShapeHandle handle) const {
+    return _lines[getSlot(handle, false)];
+  }
+
+  const Circle& ShapePool::getCircle(ShapeHandle handle) const {
+    return _circles[getSlot(handle, true)];
+  }
+
+  // Slots which were freed by a reset are overwritten before the storage grows
+  ShapeHandle ShapePool::allocate(const Line& line) {
+    ShapeHandle handle = getHandle(false, _linesCount);
+
+    if (_linesCount < _lines.size()) {
+      _lines[_linesCount] = line;
+    }
+    else {
+      if (_lines.size() == _lines.capacity()) _stats.growths++;
+      _lines.push_back(line);
+    }
+
+    _linesCount++;
+    _stats.allocations++;
+
+    return handle;
+  }
+
+  ShapeHandle ShapePool::allocate(const Circle& circle) {
+    ShapeHandle handle = getHandle(true, _circlesCount);
+
+    if (_circlesCount < _circles.size()) {
+      _circles[_circlesCount] = circle;
+    }
+    else {
+      if (_circles.size() == _circles.capacity()) _stats.growths++;
+      _circles.push_back(circle);
+    }
+
+    _circlesCount++;
+    _stats.allocations++;
+
+    return handle;
+  }
+
+  // Replaces an allocated shape in place
+  void ShapePool::set(ShapeHandle handle, const Line& line) {
+    _lines[getSlot(handle, false)] = line;
+  }
+
+  void ShapePool::set(ShapeHandle handle, const Circle& circle) {
+    _circles[getSlot(handle, true)] = circle;
+  }
+
+  // Frees a single shape. Only the most recent shape of each kind can be freed, the
+  // rest are freed by a reset
+  void ShapePool::release(ShapeHandle handle) {
+    bool circle = isCircle(handle);
+    unsigned slot = getSlot(handle, circle);
+    unsigned& count = circle ? _circlesCount : _linesCount;
+
+    if (slot != count - 1) throw std::invalid_argument("ShapePool: not the most recent shape");
+
+    count--;
+  }
+
+  // Frees all the shapes at once. Handles which were given so far become stale
+  void ShapePool::reset() {
+    _linesCount = 0;
+    _circlesCount = 0;
+    _generation = (_generation + 1) & GENERATION_MASK;
+    _stats.resets++;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include "line.h"
+#include "circle.h"
+
+namespace geometry {
+  class Line;
+  class Circle;
+
+  // Addresses a shape in a pool. The high bit tells circles apart from lines, the
+  // next 7 bits hold the pool's generation so handles which outlived a reset are
+  // caught, and the rest hold the shape's slot
+  typedef unsigned ShapeHandle;
+
+  struct ShapePoolStats {
+    // Shapes which were allocated since the pool was created
+    unsigned long allocations;
+    // Shapes which are currently allocated
+    unsigned live;
+    // Shapes the pool can hold before its storage has to grow
+    unsigned capacity;
+    // The number of times the storage has grown, each time being a heap allocation
+    unsigned growths;
+    unsigned resets;
+  };
+
+  // Contiguous storage for the lines and circles of a single owner, e.g. a trail.
+  // Shapes are freed all at once by a reset, which keeps the storage around, so a
+  // pool which is reused across matches stops allocating once it's grown enough
+  class ShapePool {
+  private:
+    static const unsigned CIRCLE_BIT = 1u << 31;
+    static const unsigned GENERATION_SHIFT = 24;
+    static const unsigned GENERATION_MASK = 0x7f;
+    static const unsigned SLOT_MASK = (1u << GENERATION_SHIFT) - 1;
+
+    std::vector<Line> _lines;
+    std::vector<Circle> _circles;
+    unsigned _linesCount;
+    unsigned _circlesCount;
+    unsigned _generation;
+    ShapePoolStats _stats;
+
+    ShapeHandle getHandle(bool isCircle, unsigned slot) const;
+
+    unsigned getSlot(ShapeHandle handle, bool isCircle) const;
+
+  public:
+    ShapePool();
+
+    unsigned size() const;
+
+    ShapePoolStats getStats() const;
+
+    bool isCircle(ShapeHandle handle) const;
+
+    const Line& getLine(ShapeHandle handle) const;
+
+    const Circle& getCircle(ShapeHandle handle) const;
+
+    ShapeHandle allocate(const Line& line);
+
+    ShapeHandle allocate(const Circle& circle);
+
+    void set(ShapeHandle handle, const Line& line);
+
+    void set(ShapeHandle handle, const Circle& circle);
+
+    void release(ShapeHandle handle);
+
+    void reset();
+  };
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cmath>
+#include "../utils.h"
+#include "box.h"
+#include "point.h"
+#include "line.h"
+#include "circle.h"
+#include "sweep.h"
+
+namespace geometry {
+  // x - The x value of the head at the beginning of the step
+  // y - The y value of the head at the beginning of the step
+  // rad - The heading at the beginning of the step
+  // step - The distance the head makes along the step
+  // r - The radius of the circle the head turns around, if it turns
+  // turn - The way the head turns, if at all
+  Sweep::Sweep(double x, double y, double rad, double step, double r, Turn turn):
+    _head { x, y },
+    _rad(rad),
+    _step(step),
+    _r(r),
+    _turn(turn),
+    _startRad(0),
+    _sweep(0),
+    _line(x, y, x + (step * std::cos(rad)), y + (step * std::sin(rad))),
+    _circle(x, y, r, rad, rad) {
+    if (turn == Turn::NONE) return;
+
+    // The center is on the inner side of the turn, and the head starts off at a right
+    // angle to its heading, the same way a snake's circles are made
+    double side = turn == Turn::LEFT ? -1 : 1;
+    double cx = x + (r * std::cos(rad + (side * 0.5 * M_PI)));
+    double cy = y + (r * std::sin(rad + (side * 0.5 * M_PI)));
+
+    _startRad = rad - (side * 0.5 * M_PI);
+    _sweep = std::min(step / r, 2 * M_PI);
+    _circle = turn == Turn::LEFT ?
+      Circle(cx, cy, r, _startRad - _sweep, _startRad) :
+      Circle(cx, cy, r, _startRad, _startRad + _sweep);
+  }
+
+  bool Sweep::isTurning() const {
+    return _turn != Turn::NONE;
+  }
+
+  // The path of a straight sweep
+  const Line& Sweep::getLine() const {
+    return _line;
+  }
+
+  // The path of a turning sweep
+  const Circle& Sweep::getCircle() const {
+    return _circle;
+  }
+
+  const Box& Sweep::getBox() const {
+    return isTurning() ? _circle.getBox() : _line.getBox();
+  }
+
+  double Sweep::getStep() const {
+    return _step;
+  }
+
+  // Returns the time at which the head passes by the given point, which is assumed to
+  // be on the path, e.g. an intersection point with it. Points are trimmed to 9
+  // decimals, so ones which fall slightly beyond the path are snapped to its nearest end
+  double Sweep::getTime(const Point& point) const {
+    if (_step <= 0) return 0;
+
+    if (!isTurning()) {
+      double distance =
+        ((point.x - _head.x) * std::cos(_rad)) + ((point.y - _head.y) * std::sin(_rad));
+      return std::min(std::max(distance / _step, 0.0), 1.0);
+    }
+
+    double rad = std::atan2(point.y - _circle._y, point.x - _circle._x);
+    double turned = _turn == Turn::LEFT ?
+      utils::mod(_startRad - rad, 2 * M_PI) :
+      utils::mod(rad - _startRad, 2 * M_PI);
+
+    if (turned > _sweep) turned = turned - _sweep < (2 * M_PI) - turned ? _sweep : 0;
+
+    return (turned * _r) / _step;
+  }
+
+  // Returns the position of the head at the given time
+  Point Sweep::getPoint(double time) const {
+    double distance = time * _step;
+
+    if (!isTurning()) {
+      return { _head.x + (distance * std::cos(_rad)), _head.y + (distance * std::sin(_rad)) };
+    }
+
+    double rad = _turn == Turn::LEFT ? _startRad - (distance / _r) : _startRad + (distance / _r);
+    return { _circle._x + (_r * std::cos(rad)), _circle._y + (_r * std::sin(rad)) };
+  }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "box.h"
+#include "point.h"
+#include "line.h"
+#include "circle.h"
+
+namespace geometry {
+  class Line;
+  class Circle;
+
+  // The way a head turns along a sweep. Radians grow clockwise on the canvas, so a left
+  // turn runs the circle's radians backwards and a right turn runs them forwards
+  enum class Turn {
+    NONE,
+    LEFT,
+    RIGHT
+  };
+
+  // The earliest impact of a sweep so far. Sweeps only look for impacts which are
+  // earlier than the current time, so it's initialized with 1, the end of the step
+  struct Impact {
+    // The fraction of the step at which the head hits, from 0 to 1
+    double time;
+    // Tags the trail which was hit, e.g. with the index of its snake, or -1 for none
+    int owner;
+    // The id of the segment which was hit within its trail
+    int segment;
+    // A bit for each arena edge which was hit, see Arena
+    unsigned edges;
+
+    bool hasValue() const {
+      return segment != -1 || edges != 0;
+    }
+  };
+
+  // The path a head makes over a whole step, either a line along its heading or an arc
+  // of the circle it turns around. Unlike testing the last bit once it was made, points
+  // along the path are ordered by time, so the earliest impact can be told apart no
+  // matter how long the step is. A turn is capped at a whole circle, at which point the
+  // head has surely run into its own path
+  class Sweep {
+  private:
+    Point _head;
+    double _rad;
+    double _step;
+    double _r;
+    Turn _turn;
+    // The radian of the head on the turning circle, and how far it turns from there
+    double _startRad;
+    double _sweep;
+    Line _line;
+    Circle _circle;
+
+  public:
+    Sweep(double x, double y, double rad, double step, double r = 0, Turn turn = Turn::NONE);
+
+    bool isTurning() const;
+
+    const Line& getLine() const;
+
+    const Circle& getCircle() const;
+
+    const Box& getBox() const;
+
+    double getStep() const;
+
+    double getTime(const Point& point) const;
+
+    Point getPoint(double time) const;
+  };
+}
@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "box.h"
+#include "sweep_and_prune.h"
+
+namespace geometry {
+  namespace {
+    // Ends are sorted by their value, where minimums come first, so boxes which only
+    // touch one another are still considered to overlap
+    template <typename T>
+    bool isBefore(double value, bool max, const T& endpoint) {
+      return value < endpoint.value || (value == endpoint.value && !max && endpoint.max);
+    }
+  }
+
+  SweepAndPrune::SweepAndPrune(): _queries(MAX_QUERIES, -1), _shapesCount(0) {
+  }
+
+  // Proxies are recycled, so a broad phase which is reused across matches stops
+  // allocating memory
+  unsigned SweepAndPrune::allocateProxy(const Box& box, unsigned owner, unsigned segment,
+      bool query) {
+    unsigned proxy;
+
+    if (_freeProxies.empty()) {
+      proxy = _proxies.size();
+      _proxies.push_back(Proxy());
+    }
+    else {
+      proxy = _freeProxies.back();
+      _freeProxies.pop_back();
+    }
+
+    _proxies[proxy] = { box, owner, segment, query, true, 0, 0, { 0, 0 } };
+
+    return proxy;
+  }
+
+  // Inserts both ends of the given proxy at their sorted positions. Whatever the proxy
+  // overlaps is calculated by the caller, since nothing is swapped along the way
+  void SweepAndPrune::insertEndpoints(unsigned proxy) {
+    const Box& box = _proxies[proxy].box;
+    unsigned from = _endpoints.size();
+
+    for (bool max : { false, true }) {
+      double value = max ? box.maxX : box.minX;
+      auto position = std::upper_bound(_endpoints.begin(), _endpoints.end(), value,
+        [max](double value, const Endpoint& endpoint) {
+          return isBefore(value, max, endpoint);
+        });
+
+      from = std::min<unsigned>(from, position - _endpoints.begin());
+      _endpoints.insert(position, { value, proxy, max });
+    }
+
+    updatePositions(from);
+  }
+
+  void SweepAndPrune::eraseEndpoints(unsigned proxy) {
+    const Proxy& erased = _proxies[proxy];
+    unsigned min = erased.ends[0];
+
+    _endpoints.erase(_endpoints.begin() + erased.ends[1]);
+    _endpoints.erase(_endpoints.begin() + min);
+    updatePositions(min);
+  }
+
+  // Records the positions of all the ends from the given one onwards, once ends were
+  // inserted or erased before them
+  void SweepAndPrune::updatePositions(unsigned from) {
+    for (unsigned index = from; index < _endpoints.size(); index++) {
+      const Endpoint& endpoint = _endpoints[index];
+      _proxies[endpoint.proxy].ends[endpoint.max] = index;
+    }
+  }
+
+  // Sets the value of the end at the given position, and swaps it with its neighbours
+  // until the list is sorted again
+  void SweepAndPrune::moveEndpoint(unsigned index, double value) {
+    _endpoints[index].value = value;
+    bool max = _endpoints[index].max;
+
+    while (index > 0 && isBefore(value, max, _endpoints[index - 1])) {
+      swapEndpoints(index - 1);
+      index--;
+    }
+
+    while (index + 1 < _endpoints.size() &&
+           isBefore(_endpoints[index + 1].value, _endpoints[index + 1].max, _endpoints[index])) {
+      swapEndpoints(index);
+      index++;
+    }
+  }
+
+  // Swaps the end at the given position with the one which follows it. A query and a
+  // shape start overlapping once a minimum passes a maximum to its left, and stop
+  // overlapping once a maximum passes a minimum to its left
+  void SweepAndPrune::swapEndpoints(unsigned left) {
+    Endpoint& a = _endpoints[left];
+    Endpoint& b = _endpoints[left + 1];
+    const Proxy& proxyA = _proxies[a.proxy];
+    const Proxy& proxyB = _proxies[b.proxy];
+
+    if (a.max != b.max && proxyA.query != proxyB.query) {
+      unsigned shape = proxyA.query ? b.proxy : a.proxy;
+      unsigned query = proxyA.query ? proxyA.segment : proxyB.segment;
+      // The end which moves to the left is the one which was on the right
+      setOverlap(shape, query, !b.max);
+    }
+
+    std::swap(a, b);
+    _proxies[a.proxy].ends[a.max] = left;
+    _proxies[b.proxy].ends[b.max] = left + 1;
+  }
+
+  void SweepAndPrune::setOverlap(unsigned shape, unsigned query, bool overlaps) {
+    Proxy& proxy = _proxies[shape];
+    unsigned long long bit = 1ull << query;
+
+    if (!overlaps) {
+      proxy.overlaps &= ~bit;
+      return;
+    }
+
+    proxy.overlaps |= bit;
+
+    if (!(proxy.listed & bit)) {
+      proxy.listed |= bit;
+      _listedPairs.push_back({ shape, query });
+    }
+  }
+
+  // Adds a shape and returns its proxy, which is used to refer to it later on
+  unsigned SweepAndPrune::addShape(const Box& box, unsigned owner, unsigned segment) {
+    unsigned proxy = allocateProxy(box, owner, segment, false);
+
+    for (unsigned query = 0; query < MAX_QUERIES; query++) {
+      if (_queries[query] == -1) continue;
+
+      const Box& queryBox = _proxies[_queries[query]].box;
+      if (box.minX <= queryBox.maxX && queryBox.minX <= box.maxX) setOverlap(proxy, query, true);
+    }
+
+    insertEndpoints(proxy);
+    _shapesCount++;
+
+    return proxy;
+  }
+
+  // Moves the box of the given proxy. Ends are moved in the direction the box moves,
+  // the leading one first, so a minimum would never pass its own maximum
+  void SweepAndPrune::updateShape(unsigned proxy, const Box& box) {
+    Proxy& moved = _proxies[proxy];
+
+    if (box.minX > moved.box.minX) {
+      moveEndpoint(moved.ends[1], box.maxX);
+      moveEndpoint(moved.ends[0], box.minX);
+    }
+    else {
+      moveEndpoint(moved.ends[0], box.minX);
+      moveEndpoint(moved.ends[1], box.maxX);
+    }
+
+    moved.box = box;
+  }
+
+  // Any pair of the removed proxy which is still listed is dropped once pairs are fetched
+  void SweepAndPrune::removeShape(unsigned proxy) {
+    eraseEndpoints(proxy);
+    _proxies[proxy].live = false;
+    _proxies[proxy].overlaps = 0;
+    _freeProxies.push_back(proxy);
+    _shapesCount--;
+  }
+
+  // Removes all the shapes of the given owner at once, e.g. once a snake is out
+  void SweepAndPrune::removeOwner(unsigned owner) {
+    auto removed = [this, owner](const Endpoint& endpoint) {
+      const Proxy& proxy = _proxies[endpoint.proxy];
+      return !proxy.query && proxy.owner == owner;
+    };
+
+    _endpoints.erase(std::remove_if(_endpoints.begin(), _endpoints.end(), removed), _endpoints.end());
+    updatePositions(0);
+
+    for (unsigned proxy = 0; proxy < _proxies.size(); proxy++) {
+      Proxy& shape = _proxies[proxy];
+      if (!shape.live || shape.query || shape.owner != owner) continue;
+
+      shape.live = false;
+      shape.overlaps = 0;
+      _freeProxies.push_back(proxy);
+      _shapesCount--;
+    }
+  }
+
+  // Adds or moves the box of the given query
+  void SweepAndPrune::setQuery(unsigned query, const Box& box) {
+    if (query >= MAX_QUERIES) throw std::out_of_range("SweepAndPrune: query out of range");
+
+    if (_queries[query] != -1) {
+      updateShape(_queries[query], box);
+      return;
+    }
+
+    unsigned proxy = allocateProxy(box, 0, query, true);
+    _queries[query] = proxy;
+
+    for (unsigned shape = 0; shape < _proxies.size(); shape++) {
+      const Proxy& shapeProxy = _proxies[shape];
+      if (!shapeProxy.live || shapeProxy.query) continue;
+
+      if (box.minX <= shapeProxy.box.maxX && shapeProxy.box.minX <= box.maxX) {
+        setOverlap(shape, query, true);
+      }
+    }
+
+    insertEndpoints(proxy);
+  }
+
+  void SweepAndPrune::removeQuery(unsigned query) {
+    if (query >= MAX_QUERIES || _queries[query] == -1) return;
+
+    unsigned proxy = _queries[query];
+    eraseEndpoints(proxy);
+    _proxies[proxy].live = false;
+    _freeProxies.push_back(proxy);
+    _queries[query] = -1;
+
+    for (Proxy& shape : _proxies) shape.overlaps &= ~(1ull << query);
+  }
+
+  // Removes all the queries and shapes, while keeping the storage for the next ones
+  void SweepAndPrune::clear() {
+    _proxies.clear();
+    _freeProxies.clear();
+    _endpoints.clear();
+    _listedPairs.clear();
+    _pairs.clear();
+    std::fill(_queries.begin(), _queries.end(), -1);
+    _shapesCount = 0;
+  }
+
+  unsigned SweepAndPrune::getShapesCount() const {
+    return _shapesCount;
+  }
+
+  // Returns the queries and shapes whose boxes overlap, sorted by query and then by
+  // shape, so the order doesn't depend on the order boxes were moved in. Pairs which
+  // no longer overlap along x are dropped from the list along the way
+  const std::vector<BroadPhasePair>& SweepAndPrune::getPairs() {
+    for (const ListedPair& pair : _listedPairs) {
+      _proxies[pair.proxy].listed &= ~(1ull << pair.query);
+    }
+
+    unsigned kept = 0;
+    _pairs.clear();
+
+    for (const ListedPair& pair : _listedPairs) {
+      Proxy& shape = _proxies[pair.proxy];
+      unsigned long long bit = 1ull << pair.query;
+
+      if (!(shape.overlaps & bit) || (shape.listed & bit)) continue;
+
+      shape.listed |= bit;
+      _listedPairs[kept++] = pair;
+
+      const Box& queryBox = _proxies[_queries[pair.query]].box;
+      if (shape.box.minY <= queryBox.maxY && queryBox.minY <= shape.box.maxY) {
+        _pairs.push_back({ pair.query, shape.owner, shape.segment });
+      }
+    }
+
+    _listedPairs.resize(kept);
+
+    std::sort(_pairs.begin(), _pairs.end(), [](const BroadPhasePair& a, const BroadPhasePair& b) {
+      if (a.query != b.query) return a.query < b.query;
+      if (a.owner != b.owner) return a.owner < b.owner;
+      return a.segment < b.segment;
+    });
+
+    return _pairs;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+#include "box.h"
+
+namespace geometry {
+  // A candidate pair of the broad phase, made out of a query and a shape whose boxes
+  // overlap. Shapes are identified by their owner and their segment within it
+  struct BroadPhasePair {
+    unsigned query;
+    unsigned owner;
+    unsigned segment;
+  };
+
+  // An incremental sweep and prune broad phase, which pairs a few query boxes, e.g. the
+  // last bits of the snakes, with many shape boxes, e.g. the segments of their trails.
+  // The ends of all boxes are kept in a single list sorted along x. Boxes only move a
+  // little between steps, so the list is kept sorted by swapping neighbours, and a
+  // query and a shape start or stop overlapping along x exactly when their ends swap.
+  // Pairs are checked along y only once they're fetched
+  class SweepAndPrune {
+  public:
+    static const unsigned MAX_QUERIES = 64;
+
+    SweepAndPrune();
+
+    unsigned addShape(const Box& box, unsigned owner, unsigned segment);
+
+    void updateShape(unsigned proxy, const Box& box);
+
+    void removeShape(unsigned proxy);
+
+    void removeOwner(unsigned owner);
+
+    void setQuery(unsigned query, const Box& box);
+
+    void removeQuery(unsigned query);
+
+    void clear();
+
+    unsigned getShapesCount() const;
+
+    const std::vector<BroadPhasePair>& getPairs();
+
+  private:
+    struct Proxy {
+      Box box;
+      unsigned owner;
+      unsigned segment;
+      bool query;
+      bool live;
+      // A bit for each query the shape overlaps along x
+      unsigned long long overlaps;
+      // A bit for each query the shape is listed with in the pairs list
+      unsigned long long listed;
+      // The positions of the box's minimum and maximum in the list of ends
+      unsigned ends[2];
+    };
+
+    struct Endpoint {
+      double value;
+      unsigned proxy;
+      bool max;
+    };
+
+    struct ListedPair {
+      unsigned proxy;
+      unsigned query;
+    };
+
+    std::vector<Proxy> _proxies;
+    std::vector<unsigned> _freeProxies;
+    std::vector<Endpoint> _endpoints;
+    std::vector<int> _queries;
+    std::vector<ListedPair> _listedPairs;
+    std::vector<BroadPhasePair> _pairs;
+    unsigned _shapesCount;
+
+    unsigned allocateProxy(const Box& box, unsigned owner, unsigned segment, bool query);
+
+    void insertEndpoints(unsigned proxy);
+
+    void eraseEndpoints(unsigned proxy);
+
+    void updatePositions(unsigned from);
+
+    void moveEndpoint(unsigned index, double value);
+
+    void swapEndpoints(unsigned left);
+
+    void setOverlap(unsigned shape, unsigned query, bool overlaps);
+  };
+}
\ No newline at end of file
@@ -0,0 +1,376 @@
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../nullable.h"
+#include "box.h"
+#include "point.h"
+#include "intersection.h"
+#include "line.h"
+#include "circle.h"
+#include "shape_pool.h"
+#include "sweep.h"
+#include "trail_index.h"
+
+namespace geometry {
+  namespace {
+    // The distance from the given point to the nearest point of the given box
+    double getBoxDistance(const Box& box, const Point& point) {
+      double dx = std::max({ box.minX - point.x, 0.0, point.x - box.maxX });
+      double dy = std::max({ box.minY - point.y, 0.0, point.y - box.maxY });
+      return std::sqrt((dx * dx) + (dy * dy));
+    }
+
+    // Whether the given ray meets the given box before reaching the given distance,
+    // by clipping it against the box's slabs one axis at a time
+    bool reachesBox(const Point& origin, const Point& direction, double reach, const Box& box) {
+      double near = 0;
+      double far = reach;
+
+      for (int axis = 0; axis < 2; axis++) {
+        double position = axis ? origin.y : origin.x;
+        double step = axis ? direction.y : direction.x;
+        double min = axis ? box.minY : box.minX;
+        double max = axis ? box.maxY : box.maxX;
+
+        if (step == 0) {
+          if (position < min || position > max) return false;
+          continue;
+        }
+
+        double enter = (min - position) / step;
+        double exit = (max - position) / step;
+        if (enter > exit) std::swap(enter, exit);
+
+        near = std::max(near, enter);
+        far = std::min(far, exit);
+        if (near > far) return false;
+      }
+
+      return true;
+    }
+  }
+
+  // cellSize - The width and height of each grid cell. Intersection results are
+  // compared with a round precision, so bounding boxes are padded by a single unit
+  TrailIndex::TrailIndex(double cellSize):
+    _cellSize(cellSize),
+    _stamp(0),
+    _dirtyFrom(0) {
+  }
+
+  // Packs a cell's column and row into a single hash key
+  long long TrailIndex::getCellKey(long long column, long long row) const {
+    return (long long) (((unsigned long long) column << 32) ^ ((unsigned long long) row & 0xffffffff));
+  }
+
+  // Registers segment in all the cells its bounding box covers. Since segments are
+  // always registered in an ascending order, each cell's list remains sorted.
+  // Query buffers are reserved here, so queries themselves would never allocate
+  void TrailIndex::insertSegment(unsigned id) {
+    _stamps.resize(_segments.size());
+    _candidates.reserve(_segments.size());
+
+    const Box& box = _segments.at(id).box;
+    long long minColumn = std::floor(box.minX / _cellSize);
+    long long maxColumn = std::floor(box.maxX / _cellSize);
+    long long minRow = std::floor(box.minY / _cellSize);
+    long long maxRow = std::floor(box.maxY / _cellSize);
+
+    for (long long column = minColumn; column <= maxColumn; column++) {
+      for (long long row = minRow; row <= maxRow; row++) {
+        _cells[getCellKey(column, row)].push_back(id);
+      }
+    }
+  }
+
+  // Unregisters the most recent segment from all the cells its bounding box covers
+  void TrailIndex::removeSegment(unsigned id) {
+    const Box& box = _segments.at(id).box;
+    long long minColumn = std::floor(box.minX / _cellSize);
+    long long maxColumn = std::floor(box.maxX / _cellSize);
+    long long minRow = std::floor(box.minY / _cellSize);
+    long long maxRow = std::floor(box.maxY / _cellSize);
+
+    for (long long column = minColumn; column <= maxColumn; column++) {
+      for (long long row = minRow; row <= maxRow; row++) {
+        auto cell = _cells.find(getCellKey(column, row));
+        if (cell == _cells.end()) continue;
+
+        std::vector<unsigned>& ids = cell->second;
+        if (!ids.empty() && ids.back() == id) ids.pop_back();
+      }
+    }
+  }
+
+  // Gathers the ids of all segments below the given limit which share a cell with the
+  // given box, sorted by the order they were appended in. Segments which span multiple
+  // cells are stamped once collected, so they won't be collected twice. A box which
+  // covers more cells than there are segments is cheaper to check against them directly
+  void TrailIndex::collectCandidates(const Box& box, unsigned limit) {
+    _candidates.clear();
+
+    // Once the stamp wraps around, stamps of queries long gone would match again
+    if (++_stamp == 0) {
+      std::fill(_stamps.begin(), _stamps.end(), 0);
+      _stamp = 1;
+    }
+
+    long long minColumn = std::floor(box.minX / _cellSize);
+    long long maxColumn = std::floor(box.maxX / _cellSize);
+    long long minRow = std::floor(box.minY / _cellSize);
+    long long maxRow = std::floor(box.maxY / _cellSize);
+
+    if ((maxColumn - minColumn + 1) * (maxRow - minRow + 1) > (long long) limit) {
+      for (unsigned id = 0; id < limit && id < _segments.size(); id++) {
+        if (_segments.at(id).box.overlaps(box)) _candidates.push_back(id);
+      }
+
+      return;
+    }
+
+    for (long long column = minColumn; column <= maxColumn; column++) {
+      for (long long row = minRow; row <= maxRow; row++) {
+        auto cell = _cells.find(getCellKey(column, row));
+        if (cell == _cells.end()) continue;
+
+        for (unsigned id : cell->second) {
+          if (id >= limit) break;
+          if (_stamps.at(id) == _stamp) continue;
+
+          _stamps.at(id) = _stamp;
+          if (_segments.at(id).box.overlaps(box)) _candidates.push_back(id);
+        }
+      }
+    }
+
+    std::sort(_candidates.begin(), _candidates.end());
+  }
+
+  // Returns the intersection points with the earliest segment which intersects with
+  // given shape, ignoring the last few segments specified by "skip"
+  template <typename T>
+  Intersection TrailIndex::getFirstIntersection(const T& shape, unsigned skip) {
+    if (skip >= _segments.size()) return Intersection();
+
+    collectCandidates(shape.getBox().expand(1), _segments.size() - skip);
+
+    for (unsigned id : _candidates) {
+      const Segment& segment = _segments.at(id);
+      Intersection intersection = _shapes.isCircle(segment.handle) ?
+        shape.getIntersection(_shapes.getCircle(segment.handle)) :
+        shape.getIntersection(_shapes.getLine(segment.handle));
+
+      if (intersection.hasValue()) return intersection;
+    }
+
+    return Intersection();
+  }
+
+  unsigned TrailIndex::size() const {
+    return _segments.size();
+  }
+
+  // Returns whether the segment with the given id is a circle or a line
+  bool TrailIndex::isCircle(unsigned id) const {
+    return _shapes.isCircle(_segments.at(id).handle);
+  }
+
+  const Line& TrailIndex::getLine(unsigned id) const {
+    return _shapes.getLine(_segments.at(id).handle);
+  }
+
+  const Circle& TrailIndex::getCircle(unsigned id) const {
+    return _shapes.getCircle(_segments.at(id).handle);
+  }
+
+  // Returns the bounding box the segment is indexed with, which is padded by a single unit
+  const Box& TrailIndex::getBox(unsigned id) const {
+    return _segments.at(id).box;
+  }
+
+  void TrailIndex::append(const Line& line) {
+    _dirtyFrom = std::min<unsigned>(_dirtyFrom, _segments.size());
+    _segments.push_back({ _shapes.allocate(line), line.getBox().expand(1) });
+    insertSegment(_segments.size() - 1);
+  }
+
+  void TrailIndex::append(const Circle& circle) {
+    _dirtyFrom = std::min<unsigned>(_dirtyFrom, _segments.size());
+    _segments.push_back({ _shapes.allocate(circle), circle.getBox().expand(1) });
+    insertSegment(_segments.size() - 1);
+  }
+
+  // Replaces the last segment, useful when the most recent shape of the trail keeps
+  // growing. The shape is replaced in place when it's of the same kind
+  void TrailIndex::updateLast(const Line& line) {
+    if (_segments.empty() || _shapes.isCircle(_segments.back().handle)) {
+      pop();
+      append(line);
+      return;
+    }
+
+    unsigned id = _segments.size() - 1;
+    _dirtyFrom = std::min(_dirtyFrom, id);
+    removeSegment(id);
+    _shapes.set(_segments.back().handle, line);
+    _segments.back().box = line.getBox().expand(1);
+    insertSegment(id);
+  }
+
+  void TrailIndex::updateLast(const Circle& circle) {
+    if (_segments.empty() || !_shapes.isCircle(_segments.back().handle)) {
+      pop();
+      append(circle);
+      return;
+    }
+
+    unsigned id = _segments.size() - 1;
+    _dirtyFrom = std::min(_dirtyFrom, id);
+    removeSegment(id);
+    _shapes.set(_segments.back().handle, circle);
+    _segments.back().box = circle.getBox().expand(1);
+    insertSegment(id);
+  }
+
+  // Removes the last segment
+  void TrailIndex::pop() {
+    if (_segments.empty()) return;
+
+    _dirtyFrom = std::min<unsigned>(_dirtyFrom, _segments.size() - 1);
+    removeSegment(_segments.size() - 1);
+    _shapes.release(_segments.back().handle);
+    _segments.pop_back();
+  }
+
+  // Removes all the segments at once. Storage is kept for the next shapes to come,
+  // so a trail which is reused across matches stops allocating memory
+  void TrailIndex::clear() {
+    _shapes.reset();
+    _segments.clear();
+    _dirtyFrom = 0;
+
+    for (auto& cell : _cells) cell.second.clear();
+  }
+
+  ShapePoolStats TrailIndex::getShapeStats() const {
+    return _shapes.getStats();
+  }
+
+  // Segments from this id onwards have changed since changes were last cleared, e.g. by
+  // being appended, updated or popped. Segments only ever change at the end of the
+  // trail, so whoever mirrors the trail only has to go through its last few segments
+  unsigned TrailIndex::getDirtyFrom() const {
+    return std::min<unsigned>(_dirtyFrom, _segments.size());
+  }
+
+  void TrailIndex::clearDirty() {
+    _dirtyFrom = _segments.size();
+  }
+
+  // trail - line intersection method
+  Intersection TrailIndex::getIntersection(const Line& line, unsigned skip) {
+    return getFirstIntersection(line, skip);
+  }
+
+  // trail - circle intersection method
+  Intersection TrailIndex::getIntersection(const Circle& circle, unsigned skip) {
+    return getFirstIntersection(circle, skip);
+  }
+
+  // Casts a fan of rays from a single origin, where each direction is a unit vector,
+  // and records any hit which is nearer than the current hit of its ray. Candidates are
+  // collected once for the whole fan and visited nearest first, so the cast stops as
+  // soon as no ray could be hit any nearer. The last few segments specified by "skip"
+  // are ignored, e.g. the ones connected to a snake's head when casting from it
+  void TrailIndex::castRays(const Point& origin, const Point* directions, unsigned count,
+      RayHit* hits, int owner, unsigned skip) {
+    if (skip >= _segments.size() || count == 0) return;
+
+    Box box = { origin.x, origin.y, origin.x, origin.y };
+    double reach = 0;
+
+    for (unsigned i = 0; i < count; i++) {
+      double x = origin.x + (directions[i].x * hits[i].distance);
+      double y = origin.y + (directions[i].y * hits[i].distance);
+      box = {
+        std::min(box.minX, x), std::min(box.minY, y),
+        std::max(box.maxX, x), std::max(box.maxY, y)
+      };
+      reach = std::max(reach, hits[i].distance);
+    }
+
+    collectCandidates(box, _segments.size() - skip);
+
+    _rayCandidates.clear();
+    for (unsigned id : _candidates) {
+      _rayCandidates.push_back({ getBoxDistance(_segments.at(id).box, origin), id });
+    }
+
+    std::sort(_rayCandidates.begin(), _rayCandidates.end());
+
+    for (const auto& candidate : _rayCandidates) {
+      // All the remaining segments are farther than the farthest ray could still see
+      if (candidate.first >= reach) break;
+
+      const Segment& segment = _segments.at(candidate.second);
+      bool circle = _shapes.isCircle(segment.handle);
+      bool improved = false;
+
+      for (unsigned i = 0; i < count; i++) {
+        RayHit& hit = hits[i];
+
+        if (candidate.first >= hit.distance) continue;
+        if (!reachesBox(origin, directions[i], hit.distance, segment.box)) continue;
+
+        Nullable<double> distance = circle ?
+          _shapes.getCircle(segment.handle).getRayDistance(origin, directions[i]) :
+          _shapes.getLine(segment.handle).getRayDistance(origin, directions[i]);
+
+        if (!distance.hasValue() || distance.getValue() >= hit.distance) continue;
+
+        hit = { distance.getValue(), owner, (int) candidate.second };
+        improved = true;
+      }
+
+      if (!improved) continue;
+
+      reach = 0;
+      for (unsigned i = 0; i < count; i++) reach = std::max(reach, hits[i].distance);
+    }
+  }
+
+  // Records the earliest segment the given sweep hits, in case it's earlier than the
+  // current impact. All the intersection points are timed, rather than just the ones of
+  // the first segment, since segments are ordered by when they were made and not by when
+  // the head would meet them. The last few segments specified by "skip" are ignored,
+  // e.g. the ones connected to the head the sweep starts at
+  void TrailIndex::sweep(const Sweep& sweep, Impact& impact, int owner, unsigned skip) {
+    if (skip >= _segments.size()) return;
+
+    collectCandidates(sweep.getBox().expand(1), _segments.size() - skip);
+
+    for (unsigned id : _candidates) {
+      const Segment& segment = _segments.at(id);
+      bool circle = _shapes.isCircle(segment.handle);
+      Intersection intersection;
+
+      if (sweep.isTurning()) {
+        intersection = circle ?
+          sweep.getCircle().getIntersection(_shapes.getCircle(segment.handle)) :
+          sweep.getCircle().getIntersection(_shapes.getLine(segment.handle));
+      }
+      else {
+        intersection = circle ?
+          sweep.getLine().getIntersection(_shapes.getCircle(segment.handle)) :
+          sweep.getLine().getIntersection(_shapes.getLine(segment.handle));
+      }
+
+      for (const Point& point : intersection) {
+        double time = sweep.getTime(point);
+        if (time < impact.time) impact = { time, owner, (int) id, 0 };
+      }
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "box.h"
+#include "point.h"
+#include "intersection.h"
+#include "line.h"
+#include "circle.h"
+#include "shape_pool.h"
+#include "sweep.h"
+
+namespace geometry {
+  class Line;
+  class Circle;
+
+  // The nearest hit of a single ray so far. Rays only look for shapes which are nearer
+  // than the current distance, so it's initialized with the farthest distance of interest
+  struct RayHit {
+    double distance;
+    // Tags the trail which was hit, e.g. with the index of its snake, or -1 for none
+    int owner;
+    // The id of the segment which was hit within its trail
+    int segment;
+  };
+
+  // A spatial index over a trail of lines and circles, e.g. the shapes of a snake.
+  // Segments are hashed into a uniform grid based on their bounding boxes, so
+  // intersection queries only run against segments which are close to the given shape
+  class TrailIndex {
+  private:
+    struct Segment {
+      ShapeHandle handle;
+      Box box;
+    };
+
+    double _cellSize;
+    ShapePool _shapes;
+    std::vector<Segment> _segments;
+    std::unordered_map<long long, std::vector<unsigned>> _cells;
+    std::vector<unsigned> _candidates;
+    // Candidates of a ray cast along with their distance from the rays' origin
+    std::vector<std::pair<double, unsigned>> _rayCandidates;
+    std::vector<unsigned> _stamps;
+    unsigned _stamp;
+    // The lowest id of a segment which has changed since changes were last cleared
+    unsigned _dirtyFrom;
+
+    long long getCellKey(long long column, long long row) const;
+
+    void insertSegment(unsigned id);
+
+    void removeSegment(unsigned id);
+
+    void collectCandidates(const Box& box, unsigned limit);
+
+    template <typename T>
+    Intersection getFirstIntersection(const T& shape, unsigned skip);
+
+  public:
+    TrailIndex(double cellSize = 64);
+
+    unsigned size() const;
+
+    bool isCircle(unsigned id) const;
+
+    const Line& getLine(unsigned id) const;
+
+    const Circle& getCircle(unsigned id) const;
+
+    const Box& getBox(unsigned id) const;
+
+    void append(const Line& line);
+
+    void append(const Circle& circle);
+
+    void updateLast(const Line& line);
+
+    void updateLast(const Circle& circle);
+
+    void pop();
+
+    void clear();
+
+    ShapePoolStats getShapeStats() const;
+
+    unsigned getDirtyFrom() const;
+
+    void clearDirty();
+
+    Intersection getIntersection(const Line& line, unsigned skip = 0);
+
+    Intersection getIntersection(const Circle& circle, unsigned skip = 0);
+
+    void castRays(const Point& origin, const Point* directions, unsigned count,
+      RayHit* hits, int owner, unsigned skip = 0);
+
+    void sweep(const Sweep& sweep, Impact& impact, int owner, unsigned skip = 0);
+  };
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../utils.h"
+#include "../geometry/box.h"
+#include "../geometry/line.h"
+#include "../geometry/circle.h"
+#include "framebuffer.h"
+
+namespace graphics {
+  // width - The width of the canvas the buffer is put into, in pixels
+  // height - The height of the canvas the buffer is put into, in pixels
+  Framebuffer::Framebuffer(unsigned width, unsigned height):
+    _width(width),
+    _height(height),
+    _pixels(width * height * 4, 0) {
+  }
+
+  void Framebuffer::clear(const Color& color) {
+    for (unsigned i = 0; i < _pixels.size(); i += 4) {
+      _pixels[i] = color.r;
+      _pixels[i + 1] = color.g;
+      _pixels[i + 2] = color.b;
+      _pixels[i + 3] = color.a;
+    }
+  }
+
+  Color Framebuffer::getPixel(unsigned x, unsigned y) const {
+    unsigned i = (y * _width + x) * 4;
+    return { _pixels[i], _pixels[i + 1], _pixels[i + 2], _pixels[i + 3] };
+  }
+
+  // Composites the given color over the pixel at the given position, wrapped into the
+  // buffer, the same way "source-over" does for non premultiplied colors
+  void Framebuffer::blend(long long x, long long y, const Color& color, double coverage) {
+    long long width = _width;
+    long long height = _height;
+    x = ((x % width) + width) % width;
+    y = ((y % height) + height) % height;
+
+    unsigned char* pixel = &_pixels[(y * width + x) * 4];
+    double srcAlpha = coverage * color.a / 255;
+    double dstAlpha = pixel[3] / 255.0 * (1 - srcAlpha);
+    double alpha = srcAlpha + dstAlpha;
+
+    if (alpha <= 0) return;
+
+    pixel[0] = std::lround((color.r * srcAlpha + pixel[0] * dstAlpha) / alpha);
+    pixel[1] = std::lround((color.g * srcAlpha + pixel[1] * dstAlpha) / alpha);
+    pixel[2] = std::lround((color.b * srcAlpha + pixel[2] * dstAlpha) / alpha);
+    pixel[3] = std::lround(alpha * 255);
+  }
+
+  // Strokes the part of the given line which lies between the given distances from its
+  // first point, including "from" but not "to", with butt caps like a canvas does.
+  // Returns the number of pixels which were painted
+  unsigned Framebuffer::strokeLine(const geometry::Line& line, const Color& color,
+      double lineWidth, double from, double to) {
+    double dx = line._x2 - line._x1;
+    double dy = line._y2 - line._y1;
+    double length = std::hypot(dx, dy);
+
+    if (length == 0 || to <= from) return 0;
+
+    double ux = dx / length;
+    double uy = dy / length;
+    double halfWidth = lineWidth / 2;
+    double reach = halfWidth + 1;
+
+    double x1 = line._x1 + ux * from;
+    double y1 = line._y1 + uy * from;
+    double x2 = line._x1 + ux * to;
+    double y2 = line._y1 + uy * to;
+    long long minX = std::floor(std::min(x1, x2) - reach);
+    long long minY = std::floor(std::min(y1, y2) - reach);
+    long long maxX = std::ceil(std::max(x1, x2) + reach);
+    long long maxY = std::ceil(std::max(y1, y2) + reach);
+    unsigned painted = 0;
+
+    for (long long y = minY; y < maxY; y++) {
+      for (long long x = minX; x < maxX; x++) {
+        double px = x + 0.5 - line._x1;
+        double py = y + 0.5 - line._y1;
+        double along = px * ux + py * uy;
+
+        if (along < from || along >= to) continue;
+
+        double distance = std::abs(px * uy - py * ux);
+        double coverage = std::min(halfWidth + 0.5 - distance, 1.0);
+
+        if (coverage <= 0) continue;
+
+        blend(x, y, color, coverage);
+        painted++;
+      }
+    }
+
+    return painted;
+  }
+
+  unsigned Framebuffer::strokeLine(const geometry::Line& line, const Color& color,
+      double lineWidth) {
+    double length = std::hypot(line._x2 - line._x1, line._y2 - line._y1);
+    return strokeLine(line, color, lineWidth, 0, length);
+  }
+
+  // Strokes the part of the given circle which is swept clockwise from "fromRad" up to
+  // "toRad", not including it. Returns the number of pixels which were painted
+  unsigned Framebuffer::strokeArc(const geometry::Circle& circle, const Color& color,
+      double lineWidth, double fromRad, double toRad) {
+    double sweep = toRad - fromRad;
+
+    if (sweep <= 0) return 0;
+
+    double halfWidth = lineWidth / 2;
+    geometry::Box box = geometry::Circle(circle._x, circle._y, circle._r, fromRad, toRad)
+      .getBox().expand(halfWidth + 1);
+    long long minX = std::floor(box.minX);
+    long long minY = std::floor(box.minY);
+    long long maxX = std::ceil(box.maxX);
+    long long maxY = std::ceil(box.maxY);
+    unsigned painted = 0;
+
+    for (long long y = minY; y < maxY; y++) {
+      for (long long x = minX; x < maxX; x++) {
+        double px = x + 0.5 - circle._x;
+        double py = y + 0.5 - circle._y;
+        double distance = std::abs(std::hypot(px, py) - circle._r);
+        double coverage = std::min(halfWidth + 0.5 - distance, 1.0);
+
+        if (coverage <= 0) continue;
+
+        double rad = utils::mod(std::atan2(py, px) - fromRad, 2 * M_PI);
+
+        if (rad >= sweep) continue;
+
+        blend(x, y, color, coverage);
+        painted++;
+      }
+    }
+
+    return painted;
+  }
+
+  unsigned Framebuffer::strokeArc(const geometry::Circle& circle, const Color& color,
+      double lineWidth) {
+    return strokeArc(circle, color, lineWidth,
+      std::min(circle._rad1, circle._rad2), std::max(circle._rad1, circle._rad2));
+  }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include "../geometry/line.h"
+#include "../geometry/circle.h"
+
+namespace graphics {
+  // A non-premultiplied RGBA color, the same layout as the pixels of an ImageData
+  struct Color {
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+    unsigned char a;
+  };
+
+  // An RGBA framebuffer in linear memory, which can be handed over to putImageData as
+  // is. Strokes are anti-aliased by the distance of each pixel's center from the shape,
+  // and pixels beyond an edge wrap around to the other side, the same way snakes do.
+  // A stroke can be limited to a part of its shape, where parts are half open, so a
+  // shape which is drawn piece by piece covers each pixel exactly once, just as if it
+  // was drawn at once
+  class Framebuffer {
+  public:
+    unsigned _width;
+    unsigned _height;
+    std::vector<unsigned char> _pixels;
+
+    Framebuffer(unsigned width, unsigned height);
+
+    void clear(const Color& color);
+
+    Color getPixel(unsigned x, unsigned y) const;
+
+    unsigned strokeLine(const geometry::Line& line, const Color& color, double lineWidth,
+      double from, double to);
+
+    unsigned strokeLine(const geometry::Line& line, const Color& color, double lineWidth);
+
+    unsigned strokeArc(const geometry::Circle& circle, const Color& color, double lineWidth,
+      double fromRad, double toRad);
+
+    unsigned strokeArc(const geometry::Circle& circle, const Color& color, double lineWidth);
+
+  private:
+    void blend(long long x, long long y, const Color& color, double coverage);
+  };
+}
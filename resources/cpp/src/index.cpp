@@ -1,4 +1,13 @@
-#include "nullable.cpp"
-#include "utils.cpp"
-#include "geometry/line.cpp"
-#include "geometry/circle.cpp"
\ No newline at end of file
+#include "core.cpp"
+#include "bindings/utils.cpp"
+#include "bindings/stats.cpp"
+#include "bindings/geometry/points.cpp"
+#include "bindings/geometry/line.cpp"
+#include "bindings/geometry/circle.cpp"
+#include "bindings/geometry/trail_index.cpp"
+#include "bindings/geometry/shape_batch.cpp"
+#include "bindings/geometry/polygon.cpp"
+#include "bindings/game/world.cpp"
+#include "bindings/game/ray_batch.cpp"
+#include "bindings/game/trail_canvas.cpp"
+#include "bindings/game/simulation.cpp"
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+// A thin layer over the vector instructions of the target, so kernels can be written
+// once and run over as many doubles at once as the target allows: WASM SIMD128 under
+// emscripten (-msimd128), AVX or SSE2 on a native build, and a single double otherwise.
+// Comparisons are ordered, meaning they're false whenever a NaN is involved
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#elif defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace simd {
+#if defined(__wasm_simd128__)
+  typedef v128_t Doubles;
+  typedef v128_t Mask;
+
+  const unsigned WIDTH = 2;
+
+  inline Doubles load(const double* values) { return wasm_v128_load(values); }
+  inline Doubles splat(double value) { return wasm_f64x2_splat(value); }
+  inline Doubles add(Doubles a, Doubles b) { return wasm_f64x2_add(a, b); }
+  inline Doubles sub(Doubles a, Doubles b) { return wasm_f64x2_sub(a, b); }
+  inline Doubles mul(Doubles a, Doubles b) { return wasm_f64x2_mul(a, b); }
+  inline Doubles div(Doubles a, Doubles b) { return wasm_f64x2_div(a, b); }
+  inline Doubles min(Doubles a, Doubles b) { return wasm_f64x2_pmin(a, b); }
+  inline Doubles max(Doubles a, Doubles b) { return wasm_f64x2_pmax(a, b); }
+  inline Mask lessThan(Doubles a, Doubles b) { return wasm_f64x2_lt(a, b); }
+  inline Mask greaterThan(Doubles a, Doubles b) { return wasm_f64x2_gt(a, b); }
+  inline Mask both(Mask a, Mask b) { return wasm_v128_and(a, b); }
+  inline Mask either(Mask a, Mask b) { return wasm_v128_or(a, b); }
+  inline unsigned bits(Mask mask) { return wasm_i64x2_bitmask(mask); }
+#elif defined(__AVX__)
+  typedef __m256d Doubles;
+  typedef __m256d Mask;
+
+  const unsigned WIDTH = 4;
+
+  inline Doubles load(const double* values) { return _mm256_loadu_pd(values); }
+  inline Doubles splat(double value) { return _mm256_set1_pd(value); }
+  inline Doubles add(Doubles a, Doubles b) { return _mm256_add_pd(a, b); }
+  inline Doubles sub(Doubles a, Doubles b) { return _mm256_sub_pd(a, b); }
+  inline Doubles mul(Doubles a, Doubles b) { return _mm256_mul_pd(a, b); }
+  inline Doubles div(Doubles a, Doubles b) { return _mm256_div_pd(a, b); }
+  inline Doubles min(Doubles a, Doubles b) { return _mm256_min_pd(a, b); }
+  inline Doubles max(Doubles a, Doubles b) { return _mm256_max_pd(a, b); }
+  inline Mask lessThan(Doubles a, Doubles b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+  inline Mask greaterThan(Doubles a, Doubles b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+  inline Mask both(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+  inline Mask either(Mask a, Mask b) { return _mm256_or_pd(a, b); }
+  inline unsigned bits(Mask mask) { return _mm256_movemask_pd(mask); }
+#elif defined(__SSE2__)
+  typedef __m128d Doubles;
+  typedef __m128d Mask;
+
+  const unsigned WIDTH = 2;
+
+  inline Doubles load(const double* values) { return _mm_loadu_pd(values); }
+  inline Doubles splat(double value) { return _mm_set1_pd(value); }
+  inline Doubles add(Doubles a, Doubles b) { return _mm_add_pd(a, b); }
+  inline Doubles sub(Doubles a, Doubles b) { return _mm_sub_pd(a, b); }
+  inline Doubles mul(Doubles a, Doubles b) { return _mm_mul_pd(a, b); }
+  inline Doubles div(Doubles a, Doubles b) { return _mm_div_pd(a, b); }
+  inline Doubles min(Doubles a, Doubles b) { return _mm_min_pd(a, b); }
+  inline Doubles max(Doubles a, Doubles b) { return _mm_max_pd(a, b); }
+  inline Mask lessThan(Doubles a, Doubles b) { return _mm_cmplt_pd(a, b); }
+  inline Mask greaterThan(Doubles a, Doubles b) { return _mm_cmpgt_pd(a, b); }
+  inline Mask both(Mask a, Mask b) { return _mm_and_pd(a, b); }
+  inline Mask either(Mask a, Mask b) { return _mm_or_pd(a, b); }
+  inline unsigned bits(Mask mask) { return _mm_movemask_pd(mask); }
+#else
+  typedef double Doubles;
+  typedef bool Mask;
+
+  const unsigned WIDTH = 1;
+
+  inline Doubles load(const double* values) { return *values; }
+  inline Doubles splat(double value) { return value; }
+  inline Doubles add(Doubles a, Doubles b) { return a + b; }
+  inline Doubles sub(Doubles a, Doubles b) { return a - b; }
+  inline Doubles mul(Doubles a, Doubles b) { return a * b; }
+  inline Doubles div(Doubles a, Doubles b) { return a / b; }
+  inline Doubles min(Doubles a, Doubles b) { return b < a ? b : a; }
+  inline Doubles max(Doubles a, Doubles b) { return a < b ? b : a; }
+  inline Mask lessThan(Doubles a, Doubles b) { return a < b; }
+  inline Mask greaterThan(Doubles a, Doubles b) { return a > b; }
+  inline Mask both(Mask a, Mask b) { return a && b; }
+  inline Mask either(Mask a, Mask b) { return a || b; }
+  inline unsigned bits(Mask mask) { return mask; }
+#endif
+
+  // The number of doubles buffers should be padded to, so any of the widths above
+  // could load a whole lane from them
+  const unsigned PADDING = 4;
+}
\ No newline at end of file
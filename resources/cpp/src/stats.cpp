@@ -0,0 +1,131 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "stats.h"
+
+namespace stats {
+  namespace {
+    const char* COUNTER_NAMES[COUNTERS_COUNT] = {
+      "lineLineCalls",
+      "lineLineRejects",
+      "lineLineHits",
+      "circleLineCalls",
+      "circleLineRejects",
+      "circleLineHits",
+      "circleCircleCalls",
+      "circleCircleRejects",
+      "circleCircleHits",
+      "matchingRadCalls",
+      "occupancyRejects",
+      "allocations"
+    };
+
+    const char* TIMER_NAMES[TIMERS_COUNT] = {
+      "World::step",
+      "World broad phase",
+      "World narrow phase",
+      "World::castRays"
+    };
+
+    // A complete event of the Chrome trace format, times are in microseconds
+    struct TraceEvent {
+      Timer timer;
+      double start;
+      double duration;
+    };
+
+    struct State {
+      Snapshot snapshot;
+      bool tracing;
+      double traceStart;
+      std::vector<TraceEvent> events;
+    };
+
+    thread_local State state = {};
+
+    double getNow() {
+      return std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now().time_since_epoch()
+      ).count();
+    }
+  }
+
+  Scope::Scope(Timer timer): _timer(timer), _start(getNow()) {
+  }
+
+  Scope::~Scope() {
+    double duration = getNow() - _start;
+    unsigned index = (unsigned) _timer;
+
+    state.snapshot.timerCalls[index]++;
+    state.snapshot.timerTotals[index] += duration;
+
+    // Events beyond the trace's capacity are dropped, so tracing never allocates memory
+    if (state.tracing && state.events.size() < state.events.capacity()) {
+      state.events.push_back({ _timer, _start - state.traceStart, duration });
+    }
+  }
+
+  // Whether the core was built with CORE_STATS, otherwise all the counters remain 0
+  bool isEnabled() {
+#ifdef CORE_STATS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  const char* getCounterName(Counter counter) {
+    return COUNTER_NAMES[(unsigned) counter];
+  }
+
+  const char* getTimerName(Timer timer) {
+    return TIMER_NAMES[(unsigned) timer];
+  }
+
+  void count(Counter counter) {
+    state.snapshot.counters[(unsigned) counter]++;
+  }
+
+  Snapshot getSnapshot() {
+    return state.snapshot;
+  }
+
+  void reset() {
+    state.snapshot = Snapshot();
+  }
+
+  // Starts recording an event for each timed scope, up to the given number of events.
+  // Any previous trace is discarded
+  void startTrace(unsigned capacity) {
+    state.events.clear();
+    state.events.reserve(capacity);
+    state.traceStart = getNow();
+    state.tracing = true;
+  }
+
+  void stopTrace() {
+    state.tracing = false;
+  }
+
+  // Returns the recorded events in the Chrome trace event format, which can be loaded
+  // by chrome://tracing or by Perfetto
+  std::string getTraceJson() {
+    std::string json = "{\"traceEvents\":[";
+    char buffer[160];
+
+    for (unsigned i = 0; i < state.events.size(); i++) {
+      const TraceEvent& event = state.events[i];
+      std::snprintf(buffer, sizeof(buffer),
+        "%s{\"name\":\"%s\",\"cat\":\"core\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}",
+        i ? "," : "", getTimerName(event.timer), event.start, event.duration
+      );
+      json += buffer;
+    }
+
+    json += "],\"displayTimeUnit\":\"ms\"}";
+
+    return json;
+  }
+}
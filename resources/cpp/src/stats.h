@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+
+// Hot path counters and scoped timers of the core. Counting is compiled out entirely
+// unless the core is built with CORE_STATS defined, e.g. "cmake -DCORE_STATS=ON" or
+// "npm run build:cpp:stats", in which case the STATS_ macros below expand to plain
+// increments. Counters are kept per thread, so matches which run in parallel don't
+// contend over them, and each thread sees its own
+namespace stats {
+  enum class Counter {
+    LINE_LINE_CALLS,
+    LINE_LINE_REJECTS,
+    LINE_LINE_HITS,
+    CIRCLE_LINE_CALLS,
+    CIRCLE_LINE_REJECTS,
+    CIRCLE_LINE_HITS,
+    CIRCLE_CIRCLE_CALLS,
+    CIRCLE_CIRCLE_REJECTS,
+    CIRCLE_CIRCLE_HITS,
+    MATCHING_RAD_CALLS,
+    // Broad phase pairs the world step has ruled out by its occupancy grid alone
+    OCCUPANCY_REJECTS,
+    // Only counted by tools which replace the global allocation operators, e.g. the
+    // bindings, the specs and the benchmarks
+    ALLOCATIONS,
+    COUNT
+  };
+
+  enum class Timer {
+    WORLD_STEP,
+    BROAD_PHASE,
+    NARROW_PHASE,
+    RAY_CAST,
+    COUNT
+  };
+
+  const unsigned COUNTERS_COUNT = (unsigned) Counter::COUNT;
+  const unsigned TIMERS_COUNT = (unsigned) Timer::COUNT;
+
+  // The counters and timers of the current thread since they were last reset
+  struct Snapshot {
+    unsigned long long counters[COUNTERS_COUNT];
+    unsigned long long timerCalls[TIMERS_COUNT];
+    // The total time spent within each timer, in microseconds
+    double timerTotals[TIMERS_COUNT];
+  };
+
+  // Times the enclosing scope, and records it as a trace event while tracing
+  class Scope {
+  public:
+    Scope(Timer timer);
+
+    ~Scope();
+
+  private:
+    Timer _timer;
+    double _start;
+  };
+
+  bool isEnabled();
+
+  const char* getCounterName(Counter counter);
+
+  const char* getTimerName(Timer timer);
+
+  void count(Counter counter);
+
+  Snapshot getSnapshot();
+
+  void reset();
+
+  void startTrace(unsigned capacity);
+
+  void stopTrace();
+
+  std::string getTraceJson();
+}
+
+#ifdef CORE_STATS
+#define STATS_CONCAT_(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT_(a, b)
+#define STATS_COUNT(counter) stats::count(stats::Counter::counter)
+#define STATS_SCOPE(timer) stats::Scope STATS_CONCAT(statsScope, __LINE__)(stats::Timer::timer)
+#else
+#define STATS_COUNT(counter) ((void) 0)
+#define STATS_SCOPE(timer) ((void) 0)
+#endif
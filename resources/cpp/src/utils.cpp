@@ -1,63 +1,50 @@
 #include <cfloat>
 #include <cmath>
 #include <string>
-#include <emscripten/bind.h>
 #include "utils.h"
 
 namespace utils {
   template<typename T>
-  Chain<T>::Chain(T accumulator): _accumulator(accumulator) {
+  constexpr Chain<T>::Chain(T accumulator): _accumulator(accumulator) {
   }
 
-  template<>
-  Chain<double>* Chain<double>::mod(double num) {
-    double result = utils::mod(_accumulator, num);
-    Chain<double>* chain = new Chain<double>(result);
-    delete this;
-    return chain;
+  template<typename T>
+  Chain<double> Chain<T>::mod(double num) const {
+    return Chain<double>(utils::mod(_accumulator, num));
   }
 
-  template<>
-  Chain<double>* Chain<double>::trim(int decimals, const std::string mode) {
-    double result = utils::trim(_accumulator, decimals, mode);
-    Chain<double>* chain = new Chain<double>(result);
-    delete this;
-    return chain;
+  template<typename T>
+  template<Round R>
+  Chain<double> Chain<T>::trim(int decimals) const {
+    return Chain<double>(utils::trim<R>(_accumulator, decimals));
   }
 
-  template<>
-  Chain<bool>* Chain<double>::isBetween(double num1, double num2, const std::string precision) {
-    bool result = utils::isBetween(_accumulator, num1, num2, precision);
-    Chain<bool>* chain = new Chain<bool>(result);
-    delete this;
-    return chain;
+  template<typename T>
+  template<Round R, int Decimals>
+  Chain<double> Chain<T>::trim() const {
+    return Chain<double>(utils::trim<R, Decimals>(_accumulator));
   }
 
-  template<>
-  Chain<bool>* Chain<double>::compare(double num, const std::string precision) {
-    bool result = utils::compare(_accumulator, num, precision);
-    Chain<bool>* chain = new Chain<bool>(result);
-    delete this;
-    return chain;
+  template<typename T>
+  template<Precision P>
+  Chain<bool> Chain<T>::isBetween(double num1, double num2) const {
+    return Chain<bool>(utils::isBetween<P>(_accumulator, num1, num2));
   }
 
-  template<>
-  Chain<bool>* Chain<double>::compare(double num, const std::string method, const std::string precision) {
-    bool result = utils::compare(_accumulator, num, method, precision);
-    Chain<bool>* chain = new Chain<bool>(result);
-    delete this;
-    return chain;
+  template<typename T>
+  template<Precision P, Op O>
+  Chain<bool> Chain<T>::compare(double num) const {
+    return Chain<bool>(utils::compare<P, O>(_accumulator, num));
   }
 
   template<typename T>
-  T Chain<T>::result() {
-    delete this;
+  constexpr T Chain<T>::result() const {
     return _accumulator;
   }
 
   template<typename T>
-  Chain<T>* chain(T accumulator) {
-    return new Chain<T>(accumulator);
+  constexpr Chain<T> chain(T accumulator) {
+    return Chain<T>(accumulator);
   }
 
   // Fixed modulo method which can calculate modulo of negative numbers properly
@@ -66,25 +53,93 @@ namespace utils {
     return std::fmod((std::fmod(context, num) + num), num);
   }
 
+  // Returns 10 to the power of the given exponent. Can be evaluated at compile time,
+  // and unlike std::pow it's exact for all the exponents we use. Negative exponents
+  // divide by the positive power, so they're rounded only once
+  constexpr double pow10(int exponent) {
+    if (exponent < 0) return 1 / pow10(-exponent);
+
+    double result = 1;
+    for (int i = 0; i < exponent; i++) result *= 10;
+    return result;
+  }
+
   // Trims number and leaves the number of decimals specified.
-  // The "mode" argument specifies which math function should be invoked
+  // The "R" parameter specifies which math function should be invoked
   // right after the number has been trimmed.
-  // e.g. 12.12345.trim(3, "ceil") returns 12.124
-  double trim(double context, int decimals, const std::string mode) {
-    double accumulator = context * std::pow(10, decimals);
+  // e.g. trim<Round::CEIL>(12.12345, 3) returns 12.124
+  // Negative decimals trim whole digits, e.g. trim<Round::ROUND>(1234, -2) returns 1200
+  template<Round R>
+  double trim(double context, int decimals) {
+    double factor = pow10(decimals);
+    double accumulator = context * factor;
+
+    switch (R) {
+      case Round::CEIL: accumulator = std::ceil(accumulator); break;
+      case Round::FLOOR: accumulator = std::floor(accumulator); break;
+      default: accumulator = std::round(accumulator);
+    }
+
+    return accumulator / factor;
+  }
+
+  // Same as above, only the number of decimals is known at compile time
+  template<Round R, int Decimals>
+  double trim(double context) {
+    constexpr double factor = pow10(Decimals);
+    double accumulator = context * factor;
+
+    switch (R) {
+      case Round::CEIL: accumulator = std::ceil(accumulator); break;
+      case Round::FLOOR: accumulator = std::floor(accumulator); break;
+      default: accumulator = std::round(accumulator);
+    }
 
-    if (mode.compare("ceil") == 0)
-      accumulator = std::ceil(accumulator);
-    else if (mode.compare("floor") == 0)
-      accumulator = std::floor(accumulator);
-    else
-      accumulator = std::round(accumulator);
+    return accumulator / factor;
+  }
 
-    return accumulator / std::pow(10, decimals);
+  // Initiates comparison operator between context number and a given number, only here
+  // a precision can be specified. Both the precision and the operator are resolved at
+  // compile time
+  template<Precision P, Op O>
+  bool compare(double context, double num) {
+    switch (P) {
+      case Precision::F:
+        if (O == Op::LT || O == Op::LE) return context <= num + DBL_EPSILON;
+        if (O == Op::GT || O == Op::GE) return context >= num - DBL_EPSILON;
+        return std::abs(context - num) <= DBL_EPSILON;
+
+      case Precision::PX:
+        if (O == Op::LT || O == Op::LE) return std::round(context) <= std::round(num);
+        if (O == Op::GT || O == Op::GE) return std::round(context) >= std::round(num);
+        return std::round(context) == std::round(num);
+
+      default:
+        if (O == Op::LT) return context < num;
+        if (O == Op::LE) return context <= num;
+        if (O == Op::GT) return context > num;
+        if (O == Op::GE) return context >= num;
+        return context == num;
+    }
   }
 
   // Tells if number is in specified range based on given precision.
   // See the "compare" method for more information about precision
+  template<Precision P>
+  bool isBetween(double context, double num1, double num2) {
+    return compare<P, Op::GE>(context, std::min(num1, num2)) &&
+           compare<P, Op::LE>(context, std::max(num1, num2));
+  }
+
+  // The following string based methods are thin wrappers around the methods above,
+  // exported for JavaScript which can't specify template parameters
+
+  double trim(double context, int decimals, const std::string mode) {
+    if (mode.compare("ceil") == 0) return trim<Round::CEIL>(context, decimals);
+    if (mode.compare("floor") == 0) return trim<Round::FLOOR>(context, decimals);
+    return trim<Round::ROUND>(context, decimals);
+  }
+
   bool isBetween(double context, double num1, double num2, const std::string precision) {
     return compare(context, std::min(num1, num2), ">=", precision) &&
            compare(context, std::max(num1, num2), "<=", precision);
@@ -94,47 +149,18 @@ namespace utils {
     return compare(context, num, "==", precision);
   }
 
-  // Initiates comparison operator between context number and a given number, only here
-  // a precision can be specified
+  template<Precision P>
+  static bool compareByMethod(double context, double num, const std::string& method) {
+    if (method.compare("<") == 0) return compare<P, Op::LT>(context, num);
+    if (method.compare("<=") == 0) return compare<P, Op::LE>(context, num);
+    if (method.compare(">") == 0) return compare<P, Op::GT>(context, num);
+    if (method.compare(">=") == 0) return compare<P, Op::GE>(context, num);
+    return compare<P, Op::EQ>(context, num);
+  }
+
   bool compare(double context, double num, const std::string method, const std::string precision) {
-    // Fixed precision, "almost equal" with a deviation of ε
-    if (precision.compare("f") == 0) {
-      if (method.compare("<") == 0 ||
-          method.compare("<=") == 0)
-        return context <= num + DBL_EPSILON;
-      if (method.compare(">") == 0 ||
-          method.compare(">=") == 0)
-        return context >= num - DBL_EPSILON;
-      return std::abs(context - num) <= DBL_EPSILON;
-    }
-    // Pixel precision, round comparison
-    else if (precision.compare("px") == 0) {
-      if (method.compare("<") == 0 ||
-          method.compare("<=") == 0)
-        return std::round(context) <= std::round(num);
-      if (method.compare(">") == 0 ||
-          method.compare(">=") == 0)
-        return std::round(context) >= std::round(num);
-      return std::round(context) == std::round(num);
-    }
-    // Exact precision
-    else {
-      if (method.compare("<") == 0) return context < num;
-      if (method.compare("<=") == 0) return context <= num;
-      if (method.compare(">") == 0) return context > num;
-      if (method.compare(">=") == 0) return context >= num;
-      return context == num;
-    }
+    if (precision.compare("f") == 0) return compareByMethod<Precision::F>(context, num, method);
+    if (precision.compare("px") == 0) return compareByMethod<Precision::PX>(context, num, method);
+    return compareByMethod<Precision::EXACT>(context, num, method);
   }
-}
-
-EMSCRIPTEN_BINDINGS(utils_module) {
-  emscripten::function("utils_mod", &utils::mod);
-  emscripten::function("utils_trim", &utils::trim);
-  emscripten::function("utils_isBetween", &utils::isBetween);
-  emscripten::function("utils_compare",
-    emscripten::select_overload<bool(double, double, const std::string, const std::string)>(
-      &utils::compare
-    )
-  );
 }
\ No newline at end of file
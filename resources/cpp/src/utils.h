@@ -3,29 +3,76 @@
 #include <string>
 
 namespace utils {
+  // Comparison precisions, see the "compare" method for more information
+  enum class Precision {
+    EXACT,
+    // Fixed precision, "almost equal" with a deviation of ε
+    F,
+    // Pixel precision, round comparison
+    PX
+  };
+
+  // Comparison operators
+  enum class Op {
+    EQ,
+    LT,
+    LE,
+    GT,
+    GE
+  };
+
+  // The math function which should be invoked once a number has been trimmed
+  enum class Round {
+    ROUND,
+    CEIL,
+    FLOOR
+  };
+
+  // A fluent pipeline over the utility methods, e.g.
+  // chain(rad).trim<Round::ROUND, 9>().isBetween<Precision::EXACT>(min, max).result().
+  // Chains are plain values, each method returns a new chain rather than allocating
+  // one, so a chained expression compiles down to the equivalent nested calls
   template<typename T>
   class Chain {
   private:
     T _accumulator;
 
   public:
-    Chain(T accumulator);
+    constexpr Chain(T accumulator);
 
-    Chain<double>* mod(double num);
+    Chain<double> mod(double num) const;
 
-    Chain<double>* trim(int decimals, const std::string mode = "round");
+    template<Round R = Round::ROUND>
+    Chain<double> trim(int decimals) const;
 
-    Chain<bool>* isBetween(double num1, double num2, const std::string precision = "exact");
+    template<Round R, int Decimals>
+    Chain<double> trim() const;
 
-    Chain<bool>* compare(double num, const std::string precision = "exact");
+    template<Precision P = Precision::EXACT>
+    Chain<bool> isBetween(double num1, double num2) const;
 
-    Chain<bool>* compare(double num, const std::string method, const std::string precision);
+    template<Precision P = Precision::EXACT, Op O = Op::EQ>
+    Chain<bool> compare(double num) const;
 
-    T result();
+    constexpr T result() const;
   };
 
   template<typename T>
-  Chain<T>* chain(T accumulator);
+  constexpr Chain<T> chain(T accumulator);
+
+  constexpr double pow10(int exponent);
+
+  template<Round R>
+  double trim(double context, int decimals);
+
+  template<Round R, int Decimals>
+  double trim(double context);
+
+  template<Precision P, Op O>
+  bool compare(double context, double num);
+
+  template<Precision P>
+  bool isBetween(double context, double num1, double num2);
 
   double mod(double context, double num);
 
@@ -1,18 +1,8 @@
-Engine.Geometry.Polygon = class Polygon {
+Engine.Geometry.Polygon = class Polygon extends Utils.proxy(CPP.Geometry.Polygon) {
   // bounds - an array of arrays. Each sub-array represents the arguments vector which
   // will be invoked by the line's construction method
   constructor(...bounds) {
-    this.bounds = bounds.map(coords => new Engine.Geometry.Line(...coords));
-  }
-
-  delete() {
-    this.bounds.forEach(bound => bound.delete());
-  }
-
-  // Returns if polygon has given point
-  hasPoint(x, y) {
-    // Run check for each bound
-    return this.bounds.some(bound => bound.hasPoint(x, y));
+    super(bounds);
   }
 
   getIntersection(shape) {
@@ -24,39 +14,14 @@ Engine.Geometry.Polygon = class Polygon {
       return this.getPolygonIntersection(shape);
   }
 
-  // polygon - line intersection method
-  getLineIntersection(line) {
-    // line - line intersection for each bound
-    let result = this.bounds.reduce((result, bound) => {
-      let intersection = line.getLineIntersection(bound);
-      if (intersection) result = result.concat(intersection);
-      return result;
-    }, []);
-
-    if (result.length) return result;
-  }
-
-  // polygon - circle intersection method
-  getCircleIntersection(circle) {
-    // line - circle intersection for each bound
-    let result = this.bounds.reduce((result, bound) => {
-      let intersection = circle.getLineIntersection(bound);
-      if (intersection) result = result.concat(intersection);
-      return result;
-    }, []);
-
-    if (result.length) return result;
-  }
-
-  // polygon - polygon intersection method
-  getPolygonIntersection(polygon) {
-    // line - polygon intersection for each bound
-    let result = this.bounds.reduce((result, bound) => {
-      let intersection = polygon.getLineIntersection(bound);
-      if (intersection) result = result.concat(intersection);
-      return result;
-    }, []);
-
-    if (result.length) return result;
+  // Returns if the given shape intersects with any of the edges, without gathering
+  // the intersection points
+  intersects(shape) {
+    if (shape instanceof Engine.Geometry.Line)
+      return this.intersectsLine(shape);
+    if (shape instanceof Engine.Geometry.Circle)
+      return this.intersectsCircle(shape);
+    if (shape instanceof Engine.Geometry.Polygon)
+      return this.intersectsPolygon(shape);
   }
-};
\ No newline at end of file
+};
@@ -0,0 +1,60 @@
+Engine.Geometry.ShapeBatch = class ShapeBatch extends Utils.proxy(CPP.Geometry.ShapeBatch) {
+  // Shape descriptor types
+  static get LINE() {
+    return 0;
+  }
+
+  static get CIRCLE() {
+    return 1;
+  }
+
+  // Writes the given shape into the descriptor at the given index. When filling large
+  // batches it's preferable to write directly into the shapes view instead
+  setShape(index, shape) {
+    ShapeBatch.writeDescriptor(this.getShapesView(), index * ShapeBatch.SHAPE_STRIDE, shape);
+  }
+
+  // Writes the given shape into the query descriptor
+  setQuery(shape) {
+    ShapeBatch.writeDescriptor(this.getQueryView(), 0, shape);
+  }
+
+  intersectQuery(count) {
+    return this.checkPointsCount(super.intersectQuery(count));
+  }
+
+  intersectPairs(count) {
+    return this.checkPointsCount(super.intersectPairs(count));
+  }
+
+  // Intersections past the capacity of the points view are counted but never written,
+  // so the records of a count which exceeds it would be silently cut
+  checkPointsCount(count) {
+    if (count > this.getPointsCapacity()) {
+      throw RangeError(`ShapeBatch: ${count} intersections exceed the points capacity`);
+    }
+
+    return count;
+  }
+
+  // Writes the given shape into a view at the given offset, in the layout of a shape
+  // descriptor. SHAPE_STRIDE is bound from the native side, so offsets follow its layout
+  static writeDescriptor(view, offset, shape) {
+    if (shape instanceof Engine.Geometry.Line) {
+      view[offset] = ShapeBatch.LINE;
+      view[offset + 1] = shape.x1;
+      view[offset + 2] = shape.y1;
+      view[offset + 3] = shape.x2;
+      view[offset + 4] = shape.y2;
+      view[offset + 5] = 0;
+    }
+    else {
+      view[offset] = ShapeBatch.CIRCLE;
+      view[offset + 1] = shape.x;
+      view[offset + 2] = shape.y;
+      view[offset + 3] = shape.r;
+      view[offset + 4] = shape.rad1;
+      view[offset + 5] = shape.rad2;
+    }
+  }
+};
\ No newline at end of file
@@ -0,0 +1,26 @@
+Engine.Geometry.TrailIndex = class TrailIndex extends Utils.proxy(CPP.Geometry.TrailIndex) {
+  // Adds a shape to the end of the trail
+  append(shape) {
+    if (shape instanceof Engine.Geometry.Line)
+      return this.appendLine(shape);
+    if (shape instanceof Engine.Geometry.Circle)
+      return this.appendCircle(shape);
+  }
+
+  // Replaces the last shape of the trail, e.g. once it has grown
+  updateLast(shape) {
+    if (shape instanceof Engine.Geometry.Line)
+      return this.updateLastLine(shape);
+    if (shape instanceof Engine.Geometry.Circle)
+      return this.updateLastCircle(shape);
+  }
+
+  // Returns the intersection points with the first shape in the trail which intersects
+  // with the given shape. The last shapes of the trail can be ignored using "skip"
+  getIntersection(shape, skip = 0) {
+    if (shape instanceof Engine.Geometry.Line)
+      return this.getLineIntersection(shape, skip);
+    if (shape instanceof Engine.Geometry.Circle)
+      return this.getCircleIntersection(shape, skip);
+  }
+};
\ No newline at end of file
@@ -0,0 +1,26 @@
+Game.Entities.World = class World extends Utils.proxy(CPP.Game.World) {
+  // Returns an empty world for a new match. A single world is kept for the whole
+  // session and reset for each match, so matches reuse the same native memory rather
+  // than allocating it all over again
+  static acquire(width, height) {
+    let world = this.instance;
+
+    if (world && (world.width != width || world.height != height)) {
+      world.delete();
+      world = null;
+    }
+
+    this.instance = world = world || new this(width, height);
+    world.reset();
+
+    return world;
+  }
+
+  // Advances all the given snakes at once based on their pressed keys, and returns
+  // the status of the steps made. Steps are made in fixed ticks regardless of the
+  // frame rate, so a match only depends on the input of each tick
+  update(span, snakes) {
+    let inputBits = snakes.reduce((inputBits, snake) => inputBits | snake.getInputBits(), 0);
+    return this.advance(span, inputBits);
+  }
+};
\ No newline at end of file
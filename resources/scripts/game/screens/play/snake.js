@@ -2,9 +2,13 @@ Game.Screens.Play.Snake = class Snake extends Engine.Layer {
   constructor(screen, snakes = []) {
     super(screen);
 
+    // The world simulates all the snakes of the match
+    this.world = Game.Entities.World.acquire(this.width, this.height);
+
     // Red snake
     this.snakes = [
       new Game.Entities.Snake(
+        this.world,
         this.width / 4,
         this.height / 4,
         50,
@@ -23,6 +27,7 @@ Game.Screens.Play.Snake = class Snake extends Engine.Layer {
 
       // Blue snake
       new Game.Entities.Snake(
+        this.world,
         (this.width / 4) * 3,
         (this.height / 4) * 3,
         50,
@@ -43,10 +48,6 @@ Game.Screens.Play.Snake = class Snake extends Engine.Layer {
     screen.appendLayer(Game.Screens.Play.Score, this.snakes);
   }
 
-  unload() {
-    this.snakes.forEach(snake => snake.delete());
-  }
-
   draw(context) {
     // Draw each snake in the snakes array
     this.snakes.forEach(snake => snake.draw(context));
@@ -58,18 +59,11 @@ Game.Screens.Play.Snake = class Snake extends Engine.Layer {
     // Storing original snakes array for future use, since it might get changed
     let snakes = this.snakes.slice();
 
-    snakes.forEach((snake, index) => {
-      snake.update(span, this.width, this.height);
-      // Disqualify if intersected with self
-      if (snake.getSelfIntersection()) return this.snakes.splice(index, 1);
+    // Movement and intersections are all handled by the world in a single step
+    let status = this.world.update(span, snakes);
 
-      snakes.forEach((opponent) => {
-        // Don't scan for intersection with self, obviously this will always be true
-        if (opponent === snake) return;
-        // Disqualify if intersected with opponent
-        if (snake.getSnakeIntersection(opponent)) this.snakes.splice(index, 1);
-      });
-    });
+    // Disqualify snakes which intersected with themselves or with an opponent
+    this.snakes = snakes.filter(snake => status.alive & (1 << snake.index));
 
     // There can be only one winner, or a tie (very rare, most likely not to happen)
     // If the match is already finished, skip the next steps since they are not relevant
@@ -109,4 +109,36 @@ describe("Engine.Geometry.Polygon class", function() {
       });
     });
   });
-});
\ No newline at end of file
+
+  describe("getPolygonIntersection method", function() {
+    describe("given overlapping polygon", function() {
+      it("returns intersection points", function() {
+        let polygon = new Engine.Geometry.Polygon([3, 2, 8, 2]);
+
+        expect(this.polygon.getPolygonIntersection(polygon)).toEqual([
+          { x: 5, y: 2 }
+        ]);
+
+        polygon.delete();
+      });
+    });
+  });
+
+  describe("intersects method", function() {
+    describe("given intersecting line", function() {
+      it("returns true", function() {
+        let line = new Engine.Geometry.Line(0, 1, 5, 4);
+        expect(this.polygon.intersects(line)).toBeTruthy();
+        line.delete();
+      });
+    });
+
+    describe("given inner circle", function() {
+      it("returns false", function() {
+        let circle = new Engine.Geometry.Circle(2.5, 2.5, 2, 0, 2 * Math.PI);
+        expect(this.polygon.intersects(circle)).toBeFalsy();
+        circle.delete();
+      });
+    });
+  });
+});
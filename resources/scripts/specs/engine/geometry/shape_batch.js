@@ -0,0 +1,68 @@
+describe("Engine.Geometry.ShapeBatch class", function() {
+  beforeEach(function() {
+    this.shapeBatch = new Engine.Geometry.ShapeBatch(3, 8);
+    this.shapes = [
+      new Engine.Geometry.Line(-5, -5, 5, 5),
+      new Engine.Geometry.Line(1, -5, 1, 5),
+      new Engine.Geometry.Circle(1, 1, 5, 0, 1.5 * Math.PI)
+    ];
+
+    this.shapes.forEach((shape, index) => this.shapeBatch.setShape(index, shape));
+  });
+
+  afterEach(function () {
+    this.shapeBatch.delete();
+    this.shapes.forEach(shape => shape.delete());
+  });
+
+  describe("intersectQuery method", function() {
+    describe("given intersecting query", function() {
+      it("writes intersection records", function() {
+        let line = new Engine.Geometry.Line(-10, 1, 10, 1);
+        this.shapeBatch.setQuery(line);
+
+        expect(this.shapeBatch.intersectQuery(3)).toEqual(4);
+        expect(Array.from(this.shapeBatch.getPointsView().subarray(0, 16))).toEqual([
+          0, -1, 1, 1,
+          1, -1, 1, 1,
+          2, -1, 6, 1,
+          2, -1, -4, 1
+        ]);
+
+        line.delete();
+      });
+    });
+
+    describe("given more intersections than the points capacity", function() {
+      it("throws rather than cutting the records", function() {
+        let shapeBatch = new Engine.Geometry.ShapeBatch(3, 2);
+        let line = new Engine.Geometry.Line(-10, 1, 10, 1);
+        this.shapes.forEach((shape, index) => shapeBatch.setShape(index, shape));
+        shapeBatch.setQuery(line);
+
+        expect(() => shapeBatch.intersectQuery(3)).toThrowError(RangeError);
+
+        shapeBatch.delete();
+        line.delete();
+      });
+    });
+
+    describe("given outranged query", function() {
+      it("writes nothing", function() {
+        let line = new Engine.Geometry.Line(-10, 10, 10, 10);
+        this.shapeBatch.setQuery(line);
+        expect(this.shapeBatch.intersectQuery(3)).toEqual(0);
+        line.delete();
+      });
+    });
+  });
+
+  describe("intersectPairs method", function() {
+    it("writes intersection records for each intersecting pair", function() {
+      expect(this.shapeBatch.intersectPairs(2)).toEqual(1);
+      expect(Array.from(this.shapeBatch.getPointsView().subarray(0, 4))).toEqual([
+        0, 1, 1, 1
+      ]);
+    });
+  });
+});
\ No newline at end of file
@@ -0,0 +1,78 @@
+describe("Engine.Geometry.TrailIndex class", function() {
+  beforeEach(function() {
+    this.trailIndex = new Engine.Geometry.TrailIndex();
+    this.shapes = [
+      new Engine.Geometry.Line(0, 10, 100, 10),
+      new Engine.Geometry.Circle(100, 50, 40, -0.5 * Math.PI, 0.5 * Math.PI),
+      new Engine.Geometry.Line(100, 90, 0, 90)
+    ];
+
+    this.shapes.forEach(shape => this.trailIndex.append(shape));
+  });
+
+  afterEach(function () {
+    this.trailIndex.delete();
+    this.shapes.forEach(shape => shape.delete());
+  });
+
+  describe("size method", function() {
+    it("returns the number of appended shapes", function() {
+      expect(this.trailIndex.size()).toEqual(3);
+    });
+  });
+
+  describe("getIntersection method", function() {
+    describe("given intersecting line", function() {
+      it("returns intersection points with the first intersected shape", function() {
+        let line = new Engine.Geometry.Line(50, -50, 50, 150);
+
+        expect(this.trailIndex.getIntersection(line)).toEqual([
+          { x: 50, y: 10 }
+        ]);
+
+        line.delete();
+      });
+    });
+
+    describe("given intersecting circle", function() {
+      it("returns intersection points with the first intersected shape", function() {
+        let circle = new Engine.Geometry.Circle(150, 50, 10, 0, 2 * Math.PI);
+
+        expect(this.trailIndex.getIntersection(circle)).toEqual([
+          { x: 140, y: 50 }
+        ]);
+
+        circle.delete();
+      });
+    });
+
+    describe("given line which intersects with skipped shapes only", function() {
+      it("returns nothing", function() {
+        let line = new Engine.Geometry.Line(50, 50, 50, 150);
+        expect(this.trailIndex.getIntersection(line, 2)).toBeUndefined();
+        line.delete();
+      });
+    });
+
+    describe("given outranged line", function() {
+      it("returns nothing", function() {
+        let line = new Engine.Geometry.Line(500, 500, 600, 600);
+        expect(this.trailIndex.getIntersection(line)).toBeUndefined();
+        line.delete();
+      });
+    });
+  });
+
+  describe("updateLast method", function() {
+    it("replaces the last shape", function() {
+      let line = new Engine.Geometry.Line(100, 90, 60, 90);
+      let query = new Engine.Geometry.Line(50, 50, 50, 150);
+
+      this.trailIndex.updateLast(line);
+      expect(this.trailIndex.getIntersection(query)).toBeUndefined();
+
+      line.delete();
+      query.delete();
+    });
+  });
+});
\ No newline at end of file